@@ -149,6 +149,44 @@ extern DECLSPEC SDL_bool SDLCALL SDL_HasAVX2(void);
  */
 extern DECLSPEC int SDLCALL SDL_GetSystemRAM(void);
 
+/**
+ *  \brief Report the alignment this system needs for SIMD allocations.
+ *
+ *  This is the larger of the CPU cache line size and the widest vector
+ *  register the CPU supports (16 bytes for SSE/AltiVec, 32 for AVX), so
+ *  memory aligned to it never straddles a cache line at a vector load.
+ *
+ *  \return The alignment in bytes, always a power of two.
+ *
+ *  \sa SDL_SIMDAlloc
+ *  \sa SDL_SIMDFree
+ */
+extern DECLSPEC size_t SDLCALL SDL_SIMDGetAlignment(void);
+
+/**
+ *  \brief Allocate memory aligned to SDL_SIMDGetAlignment().
+ *
+ *  The allocation is also padded out to a multiple of the alignment, so
+ *  vector code may safely touch the tail of the buffer.  Memory returned
+ *  by this function must be released with SDL_SIMDFree(), never SDL_free().
+ *
+ *  \param len The length of the block in bytes.
+ *  \return A pointer to the aligned block, or NULL if out of memory.
+ *
+ *  \sa SDL_SIMDGetAlignment
+ *  \sa SDL_SIMDFree
+ */
+extern DECLSPEC void * SDLCALL SDL_SIMDAlloc(const size_t len);
+
+/**
+ *  \brief Deallocate memory obtained from SDL_SIMDAlloc().
+ *
+ *  It is safe to pass NULL to this function.
+ *
+ *  \sa SDL_SIMDAlloc
+ */
+extern DECLSPEC void SDLCALL SDL_SIMDFree(void *ptr);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -38,6 +38,7 @@
 #include "SDL_quit.h"
 #include "SDL_gesture.h"
 #include "SDL_touch.h"
+#include "SDL_rwops.h"
 
 #include "begin_code.h"
 /* Set up for C function definitions, even when using C++ */
@@ -194,6 +195,7 @@ typedef struct SDL_KeyboardEvent
     Uint8 padding2;
     Uint8 padding3;
     SDL_Keysym keysym;  /**< The key that was pressed or released */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_KeyboardEvent;
 
 #define SDL_TEXTEDITINGEVENT_TEXT_SIZE (32)
@@ -237,6 +239,7 @@ typedef struct SDL_MouseMotionEvent
     Sint32 y;           /**< Y coordinate, relative to window */
     Sint32 xrel;        /**< The relative motion in the X direction */
     Sint32 yrel;        /**< The relative motion in the Y direction */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_MouseMotionEvent;
 
 /**
@@ -254,6 +257,7 @@ typedef struct SDL_MouseButtonEvent
     Uint8 padding1;
     Sint32 x;           /**< X coordinate, relative to window */
     Sint32 y;           /**< Y coordinate, relative to window */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_MouseButtonEvent;
 
 /**
@@ -268,6 +272,7 @@ typedef struct SDL_MouseWheelEvent
     Sint32 x;           /**< The amount scrolled horizontally, positive to the right and negative to the left */
     Sint32 y;           /**< The amount scrolled vertically, positive away from the user and negative toward the user */
     Uint32 direction;   /**< Set to one of the SDL_MOUSEWHEEL_* defines. When FLIPPED the values in X and Y will be opposite. Multiply by -1 to change them back */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_MouseWheelEvent;
 
 /**
@@ -284,6 +289,7 @@ typedef struct SDL_JoyAxisEvent
     Uint8 padding3;
     Sint16 value;       /**< The axis value (range: -32768 to 32767) */
     Uint16 padding4;
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_JoyAxisEvent;
 
 /**
@@ -300,6 +306,7 @@ typedef struct SDL_JoyBallEvent
     Uint8 padding3;
     Sint16 xrel;        /**< The relative motion in the X direction */
     Sint16 yrel;        /**< The relative motion in the Y direction */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_JoyBallEvent;
 
 /**
@@ -320,6 +327,7 @@ typedef struct SDL_JoyHatEvent
                          */
     Uint8 padding1;
     Uint8 padding2;
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_JoyHatEvent;
 
 /**
@@ -334,6 +342,7 @@ typedef struct SDL_JoyButtonEvent
     Uint8 state;        /**< ::SDL_PRESSED or ::SDL_RELEASED */
     Uint8 padding1;
     Uint8 padding2;
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_JoyButtonEvent;
 
 /**
@@ -361,6 +370,7 @@ typedef struct SDL_ControllerAxisEvent
     Uint8 padding3;
     Sint16 value;       /**< The axis value (range: -32768 to 32767) */
     Uint16 padding4;
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_ControllerAxisEvent;
 
 
@@ -376,6 +386,7 @@ typedef struct SDL_ControllerButtonEvent
     Uint8 state;        /**< ::SDL_PRESSED or ::SDL_RELEASED */
     Uint8 padding1;
     Uint8 padding2;
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_ControllerButtonEvent;
 
 
@@ -418,6 +429,7 @@ typedef struct SDL_TouchFingerEvent
     float dx;           /**< Normalized in the range -1...1 */
     float dy;           /**< Normalized in the range -1...1 */
     float pressure;     /**< Normalized in the range 0...1 */
+    Uint64 timestamp_ns; /**< When the input happened, in nanoseconds, see SDL_GetTicksNS() */
 } SDL_TouchFingerEvent;
 
 
@@ -597,6 +609,25 @@ typedef enum
 extern DECLSPEC int SDLCALL SDL_PeepEvents(SDL_Event * events, int numevents,
                                            SDL_eventaction action,
                                            Uint32 minType, Uint32 maxType);
+
+/**
+ *  Returns events of any of the listed types in a single pass over the queue.
+ *
+ *  This works like SDL_PeepEvents(), except that instead of a range, the
+ *  events to return are picked by an array of \c numtypes event types.
+ *  Use it to pick several unrelated kinds of events, for instance keyboard,
+ *  text input and quit events, without going over the queue once for each.
+ *
+ *  \c action must be ::SDL_PEEKEVENT or ::SDL_GETEVENT.  If \c events is
+ *  NULL, this returns 1 if any such events are queued, and 0 otherwise.
+ *
+ *  \return The number of events actually stored, or -1 if there was an error.
+ *
+ *  This function is thread-safe.
+ */
+extern DECLSPEC int SDLCALL SDL_PeepEventTypes(SDL_Event * events, int numevents,
+                                               SDL_eventaction action,
+                                               const Uint32 * types, int numtypes);
 /* @} */
 
 /**
@@ -699,7 +730,24 @@ extern DECLSPEC void SDLCALL SDL_AddEventWatch(SDL_EventFilter filter,
                                                void *userdata);
 
 /**
- *  Remove an event watch function added with SDL_AddEventWatch()
+ *  Add a function which is called when an event of one of the \c numtypes
+ *  types in \c types is added to the queue.  Watchers are called in the
+ *  order they were added, whichever function added them.  The types must
+ *  be no greater than ::SDL_LASTEVENT.
+ *
+ *  \return 0 on success, or -1 if the watch couldn't be added.
+ *
+ *  \sa SDL_AddEventWatch()
+ *  \sa SDL_DelEventWatch()
+ */
+extern DECLSPEC int SDLCALL SDL_AddEventWatchTypes(SDL_EventFilter filter,
+                                                   void *userdata,
+                                                   const Uint32 * types,
+                                                   int numtypes);
+
+/**
+ *  Remove an event watch function added with SDL_AddEventWatch() or
+ *  SDL_AddEventWatchTypes()
  */
 extern DECLSPEC void SDLCALL SDL_DelEventWatch(SDL_EventFilter filter,
                                                void *userdata);
@@ -739,6 +787,176 @@ extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint32 type, int state);
  */
 extern DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
 
+/**
+ *  Get the number of events that have been merged into an event already
+ *  in the queue, instead of being queued separately.
+ *
+ *  \sa SDL_HINT_EVENT_COALESCE_MOUSE_MOTION
+ *  \sa SDL_HINT_EVENT_COALESCE_WINDOW_RESIZE
+ *  \sa SDL_HINT_EVENT_COALESCE_FINGER_MOTION
+ */
+extern DECLSPEC int SDLCALL SDL_GetCoalescedEventCount(void);
+
+/**
+ *  Start writing every event added to the queue, with its timestamps, to
+ *  \c dst in a compact binary format.  SDL_SYSWMEVENT events are skipped,
+ *  and the \c data1 and \c data2 pointers of user events are not kept.
+ *
+ *  If \c freedst is non-zero, \c dst is closed when recording stops.
+ *
+ *  \return 0 on success, or -1 if the recording couldn't be started.
+ *
+ *  \sa SDL_StopEventRecording()
+ *  \sa SDL_StartEventReplay()
+ */
+extern DECLSPEC int SDLCALL SDL_StartEventRecording(SDL_RWops * dst,
+                                                    int freedst);
+
+/**
+ *  Stop the event recording started by SDL_StartEventRecording().
+ */
+extern DECLSPEC void SDLCALL SDL_StopEventRecording(void);
+
+/**
+ *  How recorded events are fed back into the queue.
+ */
+typedef enum
+{
+    SDL_REPLAY_REALTIME,    /**< Events arrive as far apart as they were recorded */
+    SDL_REPLAY_BENCHMARK    /**< Each SDL_PumpEvents() call adds what one call added
+                                 while recording, without waiting */
+} SDL_EventReplayMode;
+
+/**
+ *  Start adding the events recorded by SDL_StartEventRecording() in \c src
+ *  to the queue.  Events are added from SDL_PumpEvents(), straight into the
+ *  queue: the event filter and watchers already saw them while recording.
+ *  The replay stops by itself at the end of the recording.
+ *
+ *  If \c freesrc is non-zero, \c src is closed when the replay stops.
+ *
+ *  \return 0 on success, or -1 if \c src is not a recording made on a
+ *          compatible platform.
+ *
+ *  \sa SDL_StopEventReplay()
+ */
+extern DECLSPEC int SDLCALL SDL_StartEventReplay(SDL_RWops * src,
+                                                 int freesrc,
+                                                 SDL_EventReplayMode mode);
+
+/**
+ *  Return SDL_TRUE while a replay started by SDL_StartEventReplay() has
+ *  events left to add.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_IsEventReplayActive(void);
+
+/**
+ *  Stop the replay started by SDL_StartEventReplay().
+ */
+extern DECLSPEC void SDLCALL SDL_StopEventReplay(void);
+
+/**
+ *  Number of buckets in SDL_EventQueueStats::depth_histogram
+ */
+#define SDL_EVENT_QUEUE_DEPTH_BUCKETS   16
+
+/**
+ *  Event queue statistics, see SDL_GetEventQueueStats()
+ */
+typedef struct SDL_EventQueueStats
+{
+    Uint64 pushed;              /**< Events added to the queue */
+    Uint64 popped;              /**< Events taken out of the queue, flushed or filtered away */
+    Uint32 coalesced;           /**< Events merged into an event already in the queue */
+    Uint32 dropped;             /**< Events lost because the queue was full */
+    int depth;                  /**< Events in the queue now */
+    int max_depth;              /**< Most events that have been in the queue at once */
+    Uint32 depth_histogram[SDL_EVENT_QUEUE_DEPTH_BUCKETS]; /**< How deep each push left the queue:
+                                     1 event in bucket 0, 2-3 in bucket 1, 4-7 in bucket 2, and so on */
+    Uint64 average_residency_ns; /**< How long popped events had been in the queue, on average */
+    Uint64 max_residency_ns;    /**< The longest any popped event had been in the queue */
+    Uint64 filtered;            /**< Events passed to the event filter and watchers */
+    Uint64 filter_ns;           /**< Time spent in the event filter and watchers */
+} SDL_EventQueueStats;
+
+/**
+ *  Get statistics about the event queue since it was initialized, or since
+ *  the last call to SDL_ResetEventQueueStats().
+ *
+ *  The statistics are always kept, at the cost of reading the clock when an
+ *  event is pushed or popped, and around calls to the event filter and
+ *  watchers.
+ *
+ *  \sa SDL_GetEventTypeStats()
+ */
+extern DECLSPEC void SDLCALL SDL_GetEventQueueStats(SDL_EventQueueStats * stats);
+
+/**
+ *  Get the number of events of a type that have been added to and removed
+ *  from the event queue, as counted by SDL_GetEventQueueStats().
+ *
+ *  \return 0 on success, or -1 if \c type is past ::SDL_LASTEVENT.
+ */
+extern DECLSPEC int SDLCALL SDL_GetEventTypeStats(Uint32 type,
+                                                  Uint64 * pushed,
+                                                  Uint64 * popped);
+
+/**
+ *  Start counting the event queue statistics again, including the count
+ *  returned by SDL_GetCoalescedEventCount().
+ */
+extern DECLSPEC void SDLCALL SDL_ResetEventQueueStats(void);
+
+/**
+ *  Most fingers kept in an SDL_InputSnapshot
+ */
+#define SDL_INPUT_SNAPSHOT_MAX_FINGERS  32
+
+/**
+ *  A finger touching a touch device, see SDL_InputSnapshot
+ */
+typedef struct SDL_InputSnapshotFinger
+{
+    SDL_TouchID touchId;        /**< The touch device */
+    SDL_FingerID fingerId;
+    float x;                    /**< Normalized in the range 0...1 */
+    float y;                    /**< Normalized in the range 0...1 */
+    float pressure;             /**< Normalized in the range 0...1 */
+} SDL_InputSnapshotFinger;
+
+/**
+ *  The keyboard, mouse and touch state at one moment, see SDL_GetInputSnapshot()
+ */
+typedef struct SDL_InputSnapshot
+{
+    Uint32 sequence;            /**< Goes up each time the state changes */
+    Uint64 timestamp_ns;        /**< When the state was taken, see SDL_GetTicksNS() */
+    Uint32 keyboard_focus;      /**< The window with keyboard focus, or 0 */
+    Uint16 modstate;            /**< As returned by SDL_GetModState() */
+    Uint8 keystate[SDL_NUM_SCANCODES]; /**< As returned by SDL_GetKeyboardState() */
+    Uint32 mouse_focus;         /**< The window with mouse focus, or 0 */
+    int mouse_x;                /**< As returned by SDL_GetMouseState() */
+    int mouse_y;
+    Uint32 mouse_buttons;
+    int num_fingers;            /**< Fingers down on all touch devices, up to
+                                     ::SDL_INPUT_SNAPSHOT_MAX_FINGERS */
+    SDL_InputSnapshotFinger fingers[SDL_INPUT_SNAPSHOT_MAX_FINGERS];
+} SDL_InputSnapshot;
+
+/**
+ *  Copy the keyboard, mouse and touch state, as it was at the end of the
+ *  last call to SDL_PumpEvents(), into \c snapshot.
+ *
+ *  Unlike calling SDL_GetKeyboardState(), SDL_GetMouseState() and
+ *  SDL_GetTouchFinger() in turn, all of the state is from the same moment.
+ *  This function may be called from any thread, and never waits for the
+ *  thread pumping events.
+ *
+ *  \return The snapshot's sequence number, which only changes when the
+ *          state does, or 0 if events have not been pumped yet.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetInputSnapshot(SDL_InputSnapshot * snapshot);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
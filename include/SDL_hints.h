@@ -141,6 +141,34 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling whether the 2D renderer batches its drawing.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every rendering call goes straight to the graphics API
+ *    "1"       - Copies and fills are queued and merged into as few draw calls as possible
+ *
+ *  By default batching is enabled, unless SDL_HINT_RENDER_DRIVER is set or the
+ *  renderer was made with SDL_CreateSoftwareRenderer(), since such applications
+ *  may be mixing their own drawing with the renderer's.  Use SDL_RenderFlush()
+ *  to submit queued drawing when doing so.  The software renderer always
+ *  batches when SDL_HINT_RENDER_SW_THREADS is in effect and this hint is unset.
+ *  The hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_BATCHING            "SDL_RENDER_BATCHING"
+
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with.
+ *
+ *  The value is the number of threads, including the one calling the rendering
+ *  functions.  Batched copies and fills are then drawn in horizontal bands of
+ *  the target, one band per thread at a time.
+ *
+ *  By default the software renderer draws on a single thread.
+ *  The hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_SW_THREADS          "SDL_RENDER_SW_THREADS"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -199,6 +227,71 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_NET_WM_PING      "SDL_VIDEO_X11_NET_WM_PING"
 
+/**
+ *  \brief  A variable controlling how many MIT-SHM buffers the X11 window framebuffer uses.
+ *
+ *  This variable can be set to the following values:
+ *    "1"       - Draw directly into a single shared memory image and wait for
+ *                the X server after every update (the default)
+ *    "2"       - Double buffer, presenting asynchronously
+ *    "3"       - Triple buffer, presenting asynchronously
+ *
+ *  With more than one buffer, SDL_UpdateWindowSurface() copies the updated
+ *  area into a shared memory image that the X server is not reading from and
+ *  returns without a round trip, using ShmCompletion events to learn when an
+ *  image can be reused.  It only blocks if every image is still in flight.
+ *  The hint is checked in SDL_GetWindowSurface().
+ */
+#define SDL_HINT_VIDEO_X11_SHM_BUFFERS      "SDL_VIDEO_X11_SHM_BUFFERS"
+
+/**
+ *  \brief  A variable listing the display modes reported by the dummy video driver.
+ *
+ *  The value is a comma separated list of modes like "1920x1080@60,1280x720",
+ *  the first of which is used as the desktop mode.  By default the dummy
+ *  driver reports a single 1024x768 desktop.
+ *  The hint is checked when the video subsystem is initialized.
+ */
+#define SDL_HINT_VIDEO_DUMMY_DISPLAY_MODES  "SDL_VIDEO_DUMMY_DISPLAY_MODES"
+
+/**
+ *  \brief  A variable controlling whether the dummy video driver saves every framebuffer update.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't save frames (the default)
+ *    "bmp"     - Save each frame as SDL_window<id>-<frame>.bmp
+ *    "raw"     - Save each frame's pixels as SDL_window<id>-<w>x<h>-<frame>.raw,
+ *                tightly packed in SDL_PIXELFORMAT_RGB888
+ *
+ *  Any other non-zero value saves BMP files.
+ *  The hint is checked in SDL_UpdateWindowSurface().
+ */
+#define SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES    "SDL_VIDEO_DUMMY_SAVE_FRAMES"
+
+/**
+ *  \brief  A variable controlling whether the dummy video driver saves frames on a background thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Write each frame before SDL_UpdateWindowSurface() returns (the default)
+ *    "1"       - Copy each frame and write it from a background thread
+ *
+ *  Updates only block when the thread falls several frames behind.  All
+ *  queued frames are written before the video subsystem shuts down.
+ */
+#define SDL_HINT_VIDEO_DUMMY_SAVE_THREAD    "SDL_VIDEO_DUMMY_SAVE_THREAD"
+
+/**
+ *  \brief  A variable controlling whether the dummy video driver logs framebuffer update timing.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't log timing (the default)
+ *    "1"       - Log the number of updates, their average, minimum and maximum
+ *                duration and the update rate when a window surface is destroyed
+ *
+ *  The statistics are written with SDL_Log().
+ */
+#define SDL_HINT_VIDEO_DUMMY_STATS          "SDL_VIDEO_DUMMY_STATS"
+
 /**
  *  \brief  A variable controlling whether the window frame and title bar are interactive when the cursor is hidden 
  *
@@ -630,6 +723,77 @@ extern "C" {
  */
 #define SDL_HINT_WINDOWS_NO_CLOSE_ON_ALT_F4	"SDL_WINDOWS_NO_CLOSE_ON_ALT_F4"
 
+/**
+ *  \brief A variable controlling how many bytes of idle pixel data the surface pool may keep.
+ *
+ *  Surfaces created with ::SDL_POOLED are parked in a pool when freed and
+ *  handed out again by the next request for the same size and format.
+ *  Once the pool grows past this many bytes, the least recently freed
+ *  surfaces are released.  The default is 16 megabytes.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Pooling is disabled, pooled surfaces are freed immediately
+ *    any other number - The maximum number of bytes of pixels to keep
+ */
+#define SDL_HINT_SURFACE_POOL_SIZE "SDL_SURFACE_POOL_SIZE"
+
+/**
+ *  \brief A variable controlling whether changes to window surfaces are tracked.
+ *
+ *  When enabled, blits and fills that target a window surface record the
+ *  area they touch, and SDL_UpdateWindowSurface() sends only those areas,
+ *  merged into a small set of rectangles, to the video driver.  Pixels
+ *  written directly through surface->pixels are not seen by the tracker,
+ *  so applications doing that should use SDL_UpdateWindowSurfaceRects().
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - SDL_UpdateWindowSurface() updates the whole window (default)
+ *    "1"       - SDL_UpdateWindowSurface() updates only the tracked changes
+ *
+ *  The variable is checked when the window surface is created.
+ */
+#define SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING "SDL_FRAMEBUFFER_DIRTY_TRACKING"
+
+/**
+ *  \brief A variable controlling whether mouse motion events are coalesced in the event queue.
+ *
+ *  When enabled, a mouse motion event for the same window and mouse as the
+ *  event at the end of the queue is merged into it: the position and button
+ *  state are replaced and the relative motion is added up.  Event filters
+ *  and watchers still see every event.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every mouse motion event is queued (default)
+ *    "1"       - Consecutive mouse motion events are merged
+ */
+#define SDL_HINT_EVENT_COALESCE_MOUSE_MOTION "SDL_EVENT_COALESCE_MOUSE_MOTION"
+
+/**
+ *  \brief A variable controlling whether window resize events are coalesced in the event queue.
+ *
+ *  When enabled, an ::SDL_WINDOWEVENT_RESIZED or ::SDL_WINDOWEVENT_SIZE_CHANGED
+ *  event for the same window as the event at the end of the queue is merged
+ *  into it, keeping the latest size.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every resize event is queued (default)
+ *    "1"       - Consecutive resize events are merged
+ */
+#define SDL_HINT_EVENT_COALESCE_WINDOW_RESIZE "SDL_EVENT_COALESCE_WINDOW_RESIZE"
+
+/**
+ *  \brief A variable controlling whether finger motion events are coalesced in the event queue.
+ *
+ *  When enabled, a finger motion event for the same touch device and finger
+ *  as the event at the end of the queue is merged into it: the position and
+ *  pressure are replaced and the deltas are added up.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every finger motion event is queued (default)
+ *    "1"       - Consecutive finger motion events are merged
+ */
+#define SDL_HINT_EVENT_COALESCE_FINGER_MOTION "SDL_EVENT_COALESCE_FINGER_MOTION"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
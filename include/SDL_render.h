@@ -115,6 +115,16 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  \brief A vertex of a triangle drawn with SDL_RenderGeometry()
+ */
+typedef struct SDL_Vertex
+{
+    SDL_FPoint position;        /**< Vertex position, in SDL_Renderer coordinates */
+    SDL_Color  color;           /**< Vertex color */
+    SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
+} SDL_Vertex;
+
 /**
  *  \brief A structure representing rendering state
  */
@@ -127,6 +137,22 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief A pending read of pixels from a renderer
+ *
+ *  \sa SDL_RenderReadPixelsAsync()
+ */
+struct SDL_RenderReadback;
+typedef struct SDL_RenderReadback SDL_RenderReadback;
+
+/**
+ *  \brief A set of textures that share a few large textures
+ *
+ *  \sa SDL_CreateTextureAtlas()
+ */
+struct SDL_TextureAtlas;
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
 
 /* Function prototypes */
 
@@ -257,6 +283,76 @@ extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTexture(SDL_Renderer * renderer,
  */
 extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface);
 
+/**
+ *  \brief Create a texture atlas for a rendering context.
+ *
+ *  The textures of an atlas are packed into a few large textures, called
+ *  pages, so that copies from different textures of the same page can be
+ *  drawn together.  This is meant for many small images such as sprites or
+ *  glyphs.  Textures can be added to and destroyed in an atlas at any time;
+ *  pages are added as needed.
+ *
+ *  \param renderer The renderer.
+ *  \param format The format of the pages, or 0 for a format with alpha.
+ *  \param page_w The width of the pages in pixels, or 0 for the default.
+ *  \param page_h The height of the pages in pixels, or 0 for the default.
+ *
+ *  \return The created atlas is returned, or NULL on error.
+ *
+ *  \sa SDL_CreateAtlasTexture()
+ *  \sa SDL_CreateAtlasTextureFromSurface()
+ *  \sa SDL_DestroyTextureAtlas()
+ */
+extern DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer * renderer,
+                                                                  Uint32 format,
+                                                                  int page_w,
+                                                                  int page_h);
+
+/**
+ *  \brief Create a texture in an atlas.
+ *
+ *  The texture has the format of the atlas and ::SDL_TEXTUREACCESS_STATIC
+ *  access, its contents are transparent until set with SDL_UpdateTexture().
+ *  It can be drawn with SDL_RenderCopy(), SDL_RenderCopyEx() and
+ *  SDL_RenderGeometry() like any other texture, but it can't be locked,
+ *  rendered to or bound with SDL_GL_BindTexture().  Destroying it with
+ *  SDL_DestroyTexture() gives its space back to the atlas.
+ *
+ *  \param atlas The atlas.
+ *  \param w     The width of the texture in pixels.
+ *  \param h     The height of the texture in pixels.
+ *
+ *  \return The created texture is returned, or NULL if it is larger than the
+ *          pages of the atlas or on error.
+ *
+ *  \sa SDL_DestroyTexture()
+ */
+extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateAtlasTexture(SDL_TextureAtlas * atlas,
+                                                             int w, int h);
+
+/**
+ *  \brief Create a texture in an atlas from an existing surface.
+ *
+ *  \param atlas   The atlas.
+ *  \param surface The surface containing pixel data used to fill the texture.
+ *
+ *  \return The created texture is returned, or NULL on error.
+ *
+ *  \note The surface is not modified or freed by this function.
+ *
+ *  \sa SDL_CreateAtlasTexture()
+ *  \sa SDL_DestroyTexture()
+ */
+extern DECLSPEC SDL_Texture * SDLCALL SDL_CreateAtlasTextureFromSurface(SDL_TextureAtlas * atlas,
+                                                                        SDL_Surface * surface);
+
+/**
+ *  \brief Destroy a texture atlas and all the textures in it.
+ *
+ *  Atlases are also destroyed along with their renderer.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas);
+
 /**
  *  \brief Query the attributes of a texture
  *
@@ -676,6 +772,19 @@ extern DECLSPEC int SDLCALL SDL_RenderClear(SDL_Renderer * renderer);
 extern DECLSPEC int SDLCALL SDL_RenderDrawPoint(SDL_Renderer * renderer,
                                                 int x, int y);
 
+/**
+ *  \brief Draw a point on the current rendering target, with sub-pixel
+ *          precision.
+ *
+ *  \param renderer The renderer which should draw a point.
+ *  \param x The x coordinate of the point.
+ *  \param y The y coordinate of the point.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawPointF(SDL_Renderer * renderer,
+                                                 float x, float y);
+
 /**
  *  \brief Draw multiple points on the current rendering target.
  *
@@ -689,6 +798,20 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawPoints(SDL_Renderer * renderer,
                                                  const SDL_Point * points,
                                                  int count);
 
+/**
+ *  \brief Draw multiple points on the current rendering target, with
+ *          sub-pixel precision.
+ *
+ *  \param renderer The renderer which should draw multiple points.
+ *  \param points The points to draw
+ *  \param count The number of points to draw
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawPointsF(SDL_Renderer * renderer,
+                                                  const SDL_FPoint * points,
+                                                  int count);
+
 /**
  *  \brief Draw a line on the current rendering target.
  *
@@ -703,6 +826,21 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawPoints(SDL_Renderer * renderer,
 extern DECLSPEC int SDLCALL SDL_RenderDrawLine(SDL_Renderer * renderer,
                                                int x1, int y1, int x2, int y2);
 
+/**
+ *  \brief Draw a line on the current rendering target, with sub-pixel
+ *          precision.
+ *
+ *  \param renderer The renderer which should draw a line.
+ *  \param x1 The x coordinate of the start point.
+ *  \param y1 The y coordinate of the start point.
+ *  \param x2 The x coordinate of the end point.
+ *  \param y2 The y coordinate of the end point.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawLineF(SDL_Renderer * renderer,
+                                                float x1, float y1, float x2, float y2);
+
 /**
  *  \brief Draw a series of connected lines on the current rendering target.
  *
@@ -716,6 +854,20 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawLines(SDL_Renderer * renderer,
                                                 const SDL_Point * points,
                                                 int count);
 
+/**
+ *  \brief Draw a series of connected lines on the current rendering target,
+ *          with sub-pixel precision.
+ *
+ *  \param renderer The renderer which should draw multiple lines.
+ *  \param points The points along the lines
+ *  \param count The number of points, drawing count-1 lines
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawLinesF(SDL_Renderer * renderer,
+                                                 const SDL_FPoint * points,
+                                                 int count);
+
 /**
  *  \brief Draw a rectangle on the current rendering target.
  *
@@ -727,6 +879,18 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawLines(SDL_Renderer * renderer,
 extern DECLSPEC int SDLCALL SDL_RenderDrawRect(SDL_Renderer * renderer,
                                                const SDL_Rect * rect);
 
+/**
+ *  \brief Draw a rectangle on the current rendering target, with sub-pixel
+ *          precision.
+ *
+ *  \param renderer The renderer which should draw a rectangle.
+ *  \param rect A pointer to the destination rectangle, or NULL to outline the entire rendering target.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawRectF(SDL_Renderer * renderer,
+                                                const SDL_FRect * rect);
+
 /**
  *  \brief Draw some number of rectangles on the current rendering target.
  *
@@ -740,6 +904,20 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawRects(SDL_Renderer * renderer,
                                                 const SDL_Rect * rects,
                                                 int count);
 
+/**
+ *  \brief Draw some number of rectangles on the current rendering target,
+ *          with sub-pixel precision.
+ *
+ *  \param renderer The renderer which should draw multiple rectangles.
+ *  \param rects A pointer to an array of destination rectangles.
+ *  \param count The number of rectangles.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderDrawRectsF(SDL_Renderer * renderer,
+                                                 const SDL_FRect * rects,
+                                                 int count);
+
 /**
  *  \brief Fill a rectangle on the current rendering target with the drawing color.
  *
@@ -752,6 +930,19 @@ extern DECLSPEC int SDLCALL SDL_RenderDrawRects(SDL_Renderer * renderer,
 extern DECLSPEC int SDLCALL SDL_RenderFillRect(SDL_Renderer * renderer,
                                                const SDL_Rect * rect);
 
+/**
+ *  \brief Fill a rectangle on the current rendering target with the drawing
+ *          color, with sub-pixel precision.
+ *
+ *  \param renderer The renderer which should fill a rectangle.
+ *  \param rect A pointer to the destination rectangle, or NULL for the entire
+ *              rendering target.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFillRectF(SDL_Renderer * renderer,
+                                                const SDL_FRect * rect);
+
 /**
  *  \brief Fill some number of rectangles on the current rendering target with the drawing color.
  *
@@ -765,6 +956,20 @@ extern DECLSPEC int SDLCALL SDL_RenderFillRects(SDL_Renderer * renderer,
                                                 const SDL_Rect * rects,
                                                 int count);
 
+/**
+ *  \brief Fill some number of rectangles on the current rendering target with
+ *          the drawing color, with sub-pixel precision.
+ *
+ *  \param renderer The renderer which should fill multiple rectangles.
+ *  \param rects A pointer to an array of destination rectangles.
+ *  \param count The number of rectangles.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFillRectsF(SDL_Renderer * renderer,
+                                                 const SDL_FRect * rects,
+                                                 int count);
+
 /**
  *  \brief Copy a portion of the texture to the current rendering target.
  *
@@ -782,6 +987,24 @@ extern DECLSPEC int SDLCALL SDL_RenderCopy(SDL_Renderer * renderer,
                                            const SDL_Rect * srcrect,
                                            const SDL_Rect * dstrect);
 
+/**
+ *  \brief Copy a portion of the texture to the current rendering target,
+ *          with sub-pixel precision for the destination.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture The source texture.
+ *  \param srcrect   A pointer to the source rectangle, or NULL for the entire
+ *                   texture.
+ *  \param dstrect   A pointer to the destination rectangle, or NULL for the
+ *                   entire rendering target.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyF(SDL_Renderer * renderer,
+                                            SDL_Texture * texture,
+                                            const SDL_Rect * srcrect,
+                                            const SDL_FRect * dstrect);
+
 /**
  *  \brief Copy a portion of the source texture to the current rendering target, rotating it by angle around the given center
  *
@@ -805,6 +1028,55 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
                                            const SDL_Point *center,
                                            const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy a portion of the source texture to the current rendering target, rotating it by angle around the given center, with sub-pixel precision for the destination
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture The source texture.
+ *  \param srcrect   A pointer to the source rectangle, or NULL for the entire
+ *                   texture.
+ *  \param dstrect   A pointer to the destination rectangle, or NULL for the
+ *                   entire rendering target.
+ *  \param angle    An angle in degrees that indicates the rotation that will be applied to dstrect
+ *  \param center   A pointer to a point indicating the point around which dstrect will be rotated (if NULL, rotation will be done around dstrect.w/2, dstrect.h/2).
+ *  \param flip     An SDL_RendererFlip value stating which flipping actions should be performed on the texture
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
+                                            SDL_Texture * texture,
+                                            const SDL_Rect * srcrect,
+                                            const SDL_FRect * dstrect,
+                                            const double angle,
+                                            const SDL_FPoint *center,
+                                            const SDL_RendererFlip flip);
+
+/**
+ *  \brief Render a list of triangles, optionally using a texture and indices
+ *          into the vertex array.
+ *
+ *  The vertex colors are interpolated across each triangle and multiplied
+ *  with the texture color, which is itself modulated by the texture color
+ *  and alpha mod.  Textured triangles use the blend mode of the texture,
+ *  untextured triangles use the draw blend mode of the renderer.
+ *
+ *  \param renderer     The renderer which should draw the triangles.
+ *  \param texture      The texture to sample, or NULL for solid triangles.
+ *  \param vertices     The vertices.
+ *  \param num_vertices The number of vertices.
+ *  \param indices      An array of vertex indices, three per triangle, or
+ *                      NULL to draw the vertices in order.
+ *  \param num_indices  The number of indices.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer * renderer,
+                                               SDL_Texture * texture,
+                                               const SDL_Vertex * vertices,
+                                               int num_vertices,
+                                               const int *indices,
+                                               int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -825,11 +1097,84 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
                                                  Uint32 format,
                                                  void *pixels, int pitch);
 
+/**
+ *  \brief Start reading pixels from the rendering target without waiting
+ *         for the GPU.
+ *
+ *  The pixels are captured from the current rendering target when the frame
+ *  is next presented with SDL_RenderPresent(), or when the result is asked
+ *  for with SDL_GetRenderReadbackPixels(), whichever comes first.  Renderers
+ *  that can copy asynchronously hand the copy to the GPU at that point and
+ *  only wait for it once the result is needed; the others copy the pixels
+ *  right away, as SDL_RenderReadPixels() would.
+ *
+ *  \param renderer The renderer from which pixels should be read.
+ *  \param rect   A pointer to the rectangle to read, or NULL for the entire
+ *                render target.
+ *  \param format The desired format of the pixel data, or 0 to use the format
+ *                of the rendering target
+ *
+ *  \return The readback, to be freed with SDL_FreeRenderReadback(), or NULL
+ *          on error.
+ *
+ *  \sa SDL_RenderReadbackComplete()
+ *  \sa SDL_GetRenderReadbackPixels()
+ */
+extern DECLSPEC SDL_RenderReadback * SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer * renderer,
+                                                                      const SDL_Rect * rect,
+                                                                      Uint32 format);
+
+/**
+ *  \brief Check whether a readback has finished, without blocking.
+ *
+ *  \return SDL_TRUE if SDL_GetRenderReadbackPixels() will not wait.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_RenderReadbackComplete(SDL_RenderReadback * readback);
+
+/**
+ *  \brief Get the pixels read by a readback, waiting for them if necessary.
+ *
+ *  \param readback The readback to get the result of.
+ *  \param pixels   This is filled in with a pointer to the pixel data, which
+ *                  is a rectangle the size of the one requested, clipped to
+ *                  the viewport, and stays valid until the readback is freed.
+ *  \param pitch    This is filled in with the pitch of the pixel data.
+ *
+ *  \return 0 on success, or -1 if the pixels could not be read.
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderReadbackPixels(SDL_RenderReadback * readback,
+                                                        const void **pixels, int *pitch);
+
+/**
+ *  \brief Free a readback, whether or not it has completed.
+ *
+ *  Outstanding readbacks are freed along with their renderer.
+ */
+extern DECLSPEC void SDLCALL SDL_FreeRenderReadback(SDL_RenderReadback * readback);
+
 /**
  *  \brief Update the screen with rendering performed.
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief Submit any copies and fills the renderer has queued up.
+ *
+ *  When batching is enabled (see ::SDL_HINT_RENDER_BATCHING) the renderer
+ *  records SDL_RenderCopy() and SDL_RenderFillRect() calls and hands them to
+ *  the graphics API in as few draw calls as possible.  This happens
+ *  automatically when presenting, changing the render target, viewport or
+ *  clip rectangle, reading pixels or updating a texture.  An application
+ *  that makes its own graphics API calls in between rendering calls, or
+ *  reads the surface of a software renderer directly, needs to call this
+ *  first.
+ *
+ *  \param renderer The renderer to flush.
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
+
 /**
  *  \brief Destroy the specified texture.
  *
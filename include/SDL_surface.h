@@ -53,6 +53,9 @@ extern "C" {
 #define SDL_PREALLOC        0x00000001  /**< Surface uses preallocated memory */
 #define SDL_RLEACCEL        0x00000002  /**< Surface is RLE encoded */
 #define SDL_DONTFREE        0x00000004  /**< Surface is referenced internally */
+#define SDL_SIMD_ALIGNED    0x00000008  /**< Surface uses SIMD aligned memory */
+#define SDL_POOLED          0x00000010  /**< Surface is recycled when freed */
+#define SDL_DIRTYTRACKED    0x00000020  /**< Surface changes are tracked for window updates */
 /* @} *//* Surface flags */
 
 /**
@@ -106,7 +109,18 @@ typedef int (*SDL_blit) (struct SDL_Surface * src, SDL_Rect * srcrect,
  *
  *  If the function runs out of memory, it will return NULL.
  *
- *  \param flags The \c flags are obsolete and should be set to 0.
+ *  If ::SDL_SIMD_ALIGNED is passed in \c flags, the pixels will start on a
+ *  SDL_SIMDGetAlignment() boundary and the pitch will be padded to a
+ *  multiple of it, so every row is aligned for vector blits and fills.
+ *
+ *  If ::SDL_POOLED is passed in \c flags, the surface may be recycled from
+ *  the surface pool, and SDL_FreeSurface() returns it to the pool instead
+ *  of releasing its memory.  The pixel format and blit mapping are kept
+ *  with it, so per-frame scratch surfaces cost no allocations once the pool
+ *  is warm.  The pixels of a recycled surface are not cleared.  Surfaces
+ *  with a palette are never pooled.
+ *
+ *  \param flags 0, or a mask of ::SDL_SIMD_ALIGNED and ::SDL_POOLED.
  *  \param width The width in pixels of the surface to create.
  *  \param height The height in pixels of the surface to create.
  *  \param depth The depth in bits of the surface to create.
@@ -129,6 +143,17 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateRGBSurfaceFrom(void *pixels,
                                                               Uint32 Amask);
 extern DECLSPEC void SDLCALL SDL_FreeSurface(SDL_Surface * surface);
 
+/**
+ *  \brief Release all idle surfaces held by the surface pool.
+ *
+ *  Surfaces created with ::SDL_POOLED that are still in use are unaffected,
+ *  and will go back to the pool when they are freed.
+ *
+ *  \sa SDL_CreateRGBSurface
+ *  \sa SDL_HINT_SURFACE_POOL_SIZE
+ */
+extern DECLSPEC void SDLCALL SDL_FlushSurfacePool(void);
+
 /**
  *  \brief Set the palette used by a surface.
  *
@@ -65,6 +65,15 @@ extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceCounter(void);
  */
 extern DECLSPEC Uint64 SDLCALL SDL_GetPerformanceFrequency(void);
 
+/**
+ * \brief Get the number of nanoseconds since the SDL library initialization.
+ *
+ * This counts from the same starting point as SDL_GetTicks(), with the
+ * precision of the high resolution counter.  It is the time base of the
+ * \c timestamp_ns field of input events.
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_GetTicksNS(void);
+
 /**
  * \brief Wait a specified number of milliseconds before returning.
  */
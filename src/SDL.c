@@ -40,6 +40,7 @@ extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 extern void SDL_TicksInit(void);
 extern void SDL_TicksQuit(void);
+extern void SDL_TicksNSQuit(void);
 #endif
 #if SDL_VIDEO_DRIVER_WINDOWS
 extern int SDL_HelperWindowCreate(void);
@@ -358,8 +359,10 @@ SDL_Quit(void)
 
 #if !SDL_TIMERS_DISABLED
     SDL_TicksQuit();
+    SDL_TicksNSQuit();
 #endif
 
+    SDL_FlushSurfacePool();
     SDL_ClearHints();
     SDL_AssertionsQuit();
     SDL_LogResetPriorities();
@@ -37,9 +37,17 @@ static _THIS = NULL;
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <limits.h>             /* For the definition of PATH_MAX */
 #include <linux/input.h>
+#include <time.h>
+
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
 #ifdef SDL_INPUT_LINUXKD
 #include <linux/kd.h>
 #include <linux/keyboard.h>
@@ -460,8 +468,23 @@ SDL_EVDEV_Init(void)
             return SDL_OutOfMemory();
         }
 
+        /* A pipe for waking up SDL_EVDEV_Wait() */
+        if (pipe(_this->wakeup_pipe) == 0) {
+            int i;
+            for (i = 0; i < 2; ++i) {
+                fcntl(_this->wakeup_pipe[i], F_SETFL, fcntl(_this->wakeup_pipe[i], F_GETFL) | O_NONBLOCK);
+                fcntl(_this->wakeup_pipe[i], F_SETFD, FD_CLOEXEC);
+            }
+        } else {
+            _this->wakeup_pipe[0] = _this->wakeup_pipe[1] = -1;
+        }
+
 #if SDL_USE_LIBUDEV
         if (SDL_UDEV_Init() < 0) {
+            if (_this->wakeup_pipe[0] >= 0) {
+                close(_this->wakeup_pipe[0]);
+                close(_this->wakeup_pipe[1]);
+            }
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -534,6 +557,11 @@ SDL_EVDEV_Quit(void)
         SDL_assert(_this->first == NULL);
         SDL_assert(_this->last == NULL);
         SDL_assert(_this->numdevices == 0);
+
+        if (_this->wakeup_pipe[0] >= 0) {
+            close(_this->wakeup_pipe[0]);
+            close(_this->wakeup_pipe[1]);
+        }
         
         SDL_free(_this);
         _this = NULL;
@@ -566,6 +594,74 @@ void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class, con
 
 #endif /* SDL_USE_LIBUDEV */
 
+/* The current time on the clock a device stamps its events with */
+static Uint64
+SDL_EVDEV_get_clock_ns(SDL_evdevlist_item *item)
+{
+    struct timespec now;
+
+    if (clock_gettime(item->monotonic_time ? CLOCK_MONOTONIC : CLOCK_REALTIME, &now) < 0) {
+        return 0;
+    }
+    return (Uint64) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+int
+SDL_EVDEV_Wait(int timeout)
+{
+    struct pollfd *pfds;
+    SDL_evdevlist_item *item;
+    int num_pfds = 0;
+    int retval;
+    char buf[16];
+
+    /* Without a pipe nothing can end the wait early, so keep it short */
+    if ((_this == NULL || _this->wakeup_pipe[0] < 0) && (timeout < 0 || timeout > 10)) {
+        timeout = 10;
+    }
+    if (_this == NULL) {
+        SDL_Delay(timeout);
+        return 0;
+    }
+
+    pfds = SDL_stack_alloc(struct pollfd, _this->numdevices + 2);
+    for (item = _this->first; item != NULL; item = item->next) {
+        pfds[num_pfds].fd = item->fd;
+        pfds[num_pfds].events = POLLIN;
+        ++num_pfds;
+    }
+#if SDL_USE_LIBUDEV
+    pfds[num_pfds].fd = SDL_UDEV_GetMonitorFd();
+    pfds[num_pfds].events = POLLIN;
+    ++num_pfds;
+#endif
+    pfds[num_pfds].fd = _this->wakeup_pipe[0];
+    pfds[num_pfds].events = POLLIN;
+    ++num_pfds;
+
+    retval = poll(pfds, num_pfds, timeout);
+    if (retval > 0 && (pfds[num_pfds - 1].revents & POLLIN)) {
+        while (read(_this->wakeup_pipe[0], buf, sizeof (buf)) > 0) {
+            continue;
+        }
+    }
+    SDL_stack_free(pfds);
+
+    return (retval > 0);
+}
+
+void
+SDL_EVDEV_Wakeup(void)
+{
+    const char wakeup = 0;
+
+    /* The pipe doesn't block; if it's full a wakeup is pending anyway */
+    if (_this == NULL || _this->wakeup_pipe[1] < 0 ||
+        write(_this->wakeup_pipe[1], &wakeup, 1) < 0) {
+        return;
+    }
+}
+
 void 
 SDL_EVDEV_Poll(void)
 {
@@ -595,8 +691,17 @@ SDL_EVDEV_Poll(void)
 
     for (item = _this->first; item != NULL; item = item->next) {
         while ((len = read(item->fd, events, (sizeof events))) > 0) {
+            const Uint64 now_ns = SDL_EVDEV_get_clock_ns(item);
+
             len /= sizeof(events[0]);
             for (i = 0; i < len; ++i) {
+                /* Pass along when the kernel saw the event */
+                const Uint64 event_ns = (Uint64) events[i].input_event_sec * 1000000000 +
+                                        (Uint64) events[i].input_event_usec * 1000;
+                if (now_ns && event_ns <= now_ns) {
+                    SDL_SetInputTimestampNS(SDL_GetInputTimestampFromAge(now_ns - event_ns));
+                }
+
                 switch (events[i].type) {
                 case EV_KEY:
                     if (events[i].code >= BTN_MOUSE && events[i].code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
@@ -702,6 +807,8 @@ SDL_EVDEV_Poll(void)
             }
         }    
     }
+
+    SDL_SetInputTimestampNS(0);
 }
 
 static SDL_Scancode
@@ -757,6 +864,14 @@ SDL_EVDEV_device_added(const char *devpath)
     
     /* Non blocking read mode */
     fcntl(item->fd, F_SETFL, O_NONBLOCK);
+
+#ifdef EVIOCSCLOCKID
+    {
+        /* Get event times that don't jump with the wall clock */
+        int clock_id = CLOCK_MONOTONIC;
+        item->monotonic_time = (ioctl(item->fd, EVIOCSCLOCKID, &clock_id) == 0);
+    }
+#endif
     
     if (_this->last == NULL) {
         _this->first = _this->last = item;
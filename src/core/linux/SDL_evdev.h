@@ -33,6 +33,7 @@ typedef struct SDL_evdevlist_item
 {
     char *path;
     int fd;
+    SDL_bool monotonic_time;    /* events are stamped with CLOCK_MONOTONIC */
     struct SDL_evdevlist_item *next;
 } SDL_evdevlist_item;
 
@@ -45,11 +46,15 @@ typedef struct SDL_EVDEV_PrivateData
     int console_fd;
     int kb_mode;
     int tty;
+    int wakeup_pipe[2];
 } SDL_EVDEV_PrivateData;
 
 extern int SDL_EVDEV_Init(void);
 extern void SDL_EVDEV_Quit(void);
 extern void SDL_EVDEV_Poll(void);
+/* Block until SDL_EVDEV_Poll() may have input, for video drivers' WaitEventTimeout */
+extern int SDL_EVDEV_Wait(int timeout);
+extern void SDL_EVDEV_Wakeup(void);
 
 
 #endif /* SDL_INPUT_LINUXEV */
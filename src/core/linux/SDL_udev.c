@@ -451,6 +451,16 @@ device_event(SDL_UDEV_deviceevent type, struct udev_device *dev)
     }
 }
 
+/* The descriptor that becomes readable with hotplug events, or -1 */
+int
+SDL_UDEV_GetMonitorFd(void)
+{
+    if (_this == NULL || _this->udev_mon == NULL) {
+        return -1;
+    }
+    return _this->udev_monitor_get_fd(_this->udev_mon);
+}
+
 void 
 SDL_UDEV_Poll(void)
 {
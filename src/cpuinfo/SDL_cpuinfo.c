@@ -767,6 +767,55 @@ SDL_GetSystemRAM(void)
     return SDL_SystemRAM;
 }
 
+static size_t SDL_SIMDAlignment = 0;
+
+size_t
+SDL_SIMDGetAlignment(void)
+{
+    if (!SDL_SIMDAlignment) {
+        size_t alignment = 16;  /* SSE, AltiVec and NEON all want 16 */
+        size_t cacheline = (size_t) SDL_GetCPUCacheLineSize();
+
+        if (SDL_HasAVX()) {
+            alignment = 32;
+        }
+        /* Some virtual machines report nonsense here, so sanity check it */
+        if (cacheline > alignment && cacheline <= 256 &&
+            (cacheline & (cacheline - 1)) == 0) {
+            alignment = cacheline;
+        }
+        SDL_SIMDAlignment = alignment;
+    }
+    return SDL_SIMDAlignment;
+}
+
+void *
+SDL_SIMDAlloc(const size_t len)
+{
+    const size_t alignment = SDL_SIMDGetAlignment();
+    const size_t padded = (len + alignment - 1) & ~(alignment - 1);
+    Uint8 *retval = NULL;
+    Uint8 *ptr;
+
+    /* Over-allocate so we can align the block and stash the real pointer
+       just in front of it for SDL_SIMDFree() */
+    ptr = (Uint8 *) SDL_malloc(padded + alignment + sizeof (void *));
+    if (ptr) {
+        retval = ptr + sizeof (void *);
+        retval += alignment - (((size_t) retval) & (alignment - 1));
+        *(((void **) retval) - 1) = ptr;
+    }
+    return retval;
+}
+
+void
+SDL_SIMDFree(void *ptr)
+{
+    if (ptr) {
+        SDL_free(*(((void **) ptr) - 1));
+    }
+}
+
 
 #ifdef TEST_MAIN
 
@@ -791,6 +840,7 @@ main()
     printf("AVX: %d\n", SDL_HasAVX());
     printf("AVX2: %d\n", SDL_HasAVX2());
     printf("RAM: %d MB\n", SDL_GetSystemRAM());
+    printf("SIMD alignment: %d\n", (int) SDL_SIMDGetAlignment());
     return 0;
 }
 
@@ -597,3 +597,40 @@
 #define SDL_JoystickCurrentPowerLevel SDL_JoystickCurrentPowerLevel_REAL
 #define SDL_GameControllerFromInstanceID SDL_GameControllerFromInstanceID_REAL
 #define SDL_JoystickFromInstanceID SDL_JoystickFromInstanceID_REAL
+#define SDL_SIMDGetAlignment SDL_SIMDGetAlignment_REAL
+#define SDL_SIMDAlloc SDL_SIMDAlloc_REAL
+#define SDL_SIMDFree SDL_SIMDFree_REAL
+#define SDL_FlushSurfacePool SDL_FlushSurfacePool_REAL
+#define SDL_RenderFlush SDL_RenderFlush_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_RenderDrawPointF SDL_RenderDrawPointF_REAL
+#define SDL_RenderDrawPointsF SDL_RenderDrawPointsF_REAL
+#define SDL_RenderDrawLineF SDL_RenderDrawLineF_REAL
+#define SDL_RenderDrawLinesF SDL_RenderDrawLinesF_REAL
+#define SDL_RenderDrawRectF SDL_RenderDrawRectF_REAL
+#define SDL_RenderDrawRectsF SDL_RenderDrawRectsF_REAL
+#define SDL_RenderFillRectF SDL_RenderFillRectF_REAL
+#define SDL_RenderFillRectsF SDL_RenderFillRectsF_REAL
+#define SDL_RenderCopyF SDL_RenderCopyF_REAL
+#define SDL_RenderCopyExF SDL_RenderCopyExF_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_RenderReadbackComplete SDL_RenderReadbackComplete_REAL
+#define SDL_GetRenderReadbackPixels SDL_GetRenderReadbackPixels_REAL
+#define SDL_FreeRenderReadback SDL_FreeRenderReadback_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_CreateAtlasTexture SDL_CreateAtlasTexture_REAL
+#define SDL_CreateAtlasTextureFromSurface SDL_CreateAtlasTextureFromSurface_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_GetCoalescedEventCount SDL_GetCoalescedEventCount_REAL
+#define SDL_PeepEventTypes SDL_PeepEventTypes_REAL
+#define SDL_GetTicksNS SDL_GetTicksNS_REAL
+#define SDL_StartEventRecording SDL_StartEventRecording_REAL
+#define SDL_StopEventRecording SDL_StopEventRecording_REAL
+#define SDL_StartEventReplay SDL_StartEventReplay_REAL
+#define SDL_IsEventReplayActive SDL_IsEventReplayActive_REAL
+#define SDL_StopEventReplay SDL_StopEventReplay_REAL
+#define SDL_AddEventWatchTypes SDL_AddEventWatchTypes_REAL
+#define SDL_GetEventQueueStats SDL_GetEventQueueStats_REAL
+#define SDL_GetEventTypeStats SDL_GetEventTypeStats_REAL
+#define SDL_ResetEventQueueStats SDL_ResetEventQueueStats_REAL
+#define SDL_GetInputSnapshot SDL_GetInputSnapshot_REAL
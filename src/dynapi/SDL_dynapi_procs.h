@@ -631,3 +631,40 @@ SDL_DYNAPI_PROC(int,SDL_GetDisplayDPI,(int a, float *b, float *c, float *d),(a,b
 SDL_DYNAPI_PROC(SDL_JoystickPowerLevel,SDL_JoystickCurrentPowerLevel,(SDL_Joystick *a),(a),return)
 SDL_DYNAPI_PROC(SDL_GameController*,SDL_GameControllerFromInstanceID,(SDL_JoystickID a),(a),return)
 SDL_DYNAPI_PROC(SDL_Joystick*,SDL_JoystickFromInstanceID,(SDL_JoystickID a),(a),return)
+SDL_DYNAPI_PROC(size_t,SDL_SIMDGetAlignment,(void),(),return)
+SDL_DYNAPI_PROC(void*,SDL_SIMDAlloc,(const size_t a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_SIMDFree,(void *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_FlushSurfacePool,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_RenderFlush,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawPointF,(SDL_Renderer *a, float b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawPointsF,(SDL_Renderer *a, const SDL_FPoint *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawLineF,(SDL_Renderer *a, float b, float c, float d, float e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawLinesF,(SDL_Renderer *a, const SDL_FPoint *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawRectF,(SDL_Renderer *a, const SDL_FRect *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderDrawRectsF,(SDL_Renderer *a, const SDL_FRect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderFillRectF,(SDL_Renderer *a, const SDL_FRect *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RenderFillRectsF,(SDL_Renderer *a, const SDL_FRect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyF,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyExF,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, const double e, const SDL_FPoint *f, const SDL_RendererFlip g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(SDL_RenderReadback*,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_RenderReadbackComplete,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderReadbackPixels,(SDL_RenderReadback *a, const void **b, int *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_FreeRenderReadback,(SDL_RenderReadback *a),(a),)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, Uint32 b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateAtlasTexture,(SDL_TextureAtlas *a, int b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateAtlasTextureFromSurface,(SDL_TextureAtlas *a, SDL_Surface *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetCoalescedEventCount,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_PeepEventTypes,(SDL_Event *a, int b, SDL_eventaction c, const Uint32 *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetTicksNS,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_StartEventRecording,(SDL_RWops *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_StopEventRecording,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_StartEventReplay,(SDL_RWops *a, int b, SDL_EventReplayMode c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_IsEventReplayActive,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_StopEventReplay,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_AddEventWatchTypes,(SDL_EventFilter a, void *b, const Uint32 *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_GetEventQueueStats,(SDL_EventQueueStats *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetEventTypeStats,(Uint32 a, Uint64 *b, Uint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_ResetEventQueueStats,(void),(),)
+SDL_DYNAPI_PROC(Uint32,SDL_GetInputSnapshot,(SDL_InputSnapshot *a),(a),return)
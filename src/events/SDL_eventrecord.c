@@ -0,0 +1,472 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Recording of the event stream and replaying it into the event queue */
+
+#include "SDL_endian.h"
+#include "SDL_events.h"
+#include "SDL_rwops.h"
+#include "SDL_timer.h"
+#include "SDL_events_c.h"
+
+/* The stream starts with this header:
+
+     8 bytes  "SDLEVREC"
+     1 byte   format version
+     1 byte   'L' or 'B' for the byte order of the event data
+     1 byte   sizeof(SDL_Event)
+
+   and is followed by records, each of which starts with a tag byte and the
+   number of nanoseconds since the previous record as an unsigned LEB128
+   number.  Event records go on with the event type and the length of the
+   data as LEB128 numbers, then the event's fields after the timestamp, as
+   they are laid out in memory.  SDL_DROPFILE records carry the file name
+   instead.  Pump records mark where SDL_PumpEvents() was called.
+ */
+#define SDL_EVENTRECORD_MAGIC   "SDLEVREC"
+#define SDL_EVENTRECORD_VERSION 1
+#define SDL_EVENTRECORD_EVENT   'E'
+#define SDL_EVENTRECORD_PUMP    'P'
+
+/* Fields after 'type' and 'timestamp' */
+#define SDL_EVENTRECORD_HEADER  (2 * sizeof(Uint32))
+
+/* Tag, time, type, length and an event, with room to spare */
+#define SDL_EVENTRECORD_MAX     (1 + 10 + 5 + 5 + sizeof(SDL_Event))
+
+static struct
+{
+    SDL_mutex *lock;
+    SDL_RWops *dst;
+    int freedst;
+    Uint64 last_ns;
+    SDL_bool need_pump;     /* events were recorded since the last pump record */
+} SDL_recorder;
+
+static struct
+{
+    SDL_RWops *src;
+    int freesrc;
+    SDL_EventReplayMode mode;
+    Uint64 start_ns;        /* when the replay started */
+    Uint64 record_ns;       /* when the next record was recorded */
+    Uint8 tag;              /* the next record, or 0 if it hasn't been read */
+    SDL_Event event;
+} SDL_replayer;
+
+
+/* How much of an event of this type is worth keeping */
+static size_t
+SDL_GetRecordedEventSize(Uint32 type)
+{
+    switch (type) {
+    case SDL_WINDOWEVENT:
+        return sizeof(SDL_WindowEvent);
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        return sizeof(SDL_KeyboardEvent);
+    case SDL_TEXTEDITING:
+        return sizeof(SDL_TextEditingEvent);
+    case SDL_TEXTINPUT:
+        return sizeof(SDL_TextInputEvent);
+    case SDL_MOUSEMOTION:
+        return sizeof(SDL_MouseMotionEvent);
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        return sizeof(SDL_MouseButtonEvent);
+    case SDL_MOUSEWHEEL:
+        return sizeof(SDL_MouseWheelEvent);
+    case SDL_JOYAXISMOTION:
+        return sizeof(SDL_JoyAxisEvent);
+    case SDL_JOYBALLMOTION:
+        return sizeof(SDL_JoyBallEvent);
+    case SDL_JOYHATMOTION:
+        return sizeof(SDL_JoyHatEvent);
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        return sizeof(SDL_JoyButtonEvent);
+    case SDL_JOYDEVICEADDED:
+    case SDL_JOYDEVICEREMOVED:
+        return sizeof(SDL_JoyDeviceEvent);
+    case SDL_CONTROLLERAXISMOTION:
+        return sizeof(SDL_ControllerAxisEvent);
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        return sizeof(SDL_ControllerButtonEvent);
+    case SDL_CONTROLLERDEVICEADDED:
+    case SDL_CONTROLLERDEVICEREMOVED:
+    case SDL_CONTROLLERDEVICEREMAPPED:
+        return sizeof(SDL_ControllerDeviceEvent);
+    case SDL_FINGERDOWN:
+    case SDL_FINGERUP:
+    case SDL_FINGERMOTION:
+        return sizeof(SDL_TouchFingerEvent);
+    case SDL_DOLLARGESTURE:
+    case SDL_DOLLARRECORD:
+        return sizeof(SDL_DollarGestureEvent);
+    case SDL_MULTIGESTURE:
+        return sizeof(SDL_MultiGestureEvent);
+    case SDL_AUDIODEVICEADDED:
+    case SDL_AUDIODEVICEREMOVED:
+        return sizeof(SDL_AudioDeviceEvent);
+    default:
+        if (type >= SDL_USEREVENT) {
+            return sizeof(SDL_UserEvent);
+        }
+        break;
+    }
+    /* Application, clipboard and render events have no fields */
+    return sizeof(SDL_CommonEvent);
+}
+
+static size_t
+SDL_EncodeNumber(Uint8 *buf, Uint64 value)
+{
+    size_t len = 0;
+
+    do {
+        Uint8 byte = (Uint8) (value & 0x7F);
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        buf[len++] = byte;
+    } while (value);
+
+    return len;
+}
+
+static SDL_bool
+SDL_ReadNumber(SDL_RWops *src, Uint64 *value)
+{
+    Uint8 byte;
+    int shift = 0;
+
+    *value = 0;
+    do {
+        if (shift >= 64 || SDL_RWread(src, &byte, 1, 1) != 1) {
+            return SDL_FALSE;
+        }
+        *value |= (Uint64) (byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return SDL_TRUE;
+}
+
+/* Write a record -- called with the recorder locked */
+static void
+SDL_WriteRecord(Uint8 tag, const SDL_Event *event)
+{
+    Uint8 buf[SDL_EVENTRECORD_MAX];
+    const Uint64 now = SDL_GetTicksNS();
+    const char *extra = NULL;
+    size_t len = 0, extralen = 0;
+
+    buf[len++] = tag;
+    len += SDL_EncodeNumber(&buf[len], now - SDL_recorder.last_ns);
+    SDL_recorder.last_ns = now;
+
+    if (tag == SDL_EVENTRECORD_EVENT) {
+        size_t size = 0;
+
+        len += SDL_EncodeNumber(&buf[len], event->type);
+        if (event->type == SDL_DROPFILE) {
+            extra = event->drop.file;
+            extralen = extra ? SDL_strlen(extra) : 0;
+        } else {
+            size = SDL_GetRecordedEventSize(event->type) - SDL_EVENTRECORD_HEADER;
+        }
+        len += SDL_EncodeNumber(&buf[len], size + extralen);
+        SDL_memcpy(&buf[len], (const Uint8 *) event + SDL_EVENTRECORD_HEADER, size);
+        if (event->type >= SDL_USEREVENT) {
+            /* Pointers won't mean anything when the events are replayed */
+            SDL_memset(&buf[len] + offsetof(SDL_UserEvent, data1) - SDL_EVENTRECORD_HEADER,
+                       0, 2 * sizeof(void *));
+        }
+        len += size;
+        SDL_recorder.need_pump = SDL_TRUE;
+    }
+
+    if (SDL_RWwrite(SDL_recorder.dst, buf, len, 1) != 1 ||
+        (extralen && SDL_RWwrite(SDL_recorder.dst, extra, extralen, 1) != 1)) {
+        /* Don't keep writing to a broken stream */
+        if (SDL_recorder.freedst) {
+            SDL_RWclose(SDL_recorder.dst);
+        }
+        SDL_recorder.dst = NULL;
+    }
+}
+
+int
+SDL_StartEventRecording(SDL_RWops * dst, int freedst)
+{
+    Uint8 header[11];
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+
+    SDL_StopEventRecording();
+
+    SDL_memcpy(header, SDL_EVENTRECORD_MAGIC, 8);
+    header[8] = SDL_EVENTRECORD_VERSION;
+    header[9] = (SDL_BYTEORDER == SDL_LIL_ENDIAN) ? 'L' : 'B';
+    header[10] = (Uint8) sizeof(SDL_Event);
+    if (SDL_RWwrite(dst, header, sizeof(header), 1) != 1) {
+        if (freedst) {
+            SDL_RWclose(dst);
+        }
+        return SDL_SetError("Couldn't write event recording header");
+    }
+
+    if (!SDL_recorder.lock) {
+        SDL_recorder.lock = SDL_CreateMutex();
+    }
+    if (SDL_recorder.lock) {
+        SDL_LockMutex(SDL_recorder.lock);
+    }
+    SDL_recorder.freedst = freedst;
+    SDL_recorder.last_ns = SDL_GetTicksNS();
+    SDL_recorder.need_pump = SDL_FALSE;
+    SDL_recorder.dst = dst;
+    if (SDL_recorder.lock) {
+        SDL_UnlockMutex(SDL_recorder.lock);
+    }
+    return 0;
+}
+
+void
+SDL_StopEventRecording(void)
+{
+    if (SDL_recorder.lock) {
+        SDL_LockMutex(SDL_recorder.lock);
+    }
+    if (SDL_recorder.dst) {
+        if (SDL_recorder.need_pump) {
+            SDL_WriteRecord(SDL_EVENTRECORD_PUMP, NULL);
+        }
+        if (SDL_recorder.dst && SDL_recorder.freedst) {
+            SDL_RWclose(SDL_recorder.dst);
+        }
+        SDL_recorder.dst = NULL;
+    }
+    if (SDL_recorder.lock) {
+        SDL_UnlockMutex(SDL_recorder.lock);
+    }
+}
+
+void
+SDL_RecordEvent(const SDL_Event * event)
+{
+    if (!SDL_recorder.dst || event->type == SDL_SYSWMEVENT) {
+        return;
+    }
+
+    if (SDL_recorder.lock) {
+        SDL_LockMutex(SDL_recorder.lock);
+    }
+    if (SDL_recorder.dst) {
+        SDL_WriteRecord(SDL_EVENTRECORD_EVENT, event);
+    }
+    if (SDL_recorder.lock) {
+        SDL_UnlockMutex(SDL_recorder.lock);
+    }
+}
+
+void
+SDL_RecordPumpEvents(void)
+{
+    if (!SDL_recorder.dst || !SDL_recorder.need_pump) {
+        return;
+    }
+
+    if (SDL_recorder.lock) {
+        SDL_LockMutex(SDL_recorder.lock);
+    }
+    if (SDL_recorder.dst) {
+        SDL_WriteRecord(SDL_EVENTRECORD_PUMP, NULL);
+        SDL_recorder.need_pump = SDL_FALSE;
+    }
+    if (SDL_recorder.lock) {
+        SDL_UnlockMutex(SDL_recorder.lock);
+    }
+}
+
+/* Read the next record into SDL_replayer, returns SDL_FALSE at the end */
+static SDL_bool
+SDL_ReadRecord(void)
+{
+    SDL_RWops *src = SDL_replayer.src;
+    Uint64 delta, type, size;
+    Uint8 tag;
+
+    if (SDL_RWread(src, &tag, 1, 1) != 1 || !SDL_ReadNumber(src, &delta)) {
+        return SDL_FALSE;
+    }
+    SDL_replayer.record_ns += delta;
+
+    if (tag == SDL_EVENTRECORD_PUMP) {
+        SDL_replayer.tag = tag;
+        return SDL_TRUE;
+    }
+    if (tag != SDL_EVENTRECORD_EVENT ||
+        !SDL_ReadNumber(src, &type) || !SDL_ReadNumber(src, &size)) {
+        return SDL_FALSE;
+    }
+
+    SDL_zero(SDL_replayer.event);
+    SDL_replayer.event.type = (Uint32) type;
+    if (type == SDL_DROPFILE) {
+        char *file = (char *) SDL_malloc((size_t) size + 1);
+        if (!file) {
+            return SDL_FALSE;
+        }
+        if (size && SDL_RWread(src, file, (size_t) size, 1) != 1) {
+            SDL_free(file);
+            return SDL_FALSE;
+        }
+        file[size] = '\0';
+        SDL_replayer.event.drop.file = file;
+    } else {
+        if (size > sizeof(SDL_Event) - SDL_EVENTRECORD_HEADER) {
+            return SDL_FALSE;
+        }
+        if (size && SDL_RWread(src, (Uint8 *) &SDL_replayer.event + SDL_EVENTRECORD_HEADER, (size_t) size, 1) != 1) {
+            return SDL_FALSE;
+        }
+    }
+    SDL_replayer.tag = tag;
+    return SDL_TRUE;
+}
+
+int
+SDL_StartEventReplay(SDL_RWops * src, int freesrc, SDL_EventReplayMode mode)
+{
+    Uint8 header[11];
+    int status = 0;
+
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+
+    SDL_StopEventReplay();
+
+    if (SDL_RWread(src, header, sizeof(header), 1) != 1 ||
+        SDL_memcmp(header, SDL_EVENTRECORD_MAGIC, 8) != 0) {
+        status = SDL_SetError("Not an event recording");
+    } else if (header[8] != SDL_EVENTRECORD_VERSION) {
+        status = SDL_SetError("Unsupported event recording version %d", header[8]);
+    } else if (header[9] != ((SDL_BYTEORDER == SDL_LIL_ENDIAN) ? 'L' : 'B') ||
+               header[10] != sizeof(SDL_Event)) {
+        status = SDL_SetError("Event recording was made on an incompatible platform");
+    }
+    if (status < 0) {
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return status;
+    }
+
+    SDL_replayer.src = src;
+    SDL_replayer.freesrc = freesrc;
+    SDL_replayer.mode = mode;
+    SDL_replayer.start_ns = SDL_GetTicksNS();
+    SDL_replayer.record_ns = 0;
+    SDL_replayer.tag = 0;
+    return 0;
+}
+
+void
+SDL_StopEventReplay(void)
+{
+    if (!SDL_replayer.src) {
+        return;
+    }
+    if (SDL_replayer.tag == SDL_EVENTRECORD_EVENT &&
+        SDL_replayer.event.type == SDL_DROPFILE) {
+        SDL_free(SDL_replayer.event.drop.file);
+    }
+    if (SDL_replayer.freesrc) {
+        SDL_RWclose(SDL_replayer.src);
+    }
+    SDL_replayer.src = NULL;
+    SDL_replayer.tag = 0;
+}
+
+SDL_bool
+SDL_IsEventReplayActive(void)
+{
+    return SDL_replayer.src ? SDL_TRUE : SDL_FALSE;
+}
+
+void
+SDL_ReplayPumpEvents(void)
+{
+    while (SDL_replayer.src) {
+        if (!SDL_replayer.tag && !SDL_ReadRecord()) {
+            SDL_StopEventReplay();
+            return;
+        }
+
+        if (SDL_replayer.tag == SDL_EVENTRECORD_PUMP) {
+            SDL_replayer.tag = 0;
+            if (SDL_replayer.mode == SDL_REPLAY_BENCHMARK) {
+                /* That's all for this call to SDL_PumpEvents() */
+                return;
+            }
+            continue;
+        }
+
+        if (SDL_replayer.mode == SDL_REPLAY_REALTIME) {
+            const Uint64 due = SDL_replayer.start_ns + SDL_replayer.record_ns;
+            if (due > SDL_GetTicksNS()) {
+                return;
+            }
+            SDL_SetInputTimestampNS(due);
+        }
+
+        /* The recorded events already went past the filter and watchers,
+           so they go straight into the queue */
+        SDL_replayer.event.common.timestamp = SDL_GetTicks();
+        SDL_StampInputEvent(&SDL_replayer.event);
+        SDL_SetInputTimestampNS(0);
+        if (SDL_PeepEvents(&SDL_replayer.event, 1, SDL_ADDEVENT, 0, 0) <= 0 &&
+            SDL_replayer.event.type == SDL_DROPFILE) {
+            SDL_free(SDL_replayer.event.drop.file);
+        }
+        SDL_replayer.tag = 0;
+    }
+}
+
+void
+SDL_QuitEventRecording(void)
+{
+    SDL_StopEventRecording();
+    SDL_StopEventReplay();
+    if (SDL_recorder.lock) {
+        SDL_DestroyMutex(SDL_recorder.lock);
+        SDL_recorder.lock = NULL;
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
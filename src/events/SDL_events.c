@@ -36,6 +36,9 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS   65535
 
+/* How long a wait may go without pumping, when something has to be polled */
+#define SDL_WAIT_POLL_INTERVAL  10
+
 /* Public data -- the event filter */
 SDL_EventFilter SDL_EventOK = NULL;
 void *SDL_EventOKParam;
@@ -43,11 +46,40 @@ void *SDL_EventOKParam;
 typedef struct SDL_EventWatcher {
     SDL_EventFilter callback;
     void *userdata;
+    Uint32 *types;          /* the types watched, or NULL for all of them */
+    int numtypes;
     struct SDL_EventWatcher *next;
 } SDL_EventWatcher;
 
 static SDL_EventWatcher *SDL_event_watchers = NULL;
 
+/* NULL terminated lists of the watchers to call for each event type, in the
+   order they were added.  Types that no watcher names use the 'any' list. */
+typedef struct {
+    SDL_EventWatcher **watchers[256];
+} SDL_EventWatchBlock;
+
+typedef struct SDL_EventWatchTable {
+    int count;              /* the number of watchers */
+    SDL_EventWatcher **any;
+    SDL_EventWatchBlock *blocks[256];
+    struct SDL_EventWatchTable *retired;
+} SDL_EventWatchTable;
+
+/* SDL_PushEvent() reads the dispatch table from any thread without a lock,
+   so a changed table is published with an atomic pointer swap.  Replaced
+   tables and removed watchers may still be in use by another thread, so
+   they wait on the retired lists until no SDL_PushEvent() is dispatching.
+   The lists are kept with SDL_event_watchers_lock held. */
+static SDL_EventWatchTable *SDL_event_watch_table = NULL;
+static SDL_EventWatchTable *SDL_event_watch_tables_retired = NULL;
+static SDL_EventWatcher *SDL_event_watchers_removed = NULL;
+static SDL_atomic_t SDL_event_watch_readers;
+static SDL_SpinLock SDL_event_watchers_lock;
+
+static void SDL_FreeEventWatchTable(SDL_EventWatchTable * table);
+static void SDL_FreeRetiredEventWatchers(void);
+
 typedef struct {
     Uint32 bits[8];
 } SDL_DisabledEventBlock;
@@ -55,11 +87,24 @@ typedef struct {
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_USEREVENT;
 
+/* Number of queued events of each type, and how many have been added and
+   removed, kept with the queue locked */
+typedef struct {
+    int counts[256];
+    Uint64 pushed[256];
+    Uint64 popped[256];
+} SDL_EventCountBlock;
+
+static SDL_EventCountBlock *SDL_event_counts[256];
+static int SDL_event_block_counts[256];
+static int SDL_event_other_count;   /* types past SDL_LASTEVENT */
+
 /* Private data -- event queue */
 typedef struct _SDL_EventEntry
 {
     SDL_Event event;
     SDL_SysWMmsg msg;
+    Uint64 queued_ns;               /* when the event was pushed, in SDL_GetTicksNS() time */
     struct _SDL_EventEntry *prev;
     struct _SDL_EventEntry *next;
 } SDL_EventEntry;
@@ -73,6 +118,8 @@ typedef struct _SDL_SysWMEntry
 static struct
 {
     SDL_mutex *lock;
+    SDL_cond *wait_cond;            /* signaled when an event is added */
+    SDL_bool waiting_on_video;      /* a thread is in the video driver's WaitEventTimeout */
     volatile SDL_bool active;
     volatile int count;
     volatile int max_events_seen;
@@ -81,7 +128,86 @@ static struct
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, SDL_TRUE, 0, 0, NULL, NULL, NULL, NULL, NULL };
+    volatile int coalesced_events;
+} SDL_EventQ = { NULL, NULL, SDL_FALSE, SDL_TRUE, 0, 0, NULL, NULL, NULL, NULL, NULL, 0 };
+
+/* Event queue statistics, see SDL_GetEventQueueStats().  The filter time
+   is kept under its own spinlock, the rest with the queue locked. */
+static struct
+{
+    Uint64 pushed;
+    Uint64 popped;
+    Uint32 dropped;
+    Uint32 depth_histogram[SDL_EVENT_QUEUE_DEPTH_BUCKETS];
+    Uint64 residency_ns;
+    Uint64 max_residency_ns;
+    SDL_SpinLock filter_lock;
+    Uint64 filtered;
+    Uint64 filter_ns;
+} SDL_EventStats;
+
+/* When the input being sent by a backend happened, kept per thread */
+static SDL_SpinLock SDL_input_timestamp_lock;
+static SDL_TLSID SDL_input_timestamp_tls = 0;
+
+/* Which kinds of events are merged into a matching event at the queue's tail */
+static SDL_bool SDL_coalesce_mouse_motion = SDL_FALSE;
+static SDL_bool SDL_coalesce_window_resize = SDL_FALSE;
+static SDL_bool SDL_coalesce_finger_motion = SDL_FALSE;
+
+/* Bounded lock-free ring in front of the event queue.
+
+   Any thread can add to the ring without taking the queue lock. The
+   consumer is whoever holds the lock: it moves published events from the
+   ring onto the end of the list before looking at the list, so the list
+   and all of the existing filtering code see events in the order they were
+   pushed. When the ring is full, or for events that carry extra data
+   (SDL_SYSWMEVENT), the producer takes the lock and appends to the list
+   after draining the ring.
+
+   Each slot's sequence number says whose turn it is, as in Dmitry Vyukov's
+   bounded queue. It's stored relative to the slot's index, so the zeroed
+   static array is already a valid empty ring.
+ */
+#define SDL_EVENT_RING_SIZE     1024    /* Must be a power of two */
+#define SDL_EVENT_RING_MASK     (SDL_EVENT_RING_SIZE - 1)
+#define SDL_EVENT_RING_LAP(pos) ((pos) & ~(Uint32)SDL_EVENT_RING_MASK)
+#define SDL_EVENT_RING_MAX_WAITS    100     /* times to yield to a producer that is filling in a slot */
+
+typedef struct
+{
+    SDL_atomic_t sequence;
+    Uint64 queued_ns;
+    SDL_Event event;
+} SDL_EventRingSlot;
+
+static struct
+{
+    SDL_atomic_t enqueue_pos;
+    char pad1[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    Uint32 dequeue_pos;             /* only touched with the queue locked */
+    char pad2[SDL_CACHELINE_SIZE - sizeof(Uint32)];
+    SDL_atomic_t waiters;           /* threads blocked in SDL_BlockForEvents() */
+    char pad3[SDL_CACHELINE_SIZE - sizeof(SDL_atomic_t)];
+    SDL_EventRingSlot slots[SDL_EVENT_RING_SIZE];
+} SDL_EventRing;
+
+static void SDL_DrainEventRing(SDL_bool wait_for_producers);
+static void SDL_ResetEventRing(void);
+static void SDL_ResetEventStats(void);
+
+
+static void
+SDL_EventCoalesceChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_bool *enabled = (SDL_bool *)userdata;
+
+    if (hint && *hint == '1') {
+        *enabled = SDL_TRUE;
+    } else {
+        *enabled = SDL_FALSE;
+    }
+}
 
 
 /* Public functions */
@@ -94,15 +220,39 @@ SDL_StopEventLoop(void)
     SDL_EventEntry *entry;
     SDL_SysWMEntry *wmmsg;
 
+    SDL_QuitEventRecording();
+
     if (SDL_EventQ.lock) {
         SDL_LockMutex(SDL_EventQ.lock);
     }
 
     SDL_EventQ.active = SDL_FALSE;
 
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_mouse_motion);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_WINDOW_RESIZE,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_window_resize);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_FINGER_MOTION,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_finger_motion);
+
+    /* Anything still in the ring gets freed along with the list, and
+       whatever doesn't fit is dropped with the ring's positions */
+    SDL_DrainEventRing(SDL_FALSE);
+    SDL_ResetEventRing();
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
                 SDL_EventQ.max_events_seen);
+        SDL_Log("SDL EVENT QUEUE: Events coalesced: %d\n",
+                SDL_EventQ.coalesced_events);
+        SDL_Log("SDL EVENT QUEUE: Events pushed: %" SDL_PRIu64 ", popped: %" SDL_PRIu64 ", dropped: %u\n",
+                SDL_EventStats.pushed, SDL_EventStats.popped,
+                SDL_EventStats.dropped);
+        if (SDL_EventStats.popped) {
+            SDL_Log("SDL EVENT QUEUE: Time in queue: %u us average, %u us maximum\n",
+                    (unsigned) (SDL_EventStats.residency_ns / SDL_EventStats.popped / 1000),
+                    (unsigned) (SDL_EventStats.max_residency_ns / 1000));
+        }
     }
 
     /* Clean out EventQ */
@@ -129,23 +279,38 @@ SDL_StopEventLoop(void)
 
     SDL_EventQ.count = 0;
     SDL_EventQ.max_events_seen = 0;
+    SDL_EventQ.coalesced_events = 0;
+    SDL_ResetEventStats();
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
 
+    for (i = 0; i < SDL_arraysize(SDL_event_counts); ++i) {
+        SDL_free(SDL_event_counts[i]);
+        SDL_event_counts[i] = NULL;
+        SDL_event_block_counts[i] = 0;
+    }
+    SDL_event_other_count = 0;
+
     /* Clear disabled event state */
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
         SDL_free(SDL_disabled_events[i]);
         SDL_disabled_events[i] = NULL;
     }
 
+    if (SDL_event_watch_table) {
+        SDL_FreeEventWatchTable(SDL_event_watch_table);
+        SDL_event_watch_table = NULL;
+    }
     while (SDL_event_watchers) {
         SDL_EventWatcher *tmp = SDL_event_watchers;
         SDL_event_watchers = tmp->next;
+        SDL_free(tmp->types);
         SDL_free(tmp);
     }
+    SDL_FreeRetiredEventWatchers();
     SDL_EventOK = NULL;
 
     if (SDL_EventQ.lock) {
@@ -153,6 +318,10 @@ SDL_StopEventLoop(void)
         SDL_DestroyMutex(SDL_EventQ.lock);
         SDL_EventQ.lock = NULL;
     }
+    if (SDL_EventQ.wait_cond) {
+        SDL_DestroyCond(SDL_EventQ.wait_cond);
+        SDL_EventQ.wait_cond = NULL;
+    }
 }
 
 /* This function (and associated calls) may be called more than once */
@@ -173,6 +342,12 @@ SDL_StartEventLoop(void)
     if (SDL_EventQ.lock == NULL) {
         return (-1);
     }
+    if (!SDL_EventQ.wait_cond) {
+        SDL_EventQ.wait_cond = SDL_CreateCond();
+    }
+    if (SDL_EventQ.wait_cond == NULL) {
+        return (-1);
+    }
 #endif /* !SDL_THREADS_DISABLED */
 
     /* Process most event types */
@@ -180,15 +355,147 @@ SDL_StartEventLoop(void)
     SDL_EventState(SDL_TEXTEDITING, SDL_DISABLE);
     SDL_EventState(SDL_SYSWMEVENT, SDL_DISABLE);
 
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_mouse_motion);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_WINDOW_RESIZE,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_window_resize);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_FINGER_MOTION,
+                        SDL_EventCoalesceChanged, &SDL_coalesce_finger_motion);
+
     SDL_EventQ.active = SDL_TRUE;
 
     return (0);
 }
 
 
-/* Add an event to the event queue -- called with the queue locked */
+/* Track how many events of a type are queued -- called with the queue locked */
+static SDL_bool
+SDL_UpdateEventCount(Uint32 type, int delta)
+{
+    Uint8 hi, lo;
+
+    if (type > SDL_LASTEVENT) {
+        SDL_event_other_count += delta;
+        return SDL_TRUE;
+    }
+
+    hi = ((type >> 8) & 0xff);
+    lo = (type & 0xff);
+    if (!SDL_event_counts[hi]) {
+        SDL_event_counts[hi] = (SDL_EventCountBlock *) SDL_calloc(1, sizeof(SDL_EventCountBlock));
+        if (!SDL_event_counts[hi]) {
+            SDL_OutOfMemory();
+            return SDL_FALSE;
+        }
+    }
+    SDL_event_counts[hi]->counts[lo] += delta;
+    SDL_event_block_counts[hi] += delta;
+    return SDL_TRUE;
+}
+
+/* Count the queued events within a range of types -- called with the queue locked */
 static int
-SDL_AddEvent(SDL_Event * event)
+SDL_CountQueuedEvents(Uint32 minType, Uint32 maxType)
+{
+    int count = 0;
+    Uint32 hi, lo;
+
+    if (maxType > SDL_LASTEVENT) {
+        if (SDL_event_other_count > 0) {
+            /* These aren't counted by type, so look for them the slow way */
+            SDL_EventEntry *entry;
+            for (entry = SDL_EventQ.head; entry; entry = entry->next) {
+                const Uint32 type = entry->event.type;
+                if (type > SDL_LASTEVENT && minType <= type && type <= maxType) {
+                    ++count;
+                }
+            }
+        }
+        maxType = SDL_LASTEVENT;
+    }
+    if (minType > maxType) {
+        return count;
+    }
+
+    for (hi = (minType >> 8); hi <= (maxType >> 8); ++hi) {
+        const Uint32 first = SDL_max(minType, hi << 8);
+        const Uint32 last = SDL_min(maxType, (hi << 8) | 0xff);
+
+        if (!SDL_event_block_counts[hi]) {
+            continue;
+        }
+        if ((first & 0xff) == 0 && (last & 0xff) == 0xff) {
+            count += SDL_event_block_counts[hi];
+        } else {
+            for (lo = (first & 0xff); lo <= (last & 0xff); ++lo) {
+                count += SDL_event_counts[hi]->counts[lo];
+            }
+        }
+    }
+    return count;
+}
+
+/* Count an event added to or removed from the queue -- called with the queue locked */
+static void
+SDL_CountEventStats(Uint32 type, SDL_bool pushed)
+{
+    SDL_EventCountBlock *block = NULL;
+
+    if (type <= SDL_LASTEVENT) {
+        block = SDL_event_counts[(type >> 8) & 0xff];
+    }
+    if (pushed) {
+        int depth = SDL_EventQ.count;
+        int bucket = 0;
+
+        while (depth > 1 && bucket < SDL_EVENT_QUEUE_DEPTH_BUCKETS - 1) {
+            depth >>= 1;
+            ++bucket;
+        }
+        ++SDL_EventStats.depth_histogram[bucket];
+        ++SDL_EventStats.pushed;
+        if (block) {
+            ++block->pushed[type & 0xff];
+        }
+    } else {
+        ++SDL_EventStats.popped;
+        if (block) {
+            ++block->popped[type & 0xff];
+        }
+    }
+}
+
+/* Forget the statistics -- called with the queue locked */
+static void
+SDL_ResetEventStats(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_event_counts); ++i) {
+        if (SDL_event_counts[i]) {
+            SDL_zero(SDL_event_counts[i]->pushed);
+            SDL_zero(SDL_event_counts[i]->popped);
+        }
+    }
+    SDL_EventStats.pushed = 0;
+    SDL_EventStats.popped = 0;
+    SDL_EventStats.dropped = 0;
+    SDL_zero(SDL_EventStats.depth_histogram);
+    SDL_EventStats.residency_ns = 0;
+    SDL_EventStats.max_residency_ns = 0;
+
+    SDL_AtomicLock(&SDL_EventStats.filter_lock);
+    SDL_EventStats.filtered = 0;
+    SDL_EventStats.filter_ns = 0;
+    SDL_AtomicUnlock(&SDL_EventStats.filter_lock);
+}
+
+/* Add an event to the event queue -- called with the queue locked
+
+   'queued_ns' is when it was pushed, in SDL_GetTicksNS() time.
+ */
+static int
+SDL_AddEvent(SDL_Event * event, Uint64 queued_ns)
 {
     SDL_EventEntry *entry;
 
@@ -197,9 +504,14 @@ SDL_AddEvent(SDL_Event * event)
         return 0;
     }
 
+    if (!SDL_UpdateEventCount(event->type, 1)) {
+        return 0;
+    }
+
     if (SDL_EventQ.free == NULL) {
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
         if (!entry) {
+            SDL_UpdateEventCount(event->type, -1);
             return 0;
         }
     } else {
@@ -208,6 +520,7 @@ SDL_AddEvent(SDL_Event * event)
     }
 
     entry->event = *event;
+    entry->queued_ns = queued_ns;
     if (event->type == SDL_SYSWMEVENT) {
         entry->msg = *event->syswm.msg;
         entry->event.syswm.msg = &entry->msg;
@@ -230,14 +543,188 @@ SDL_AddEvent(SDL_Event * event)
     if (SDL_EventQ.count > SDL_EventQ.max_events_seen) {
         SDL_EventQ.max_events_seen = SDL_EventQ.count;
     }
+    SDL_CountEventStats(event->type, SDL_TRUE);
 
     return 1;
 }
 
+/* Whether an event may be merged into the queue's tail, if enabled by hints */
+static SDL_bool
+SDL_IsCoalescable(const SDL_Event * event)
+{
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        return SDL_coalesce_mouse_motion;
+    case SDL_FINGERMOTION:
+        return SDL_coalesce_finger_motion;
+    case SDL_WINDOWEVENT:
+        if (event->window.event == SDL_WINDOWEVENT_RESIZED ||
+            event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+            return SDL_coalesce_window_resize;
+        }
+        break;
+    }
+    return SDL_FALSE;
+}
+
+/* Merge an event into a matching event at the queue's tail -- called with the queue locked
+
+   Returns 1 if the event was merged, 0 if it has to be added as usual.
+ */
+static int
+SDL_CoalesceEvent(const SDL_Event * event)
+{
+    SDL_Event *tail;
+
+    if (!SDL_EventQ.tail || SDL_EventQ.tail->event.type != event->type) {
+        return 0;
+    }
+    tail = &SDL_EventQ.tail->event;
+
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        if (tail->motion.windowID != event->motion.windowID ||
+            tail->motion.which != event->motion.which) {
+            return 0;
+        }
+        tail->motion.state = event->motion.state;
+        tail->motion.x = event->motion.x;
+        tail->motion.y = event->motion.y;
+        tail->motion.xrel += event->motion.xrel;
+        tail->motion.yrel += event->motion.yrel;
+        tail->motion.timestamp_ns = event->motion.timestamp_ns;
+        break;
+    case SDL_FINGERMOTION:
+        if (tail->tfinger.touchId != event->tfinger.touchId ||
+            tail->tfinger.fingerId != event->tfinger.fingerId) {
+            return 0;
+        }
+        tail->tfinger.x = event->tfinger.x;
+        tail->tfinger.y = event->tfinger.y;
+        tail->tfinger.dx += event->tfinger.dx;
+        tail->tfinger.dy += event->tfinger.dy;
+        tail->tfinger.pressure = event->tfinger.pressure;
+        tail->tfinger.timestamp_ns = event->tfinger.timestamp_ns;
+        break;
+    case SDL_WINDOWEVENT:
+        if (tail->window.windowID != event->window.windowID ||
+            tail->window.event != event->window.event) {
+            return 0;
+        }
+        tail->window.data1 = event->window.data1;
+        tail->window.data2 = event->window.data2;
+        break;
+    default:
+        return 0;
+    }
+    tail->common.timestamp = event->common.timestamp;
+
+    ++SDL_EventQ.coalesced_events;
+    return 1;
+}
+
+/* Add an event to the ring without locking, returns SDL_FALSE if it's full */
+static SDL_bool
+SDL_PushEventRing(const SDL_Event * event)
+{
+    Uint32 pos = (Uint32) SDL_AtomicGet(&SDL_EventRing.enqueue_pos);
+    SDL_EventRingSlot *slot;
+
+    for (;;) {
+        int diff;
+
+        slot = &SDL_EventRing.slots[pos & SDL_EVENT_RING_MASK];
+        diff = (int) ((Uint32) SDL_AtomicGet(&slot->sequence) - SDL_EVENT_RING_LAP(pos));
+        if (diff == 0) {
+            /* The slot is free, try to claim it */
+            if (SDL_AtomicCAS(&SDL_EventRing.enqueue_pos, (int) pos, (int) (pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The slot still holds an event from the last lap */
+            return SDL_FALSE;
+        }
+        /* Another producer got there first */
+        pos = (Uint32) SDL_AtomicGet(&SDL_EventRing.enqueue_pos);
+    }
+
+    slot->event = *event;
+    slot->queued_ns = SDL_GetTicksNS();
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&slot->sequence, (int) (SDL_EVENT_RING_LAP(pos) + 1));
+    return SDL_TRUE;
+}
+
+/* Whether the next event in the ring has been published -- called with the queue locked */
+static SDL_bool
+SDL_EventRingHasEvents(void)
+{
+    const Uint32 pos = SDL_EventRing.dequeue_pos;
+    SDL_EventRingSlot *slot = &SDL_EventRing.slots[pos & SDL_EVENT_RING_MASK];
+
+    return ((Uint32) SDL_AtomicGet(&slot->sequence) == SDL_EVENT_RING_LAP(pos) + 1);
+}
+
+/* Move the ring's events to the end of the list -- called with the queue locked
+
+   If 'wait_for_producers' is set, slots that have been claimed but not yet
+   filled are waited for, so that the list can be appended to afterwards
+   without reordering anything.  The lock is let go while waiting, and a
+   producer that doesn't finish within SDL_EVENT_RING_MAX_WAITS yields is
+   left behind; its event may then end up after the caller's.
+ */
+static void
+SDL_DrainEventRing(SDL_bool wait_for_producers)
+{
+    int waits = 0;
+
+    while (SDL_EventQ.count < SDL_MAX_QUEUED_EVENTS) {
+        const Uint32 pos = SDL_EventRing.dequeue_pos;
+        SDL_EventRingSlot *slot = &SDL_EventRing.slots[pos & SDL_EVENT_RING_MASK];
+
+        if (!SDL_EventRingHasEvents()) {
+            if (!wait_for_producers || !SDL_EventQ.lock ||
+                waits == SDL_EVENT_RING_MAX_WAITS ||
+                pos == (Uint32) SDL_AtomicGet(&SDL_EventRing.enqueue_pos)) {
+                break;
+            }
+            /* A producer is in the middle of copying its event */
+            ++waits;
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            SDL_Delay(0);
+            SDL_LockMutex(SDL_EventQ.lock);
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (!SDL_AddEvent(&slot->event, slot->queued_ns)) {
+            break;
+        }
+        SDL_AtomicSet(&slot->sequence, (int) (SDL_EVENT_RING_LAP(pos) + SDL_EVENT_RING_SIZE));
+        SDL_EventRing.dequeue_pos = pos + 1;
+    }
+}
+
+/* Throw away everything in the ring and go back to the empty state of the
+   zeroed static array -- called with the queue locked and the loop stopped */
+static void
+SDL_ResetEventRing(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+        SDL_AtomicSet(&SDL_EventRing.slots[i].sequence, 0);
+    }
+    SDL_AtomicSet(&SDL_EventRing.enqueue_pos, 0);
+    SDL_EventRing.dequeue_pos = 0;
+}
+
 /* Remove an event from the queue -- called with the queue locked */
 static void
 SDL_CutEvent(SDL_EventEntry *entry)
 {
+    const Uint64 residency_ns = SDL_GetTicksNS() - entry->queued_ns;
+
     if (entry->prev) {
         entry->prev->next = entry->next;
     }
@@ -258,6 +745,111 @@ SDL_CutEvent(SDL_EventEntry *entry)
     SDL_EventQ.free = entry;
     SDL_assert(SDL_EventQ.count > 0);
     --SDL_EventQ.count;
+    SDL_UpdateEventCount(entry->event.type, -1);
+
+    SDL_CountEventStats(entry->event.type, SDL_FALSE);
+    SDL_EventStats.residency_ns += residency_ns;
+    if (residency_ns > SDL_EventStats.max_residency_ns) {
+        SDL_EventStats.max_residency_ns = residency_ns;
+    }
+}
+
+/* Copy matching events out of the queue -- called with the queue locked
+
+   An event matches if its type is within minType..maxType and, when 'mask'
+   isn't NULL, also has its bit set in the mask.  'types' lists the types
+   in the mask, so the walk can stop once all of them have been seen.
+ */
+static int
+SDL_TakeEvents(SDL_Event * events, int numevents, SDL_eventaction action,
+               Uint32 minType, Uint32 maxType,
+               Uint32 * const *mask, const Uint32 *types, int numtypes)
+{
+    SDL_EventEntry *entry, *next;
+    SDL_SysWMEntry *wmmsg, *wmmsg_next;
+    Uint32 type;
+    int i, matching, used = 0;
+
+    /* Clean out any used wmmsg data
+       FIXME: Do we want to retain the data for some period of time?
+     */
+    for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
+        wmmsg_next = wmmsg->next;
+        wmmsg->next = SDL_EventQ.wmmsg_free;
+        SDL_EventQ.wmmsg_free = wmmsg;
+    }
+    SDL_EventQ.wmmsg_used = NULL;
+
+    SDL_DrainEventRing(SDL_FALSE);
+
+    if (mask) {
+        matching = 0;
+        for (i = 0; i < numtypes; ++i) {
+            if (types[i] <= SDL_LASTEVENT) {
+                matching += SDL_CountQueuedEvents(types[i], types[i]);
+            }
+        }
+    } else {
+        matching = SDL_CountQueuedEvents(minType, maxType);
+    }
+
+    /* If 'events' is NULL, just see if they exist */
+    if (events == NULL) {
+        return (matching > 0) ? 1 : 0;
+    }
+
+    for (entry = SDL_EventQ.head; entry && used < numevents && used < matching; entry = next) {
+        next = entry->next;
+        type = entry->event.type;
+        if (type < minType || type > maxType) {
+            continue;
+        }
+        if (mask && (!mask[(type >> 8) & 0xff] ||
+                     !(mask[(type >> 8) & 0xff][(type & 0xff) / 32] & (1 << (type & 31))))) {
+            continue;
+        }
+
+        events[used] = entry->event;
+        if (entry->event.type == SDL_SYSWMEVENT) {
+            /* We need to copy the wmmsg somewhere safe.
+               For now we'll guarantee it's valid at least until
+               the next call to SDL_PeepEvents()
+             */
+            if (SDL_EventQ.wmmsg_free) {
+                wmmsg = SDL_EventQ.wmmsg_free;
+                SDL_EventQ.wmmsg_free = wmmsg->next;
+            } else {
+                wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
+            }
+            wmmsg->msg = *entry->event.syswm.msg;
+            wmmsg->next = SDL_EventQ.wmmsg_used;
+            SDL_EventQ.wmmsg_used = wmmsg;
+            events[used].syswm.msg = &wmmsg->msg;
+        }
+        ++used;
+
+        if (action == SDL_GETEVENT) {
+            SDL_CutEvent(entry);
+        }
+    }
+    return used;
+}
+
+/* End a wait in SDL_WaitEventTimeout() -- called with the queue locked */
+static void
+SDL_WakeupWaitingThread(void)
+{
+    if (SDL_EventQ.waiting_on_video) {
+        SDL_VideoDevice *_this = SDL_GetVideoDevice();
+
+        SDL_EventQ.waiting_on_video = SDL_FALSE;
+        if (_this && _this->SendWakeupEvent) {
+            _this->SendWakeupEvent(_this);
+        }
+    }
+    if (SDL_EventQ.wait_cond) {
+        SDL_CondBroadcast(SDL_EventQ.wait_cond);
+    }
 }
 
 /* Lock the event queue, take a peep at it, and unlock it */
@@ -275,64 +867,51 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
         }
         return (-1);
     }
-    /* Lock the event queue */
     used = 0;
-    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
-        if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
+    i = 0;
+    if (action == SDL_ADDEVENT) {
+        /* Most events can go through the ring without taking the lock */
+        for ( ; i < numevents; ++i) {
+            if (events[i].type == SDL_SYSWMEVENT || SDL_IsCoalescable(&events[i]) ||
+                !SDL_PushEventRing(&events[i])) {
+                break;
             }
-        } else {
-            SDL_EventEntry *entry, *next;
-            SDL_SysWMEntry *wmmsg, *wmmsg_next;
-            SDL_Event tmpevent;
-            Uint32 type;
-
-            /* If 'events' is NULL, just see if they exist */
-            if (events == NULL) {
-                action = SDL_PEEKEVENT;
-                numevents = 1;
-                events = &tmpevent;
+            SDL_RecordEvent(&events[i]);
+            ++used;
+        }
+        if (i == numevents) {
+            if (used > 0 && SDL_EventQ.lock &&
+                SDL_AtomicGet(&SDL_EventRing.waiters) > 0) {
+                SDL_LockMutex(SDL_EventQ.lock);
+                SDL_WakeupWaitingThread();
+                SDL_UnlockMutex(SDL_EventQ.lock);
             }
+            return (used);
+        }
+    }
 
-            /* Clean out any used wmmsg data
-               FIXME: Do we want to retain the data for some period of time?
-             */
-            for (wmmsg = SDL_EventQ.wmmsg_used; wmmsg; wmmsg = wmmsg_next) {
-                wmmsg_next = wmmsg->next;
-                wmmsg->next = SDL_EventQ.wmmsg_free;
-                SDL_EventQ.wmmsg_free = wmmsg;
-            }
-            SDL_EventQ.wmmsg_used = NULL;
-
-            for (entry = SDL_EventQ.head; entry && used < numevents; entry = next) {
-                next = entry->next;
-                type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    events[used] = entry->event;
-                    if (entry->event.type == SDL_SYSWMEVENT) {
-                        /* We need to copy the wmmsg somewhere safe.
-                           For now we'll guarantee it's valid at least until
-                           the next call to SDL_PeepEvents()
-                         */
-                        if (SDL_EventQ.wmmsg_free) {
-                            wmmsg = SDL_EventQ.wmmsg_free;
-                            SDL_EventQ.wmmsg_free = wmmsg->next;
-                        } else {
-                            wmmsg = (SDL_SysWMEntry *)SDL_malloc(sizeof(*wmmsg));
-                        }
-                        wmmsg->msg = *entry->event.syswm.msg;
-                        wmmsg->next = SDL_EventQ.wmmsg_used;
-                        SDL_EventQ.wmmsg_used = wmmsg;
-                        events[used].syswm.msg = &wmmsg->msg;
-                    }
+    /* Lock the event queue */
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        if (action == SDL_ADDEVENT) {
+            /* Keep the rest behind what's already in the ring */
+            SDL_DrainEventRing(SDL_TRUE);
+            for ( ; i < numevents; ++i) {
+                if (SDL_IsCoalescable(&events[i]) && SDL_CoalesceEvent(&events[i])) {
+                    SDL_RecordEvent(&events[i]);
                     ++used;
-
-                    if (action == SDL_GETEVENT) {
-                        SDL_CutEvent(entry);
-                    }
+                } else if (SDL_AddEvent(&events[i], SDL_GetTicksNS())) {
+                    SDL_RecordEvent(&events[i]);
+                    ++used;
+                } else {
+                    ++SDL_EventStats.dropped;
                 }
             }
+            if (used > 0) {
+                SDL_WakeupWaitingThread();
+            }
+        } else {
+            used = SDL_TakeEvents(events, numevents, action, minType, maxType,
+                                  NULL, NULL, 0);
         }
         SDL_UnlockMutex(SDL_EventQ.lock);
     } else {
@@ -341,6 +920,64 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
     return (used);
 }
 
+int
+SDL_PeepEventTypes(SDL_Event * events, int numevents, SDL_eventaction action,
+                   const Uint32 * types, int numtypes)
+{
+    Uint32 *mask[256];
+    Uint32 *bits;
+    Uint32 minType = 0xFFFFFFFF, maxType = 0;
+    int i, numblocks = 0, used;
+
+    if (!types || numtypes <= 0) {
+        return SDL_InvalidParamError("types");
+    }
+    if (action != SDL_PEEKEVENT && action != SDL_GETEVENT) {
+        return SDL_InvalidParamError("action");
+    }
+
+    /* Don't look after we've quit */
+    if (!SDL_EventQ.active) {
+        return SDL_SetError("The event system has been shut down");
+    }
+
+    /* Build a two level bitmask of the requested types, like the one used
+       for disabled events, with a block for each high byte that's used. */
+    SDL_zero(mask);
+    bits = SDL_stack_alloc(Uint32, numtypes * 8);
+    for (i = 0; i < numtypes; ++i) {
+        const Uint32 type = types[i];
+        const Uint8 hi = ((type >> 8) & 0xff);
+        const Uint8 lo = (type & 0xff);
+
+        if (type > SDL_LASTEVENT) {
+            continue;
+        }
+        if (!mask[hi]) {
+            mask[hi] = &bits[numblocks++ * 8];
+            SDL_memset(mask[hi], 0, 8 * sizeof(Uint32));
+        }
+        mask[hi][lo / 32] |= (1 << (lo & 31));
+        minType = SDL_min(minType, type);
+        maxType = SDL_max(maxType, type);
+    }
+
+    used = 0;
+    if (minType <= maxType) {
+        /* Lock the event queue */
+        if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+            used = SDL_TakeEvents(events, numevents, action, minType, maxType,
+                                  mask, types, numtypes);
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        } else {
+            used = SDL_SetError("Couldn't lock event queue");
+        }
+    }
+    SDL_stack_free(bits);
+
+    return (used);
+}
+
 SDL_bool
 SDL_HasEvent(Uint32 type)
 {
@@ -379,11 +1016,15 @@ SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     if (SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
         Uint32 type;
-        for (entry = SDL_EventQ.head; entry; entry = next) {
+        int matching;
+        SDL_DrainEventRing(SDL_FALSE);
+        matching = SDL_CountQueuedEvents(minType, maxType);
+        for (entry = SDL_EventQ.head; entry && matching > 0; entry = next) {
             next = entry->next;
             type = entry->event.type;
             if (minType <= type && type <= maxType) {
                 SDL_CutEvent(entry);
+                --matching;
             }
         }
         SDL_UnlockMutex(SDL_EventQ.lock);
@@ -408,6 +1049,11 @@ SDL_PumpEvents(void)
 #endif
 
     SDL_SendPendingQuit();  /* in case we had a signal handler fire, etc. */
+
+    SDL_PublishInputSnapshot();
+
+    SDL_RecordPumpEvents();
+    SDL_ReplayPumpEvents();
 }
 
 /* Public functions */
@@ -424,10 +1070,68 @@ SDL_WaitEvent(SDL_Event * event)
     return SDL_WaitEventTimeout(event, -1);
 }
 
+/* Whether a wait has to wake up now and then to pump something */
+static SDL_bool
+SDL_EventsNeedPolling(SDL_VideoDevice *_this)
+{
+    if (!_this || !_this->WaitEventTimeout || !_this->SendWakeupEvent) {
+        /* Nothing can wake us for the video driver or a quit signal */
+        return SDL_TRUE;
+    }
+#if !SDL_JOYSTICK_DISABLED
+    if (SDL_WasInit(SDL_INIT_JOYSTICK) &&
+        (!SDL_disabled_events[SDL_JOYAXISMOTION >> 8] || SDL_JoystickEventState(SDL_QUERY))) {
+        return SDL_TRUE;
+    }
+#endif
+    if (SDL_IsEventReplayActive()) {
+        /* Replayed events are only injected when pumping */
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+/* Block until an event may be ready or 'timeout' ms (-1 for no limit) pass */
+static void
+SDL_BlockForEvents(SDL_VideoDevice *_this, int timeout)
+{
+    if (!SDL_EventQ.lock || !SDL_EventQ.wait_cond) {
+        SDL_Delay(timeout < 0 ? SDL_WAIT_POLL_INTERVAL : timeout);
+        return;
+    }
+
+    /* Producers that skip the lock check the waiter count after publishing
+       their event, so count ourselves in before checking for events. */
+    SDL_LockMutex(SDL_EventQ.lock);
+    SDL_AtomicAdd(&SDL_EventRing.waiters, 1);
+    if (SDL_EventQ.head || SDL_EventRingHasEvents()) {
+        /* Somebody pushed an event since we looked */
+        SDL_AtomicAdd(&SDL_EventRing.waiters, -1);
+        SDL_UnlockMutex(SDL_EventQ.lock);
+        return;
+    }
+    if (_this && _this->WaitEventTimeout && _this->SendWakeupEvent) {
+        SDL_EventQ.waiting_on_video = SDL_TRUE;
+        SDL_UnlockMutex(SDL_EventQ.lock);
+
+        _this->WaitEventTimeout(_this, timeout);
+
+        SDL_LockMutex(SDL_EventQ.lock);
+        SDL_EventQ.waiting_on_video = SDL_FALSE;
+    } else {
+        SDL_CondWaitTimeout(SDL_EventQ.wait_cond, SDL_EventQ.lock,
+                            timeout < 0 ? SDL_MUTEX_MAXWAIT : (Uint32) timeout);
+    }
+    SDL_AtomicAdd(&SDL_EventRing.waiters, -1);
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
 int
 SDL_WaitEventTimeout(SDL_Event * event, int timeout)
 {
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
     Uint32 expiration = 0;
+    int wait;
 
     if (timeout > 0)
         expiration = SDL_GetTicks() + timeout;
@@ -444,29 +1148,344 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
                 /* Polling and no events, just return */
                 return 0;
             }
-            if (timeout > 0 && SDL_TICKS_PASSED(SDL_GetTicks(), expiration)) {
-                /* Timeout expired and no events */
-                return 0;
+            wait = -1;
+            if (timeout > 0) {
+                const Uint32 now = SDL_GetTicks();
+                if (SDL_TICKS_PASSED(now, expiration)) {
+                    /* Timeout expired and no events */
+                    return 0;
+                }
+                wait = (int) (expiration - now);
             }
-            SDL_Delay(10);
+            if (SDL_EventsNeedPolling(_this)) {
+                wait = (wait < 0) ? SDL_WAIT_POLL_INTERVAL : SDL_min(wait, SDL_WAIT_POLL_INTERVAL);
+            }
+            SDL_BlockForEvents(_this, wait);
             break;
         }
     }
 }
 
+void
+SDL_SetInputTimestampNS(Uint64 timestamp_ns)
+{
+    Uint64 *value;
+
+    if (!SDL_input_timestamp_tls) {
+        if (!timestamp_ns) {
+            return;
+        }
+        SDL_AtomicLock(&SDL_input_timestamp_lock);
+        if (!SDL_input_timestamp_tls) {
+            SDL_TLSID slot = SDL_TLSCreate();
+            SDL_MemoryBarrierRelease();
+            SDL_input_timestamp_tls = slot;
+        }
+        SDL_AtomicUnlock(&SDL_input_timestamp_lock);
+        if (!SDL_input_timestamp_tls) {
+            return;
+        }
+    }
+
+    SDL_MemoryBarrierAcquire();
+    value = (Uint64 *) SDL_TLSGet(SDL_input_timestamp_tls);
+    if (!value) {
+        if (!timestamp_ns) {
+            return;
+        }
+        value = (Uint64 *) SDL_malloc(sizeof(*value));
+        if (!value) {
+            return;
+        }
+        if (SDL_TLSSet(SDL_input_timestamp_tls, value, SDL_free) < 0) {
+            SDL_free(value);
+            return;
+        }
+    }
+    *value = timestamp_ns;
+}
+
+Uint64
+SDL_GetInputTimestampFromAge(Uint64 age_ns)
+{
+    const Uint64 now = SDL_GetTicksNS();
+
+    if (age_ns >= now) {
+        /* That's before we started, the clocks must not match */
+        return now;
+    }
+    return now - age_ns;
+}
+
+/* Fill in the nanosecond timestamp of input events */
+void
+SDL_StampInputEvent(SDL_Event * event)
+{
+    Uint64 *timestamp_ns;
+
+    switch (event->type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        timestamp_ns = &event->key.timestamp_ns;
+        break;
+    case SDL_MOUSEMOTION:
+        timestamp_ns = &event->motion.timestamp_ns;
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        timestamp_ns = &event->button.timestamp_ns;
+        break;
+    case SDL_MOUSEWHEEL:
+        timestamp_ns = &event->wheel.timestamp_ns;
+        break;
+    case SDL_JOYAXISMOTION:
+        timestamp_ns = &event->jaxis.timestamp_ns;
+        break;
+    case SDL_JOYBALLMOTION:
+        timestamp_ns = &event->jball.timestamp_ns;
+        break;
+    case SDL_JOYHATMOTION:
+        timestamp_ns = &event->jhat.timestamp_ns;
+        break;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        timestamp_ns = &event->jbutton.timestamp_ns;
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        timestamp_ns = &event->caxis.timestamp_ns;
+        break;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        timestamp_ns = &event->cbutton.timestamp_ns;
+        break;
+    case SDL_FINGERDOWN:
+    case SDL_FINGERUP:
+    case SDL_FINGERMOTION:
+        timestamp_ns = &event->tfinger.timestamp_ns;
+        break;
+    default:
+        return;
+    }
+
+    if (SDL_input_timestamp_tls) {
+        const Uint64 *value;
+
+        SDL_MemoryBarrierAcquire();
+        value = (const Uint64 *) SDL_TLSGet(SDL_input_timestamp_tls);
+        if (value && *value) {
+            *timestamp_ns = *value;
+            return;
+        }
+    }
+    *timestamp_ns = SDL_GetTicksNS();
+}
+
+static SDL_bool
+SDL_IsEventWatched(const SDL_EventWatcher * watcher, Uint32 type)
+{
+    int i;
+
+    if (!watcher->types) {
+        return SDL_TRUE;
+    }
+    for (i = 0; i < watcher->numtypes; ++i) {
+        if (watcher->types[i] == type) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Make a list of the watchers for 'type', or for all types if 'type' is 0 */
+static SDL_EventWatcher **
+SDL_CreateEventWatchList(Uint32 type)
+{
+    SDL_EventWatcher *curr;
+    SDL_EventWatcher **list;
+    int count = 0;
+
+    for (curr = SDL_event_watchers; curr; curr = curr->next) {
+        if (type ? SDL_IsEventWatched(curr, type) : !curr->types) {
+            ++count;
+        }
+    }
+    list = (SDL_EventWatcher **) SDL_malloc((count + 1) * sizeof(*list));
+    if (!list) {
+        return NULL;
+    }
+    count = 0;
+    for (curr = SDL_event_watchers; curr; curr = curr->next) {
+        if (type ? SDL_IsEventWatched(curr, type) : !curr->types) {
+            list[count++] = curr;
+        }
+    }
+    list[count] = NULL;
+    return list;
+}
+
+static void
+SDL_FreeEventWatchTable(SDL_EventWatchTable * table)
+{
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(table->blocks); ++i) {
+        if (table->blocks[i]) {
+            for (j = 0; j < SDL_arraysize(table->blocks[i]->watchers); ++j) {
+                SDL_free(table->blocks[i]->watchers[j]);
+            }
+            SDL_free(table->blocks[i]);
+        }
+    }
+    SDL_free(table->any);
+    SDL_free(table);
+}
+
+/* Build the dispatch table for the current watchers */
+static SDL_EventWatchTable *
+SDL_CreateEventWatchTable(void)
+{
+    SDL_EventWatchTable *table;
+    SDL_EventWatcher *curr;
+    int i;
+
+    table = (SDL_EventWatchTable *) SDL_calloc(1, sizeof(*table));
+    if (!table) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    table->any = SDL_CreateEventWatchList(0);
+    if (!table->any) {
+        SDL_free(table);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    for (curr = SDL_event_watchers; curr; curr = curr->next) {
+        ++table->count;
+        for (i = 0; i < curr->numtypes; ++i) {
+            const Uint32 type = curr->types[i];
+            const Uint8 hi = (Uint8)(type >> 8);
+            const Uint8 lo = (Uint8)(type & 0xff);
+
+            if (!table->blocks[hi]) {
+                table->blocks[hi] = (SDL_EventWatchBlock *) SDL_calloc(1, sizeof(SDL_EventWatchBlock));
+                if (!table->blocks[hi]) {
+                    SDL_FreeEventWatchTable(table);
+                    SDL_OutOfMemory();
+                    return NULL;
+                }
+            }
+            if (!table->blocks[hi]->watchers[lo]) {
+                table->blocks[hi]->watchers[lo] = SDL_CreateEventWatchList(type);
+                if (!table->blocks[hi]->watchers[lo]) {
+                    SDL_FreeEventWatchTable(table);
+                    SDL_OutOfMemory();
+                    return NULL;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+/* Free the replaced tables and removed watchers */
+static void
+SDL_FreeRetiredEventWatchers(void)
+{
+    while (SDL_event_watch_tables_retired) {
+        SDL_EventWatchTable *tmp = SDL_event_watch_tables_retired;
+        SDL_event_watch_tables_retired = tmp->retired;
+        SDL_FreeEventWatchTable(tmp);
+    }
+    while (SDL_event_watchers_removed) {
+        SDL_EventWatcher *tmp = SDL_event_watchers_removed;
+        SDL_event_watchers_removed = tmp->next;
+        SDL_free(tmp->types);
+        SDL_free(tmp);
+    }
+}
+
+/* Free what was retired if no thread is dispatching events.  A thread that
+   starts dispatching after the check loads the current table, which isn't
+   on the lists.  The caller holds SDL_event_watchers_lock. */
+static void
+SDL_ReclaimEventWatchers(void)
+{
+    if (SDL_AtomicGet(&SDL_event_watch_readers) == 0) {
+        SDL_FreeRetiredEventWatchers();
+    }
+}
+
+/* Make 'table' the current dispatch table, and retire the old one.
+   The caller holds SDL_event_watchers_lock. */
+static void
+SDL_PublishEventWatchTable(SDL_EventWatchTable * table)
+{
+    SDL_EventWatchTable *old = SDL_event_watch_table;
+
+    SDL_AtomicSetPtr((void **) &SDL_event_watch_table, table);
+    if (old) {
+        old->retired = SDL_event_watch_tables_retired;
+        SDL_event_watch_tables_retired = old;
+    }
+}
+
+static void
+SDL_CallEventWatchers(const SDL_EventWatchTable * table, SDL_Event * event)
+{
+    const SDL_EventWatchBlock *block = NULL;
+    SDL_EventWatcher **list = table->any;
+
+    /* Only types up to SDL_LASTEVENT can be watched by type */
+    if (event->type <= SDL_LASTEVENT) {
+        block = table->blocks[(event->type >> 8) & 0xff];
+    }
+    if (block && block->watchers[event->type & 0xff]) {
+        list = block->watchers[event->type & 0xff];
+    }
+    if (list) {
+        for ( ; *list; ++list) {
+            (*list)->callback((*list)->userdata, event);
+        }
+    }
+}
+
 int
 SDL_PushEvent(SDL_Event * event)
 {
-    SDL_EventWatcher *curr;
+    const SDL_EventWatchTable *watch_table;
+    SDL_bool filtered = SDL_FALSE;
+    Uint64 filter_start = 0;
 
     event->common.timestamp = SDL_GetTicks();
+    SDL_StampInputEvent(event);
+
+    /* Count this thread as a reader before loading the table, so it can't
+       be freed while the watchers are called */
+    SDL_AtomicIncRef(&SDL_event_watch_readers);
+    watch_table = (const SDL_EventWatchTable *) SDL_AtomicGetPtr((void **) &SDL_event_watch_table);
+    if (SDL_EventOK || (watch_table && watch_table->count)) {
+        filter_start = SDL_GetTicksNS();
+        filtered = (SDL_EventOK && !SDL_EventOK(SDL_EventOKParam, event));
+        if (!filtered && watch_table) {
+            SDL_CallEventWatchers(watch_table, event);
+        }
 
-    if (SDL_EventOK && !SDL_EventOK(SDL_EventOKParam, event)) {
-        return 0;
+        SDL_AtomicLock(&SDL_EventStats.filter_lock);
+        ++SDL_EventStats.filtered;
+        SDL_EventStats.filter_ns += SDL_GetTicksNS() - filter_start;
+        SDL_AtomicUnlock(&SDL_EventStats.filter_lock);
+    }
+    if (SDL_AtomicDecRef(&SDL_event_watch_readers) &&
+        SDL_AtomicGetPtr((void **) &SDL_event_watch_tables_retired)) {
+        /* The last reader out frees what was retired while it dispatched */
+        if (SDL_AtomicTryLock(&SDL_event_watchers_lock)) {
+            SDL_ReclaimEventWatchers();
+            SDL_AtomicUnlock(&SDL_event_watchers_lock);
+        }
     }
 
-    for (curr = SDL_event_watchers; curr; curr = curr->next) {
-        curr->callback(curr->userdata, event);
+    if (filtered) {
+        return 0;
     }
 
     if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
@@ -478,6 +1497,85 @@ SDL_PushEvent(SDL_Event * event)
     return 1;
 }
 
+int
+SDL_GetCoalescedEventCount(void)
+{
+    return SDL_EventQ.coalesced_events;
+}
+
+void
+SDL_GetEventQueueStats(SDL_EventQueueStats * stats)
+{
+    if (!stats) {
+        return;
+    }
+    SDL_zerop(stats);
+
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        SDL_DrainEventRing(SDL_FALSE);
+        stats->pushed = SDL_EventStats.pushed;
+        stats->popped = SDL_EventStats.popped;
+        stats->coalesced = (Uint32) SDL_EventQ.coalesced_events;
+        stats->dropped = SDL_EventStats.dropped;
+        stats->depth = SDL_EventQ.count;
+        stats->max_depth = SDL_EventQ.max_events_seen;
+        SDL_memcpy(stats->depth_histogram, SDL_EventStats.depth_histogram,
+                   sizeof(stats->depth_histogram));
+        if (SDL_EventStats.popped) {
+            stats->average_residency_ns = SDL_EventStats.residency_ns / SDL_EventStats.popped;
+        }
+        stats->max_residency_ns = SDL_EventStats.max_residency_ns;
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    }
+
+    SDL_AtomicLock(&SDL_EventStats.filter_lock);
+    stats->filtered = SDL_EventStats.filtered;
+    stats->filter_ns = SDL_EventStats.filter_ns;
+    SDL_AtomicUnlock(&SDL_EventStats.filter_lock);
+}
+
+int
+SDL_GetEventTypeStats(Uint32 type, Uint64 * pushed, Uint64 * popped)
+{
+    const SDL_EventCountBlock *block;
+
+    if (type > SDL_LASTEVENT) {
+        return SDL_InvalidParamError("type");
+    }
+
+    if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) < 0) {
+        return SDL_SetError("Couldn't lock event queue");
+    }
+    SDL_DrainEventRing(SDL_FALSE);
+    block = SDL_event_counts[(type >> 8) & 0xff];
+    if (pushed) {
+        *pushed = block ? block->pushed[type & 0xff] : 0;
+    }
+    if (popped) {
+        *popped = block ? block->popped[type & 0xff] : 0;
+    }
+    if (SDL_EventQ.lock) {
+        SDL_UnlockMutex(SDL_EventQ.lock);
+    }
+    return 0;
+}
+
+void
+SDL_ResetEventQueueStats(void)
+{
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        SDL_DrainEventRing(SDL_FALSE);
+        SDL_ResetEventStats();
+        SDL_EventQ.max_events_seen = SDL_EventQ.count;
+        SDL_EventQ.coalesced_events = 0;
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    }
+}
+
 void
 SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 {
@@ -500,24 +1598,37 @@ SDL_GetEventFilter(SDL_EventFilter * filter, void **userdata)
     return SDL_EventOK ? SDL_TRUE : SDL_FALSE;
 }
 
-/* FIXME: This is not thread-safe yet */
-void
-SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
+static int
+SDL_AddEventWatcher(SDL_EventFilter filter, void *userdata,
+                    const Uint32 * types, int numtypes)
 {
     SDL_EventWatcher *watcher, *tail;
+    SDL_EventWatchTable *table;
 
     watcher = (SDL_EventWatcher *)SDL_malloc(sizeof(*watcher));
     if (!watcher) {
-        /* Uh oh... */
-        return;
+        return SDL_OutOfMemory();
     }
 
     /* create the watcher */
     watcher->callback = filter;
     watcher->userdata = userdata;
+    watcher->types = NULL;
+    watcher->numtypes = 0;
     watcher->next = NULL;
+    if (types) {
+        watcher->types = (Uint32 *)SDL_malloc(numtypes * sizeof(*types));
+        if (!watcher->types) {
+            SDL_free(watcher);
+            return SDL_OutOfMemory();
+        }
+        SDL_memcpy(watcher->types, types, numtypes * sizeof(*types));
+        watcher->numtypes = numtypes;
+    }
 
     /* add the watcher to the end of the list */
+    SDL_AtomicLock(&SDL_event_watchers_lock);
+    tail = NULL;
     if (SDL_event_watchers) {
         for (tail = SDL_event_watchers; tail->next; tail = tail->next) {
             continue;
@@ -526,15 +1637,80 @@ SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
     } else {
         SDL_event_watchers = watcher;
     }
+
+    /* and to the dispatch table, or not at all */
+    table = SDL_CreateEventWatchTable();
+    if (!table) {
+        if (tail) {
+            tail->next = NULL;
+        } else {
+            SDL_event_watchers = NULL;
+        }
+        SDL_AtomicUnlock(&SDL_event_watchers_lock);
+        SDL_free(watcher->types);
+        SDL_free(watcher);
+        return -1;
+    }
+    SDL_PublishEventWatchTable(table);
+    SDL_ReclaimEventWatchers();
+    SDL_AtomicUnlock(&SDL_event_watchers_lock);
+    return 0;
+}
+
+void
+SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
+{
+    SDL_AddEventWatcher(filter, userdata, NULL, 0);
+}
+
+int
+SDL_AddEventWatchTypes(SDL_EventFilter filter, void *userdata,
+                       const Uint32 * types, int numtypes)
+{
+    int i;
+
+    if (!types) {
+        return SDL_InvalidParamError("types");
+    }
+    if (numtypes <= 0) {
+        return SDL_InvalidParamError("numtypes");
+    }
+    for (i = 0; i < numtypes; ++i) {
+        if (types[i] > SDL_LASTEVENT) {
+            return SDL_InvalidParamError("types");
+        }
+    }
+    return SDL_AddEventWatcher(filter, userdata, types, numtypes);
+}
+
+/* Take a watcher out of a dispatch list, which never needs more memory.
+   Another thread may be walking the list, and can see the watcher once more
+   or miss one that follows it, but never reads freed memory. */
+static void
+SDL_RemoveFromEventWatchList(SDL_EventWatcher ** list, const SDL_EventWatcher * watcher)
+{
+    SDL_EventWatcher **dst = list;
+
+    if (!list) {
+        return;
+    }
+    for ( ; *list; ++list) {
+        if (*list != watcher) {
+            *dst++ = *list;
+        }
+    }
+    *dst = NULL;
 }
 
-/* FIXME: This is not thread-safe yet */
 void
 SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
 {
     SDL_EventWatcher *prev = NULL;
     SDL_EventWatcher *curr;
+    SDL_EventWatchTable *table;
+    int i, j;
 
+    SDL_AtomicLock(&SDL_event_watchers_lock);
     for (curr = SDL_event_watchers; curr; prev = curr, curr = curr->next) {
         if (curr->callback == filter && curr->userdata == userdata) {
             if (prev) {
@@ -542,10 +1718,32 @@ SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
             } else {
                 SDL_event_watchers = curr->next;
             }
-            SDL_free(curr);
+
+            table = SDL_CreateEventWatchTable();
+            if (table) {
+                SDL_PublishEventWatchTable(table);
+            } else if (SDL_event_watch_table) {
+                /* Out of memory, so remove it from the current table instead */
+                table = SDL_event_watch_table;
+                SDL_RemoveFromEventWatchList(table->any, curr);
+                for (i = 0; i < SDL_arraysize(table->blocks); ++i) {
+                    SDL_EventWatchBlock *block = table->blocks[i];
+                    if (block) {
+                        for (j = 0; j < SDL_arraysize(block->watchers); ++j) {
+                            SDL_RemoveFromEventWatchList(block->watchers[j], curr);
+                        }
+                    }
+                }
+            }
+
+            /* a callback may still be running on another thread */
+            curr->next = SDL_event_watchers_removed;
+            SDL_event_watchers_removed = curr;
+            SDL_ReclaimEventWatchers();
             break;
         }
     }
+    SDL_AtomicUnlock(&SDL_event_watchers_lock);
 }
 
 void
@@ -553,6 +1751,7 @@ SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
     if (SDL_EventQ.lock && SDL_LockMutex(SDL_EventQ.lock) == 0) {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing(SDL_FALSE);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
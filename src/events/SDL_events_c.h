@@ -46,6 +46,26 @@ extern void SDL_QuitQuit(void);
 
 extern void SDL_SendPendingQuit(void);
 
+/* Say when the input about to be sent from this thread happened, in
+   SDL_GetTicksNS() time, or 0 to have input events stamped when pushed. */
+extern void SDL_SetInputTimestampNS(Uint64 timestamp_ns);
+
+/* Turn the age of some input, as measured against the device's clock,
+   into SDL_GetTicksNS() time */
+extern Uint64 SDL_GetInputTimestampFromAge(Uint64 age_ns);
+
+/* Fill in the nanosecond timestamp of an input event */
+extern void SDL_StampInputEvent(SDL_Event * event);
+
+/* Event recording and replay, from SDL_eventrecord.c */
+extern void SDL_RecordEvent(const SDL_Event * event);
+extern void SDL_RecordPumpEvents(void);
+extern void SDL_ReplayPumpEvents(void);
+extern void SDL_QuitEventRecording(void);
+
+/* Make the current input state what SDL_GetInputSnapshot() returns */
+extern void SDL_PublishInputSnapshot(void);
+
 /* The event filter function */
 extern SDL_EventFilter SDL_EventOK;
 extern void *SDL_EventOKParam;
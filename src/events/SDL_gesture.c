@@ -39,9 +39,11 @@
 #define DOLLARNPOINTS 64
 #define DOLLARSIZE 256
 
-#define ENABLE_DOLLAR
+/* Points in the outline used to rule templates out before matching all of
+   their points, every DOLLARNPOINTS/DOLLARNCOARSE'th one */
+#define DOLLARNCOARSE 8
 
-#define PHI 0.618033989
+#define ENABLE_DOLLAR
 
 typedef struct {
     float x,y;
@@ -54,8 +56,15 @@ typedef struct {
     SDL_FloatPoint p[MAXPATHSIZE];
 } SDL_DollarPath;
 
+/* The coordinates are kept apart, so matching runs through each of them
+   in order and the compiler can vectorize it */
 typedef struct {
-    SDL_FloatPoint path[DOLLARNPOINTS];
+    float x[DOLLARNPOINTS];
+    float y[DOLLARNPOINTS];
+    float coarseX[DOLLARNCOARSE];
+    float coarseY[DOLLARNCOARSE];
+    float length;           /* of all the coordinates as one vector */
+    float coarseLength;
     unsigned long hash;
 } SDL_DollarTemplate;
 
@@ -66,6 +75,7 @@ typedef struct {
     Uint16 numDownFingers;
 
     int numDollarTemplates;
+    int maxDollarTemplates;
     SDL_DollarTemplate *dollarTemplate;
 
     SDL_bool recording;
@@ -115,6 +125,9 @@ static unsigned long SDL_HashDollar(SDL_FloatPoint* points)
 
 static int SaveTemplate(SDL_DollarTemplate *templ, SDL_RWops *dst)
 {
+    SDL_FloatPoint path[DOLLARNPOINTS];
+    int i;
+
     if (dst == NULL) {
         return 0;
     }
@@ -122,27 +135,15 @@ static int SaveTemplate(SDL_DollarTemplate *templ, SDL_RWops *dst)
     /* No Longer storing the Hash, rehash on load */
     /* if (SDL_RWops.write(dst, &(templ->hash), sizeof(templ->hash), 1) != 1) return 0; */
 
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-    if (SDL_RWwrite(dst, templ->path,
-                    sizeof(templ->path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
-        return 0;
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        path[i].x = SDL_SwapFloatLE(templ->x[i]);
+        path[i].y = SDL_SwapFloatLE(templ->y[i]);
     }
-#else
-    {
-        SDL_DollarTemplate copy = *templ;
-        SDL_FloatPoint *p = copy.path;
-        int i;
-        for (i = 0; i < DOLLARNPOINTS; i++, p++) {
-            p->x = SDL_SwapFloatLE(p->x);
-            p->y = SDL_SwapFloatLE(p->y);
-        }
 
-        if (SDL_RWwrite(dst, copy.path,
-                        sizeof(copy.path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
-            return 0;
-        }
+    if (SDL_RWwrite(dst, path,
+                    sizeof(path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
+        return 0;
     }
-#endif
 
     return 1;
 }
@@ -180,21 +181,39 @@ static int SDL_AddDollarGesture_one(SDL_GestureTouch* inTouch, SDL_FloatPoint* p
 {
     SDL_DollarTemplate* dollarTemplate;
     SDL_DollarTemplate *templ;
+    float length = 0, coarseLength = 0;
     int index;
+    int i;
 
     index = inTouch->numDollarTemplates;
-    dollarTemplate =
-        (SDL_DollarTemplate *)SDL_realloc(inTouch->dollarTemplate,
-                                          (index + 1) *
-                                          sizeof(SDL_DollarTemplate));
-    if (!dollarTemplate) {
-        return SDL_OutOfMemory();
+    if (index == inTouch->maxDollarTemplates) {
+        int maxDollarTemplates = index ? index * 2 : 16;
+        dollarTemplate =
+            (SDL_DollarTemplate *)SDL_realloc(inTouch->dollarTemplate,
+                                              maxDollarTemplates *
+                                              sizeof(SDL_DollarTemplate));
+        if (!dollarTemplate) {
+            return SDL_OutOfMemory();
+        }
+        inTouch->dollarTemplate = dollarTemplate;
+        inTouch->maxDollarTemplates = maxDollarTemplates;
     }
-    inTouch->dollarTemplate = dollarTemplate;
 
     templ = &inTouch->dollarTemplate[index];
-    SDL_memcpy(templ->path, path, DOLLARNPOINTS*sizeof(SDL_FloatPoint));
-    templ->hash = SDL_HashDollar(templ->path);
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        templ->x[i] = path[i].x;
+        templ->y[i] = path[i].y;
+        length += path[i].x*path[i].x + path[i].y*path[i].y;
+    }
+    for (i = 0; i < DOLLARNCOARSE; i++) {
+        templ->coarseX[i] = templ->x[i*(DOLLARNPOINTS/DOLLARNCOARSE)];
+        templ->coarseY[i] = templ->y[i*(DOLLARNPOINTS/DOLLARNCOARSE)];
+        coarseLength += templ->coarseX[i]*templ->coarseX[i] +
+                        templ->coarseY[i]*templ->coarseY[i];
+    }
+    templ->length = (float)SDL_sqrt(length);
+    templ->coarseLength = (float)SDL_sqrt(coarseLength);
+    templ->hash = SDL_HashDollar(path);
     inTouch->numDollarTemplates++;
 
     return index;
@@ -235,9 +254,9 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
     }
 
     while (1) {
-        SDL_DollarTemplate templ;
+        SDL_FloatPoint path[DOLLARNPOINTS];
 
-        if (SDL_RWread(src,templ.path,sizeof(templ.path[0]),DOLLARNPOINTS) < DOLLARNPOINTS) {
+        if (SDL_RWread(src,path,sizeof(path[0]),DOLLARNPOINTS) < DOLLARNPOINTS) {
             if (loaded == 0) {
                 return SDL_SetError("could not read any dollar gesture from rwops");
             }
@@ -246,7 +265,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 
 #if SDL_BYTEORDER != SDL_LIL_ENDIAN
         for (i = 0; i < DOLLARNPOINTS; i++) {
-            SDL_FloatPoint *p = &templ.path[i];
+            SDL_FloatPoint *p = &path[i];
             p->x = SDL_SwapFloatLE(p->x);
             p->y = SDL_SwapFloatLE(p->y);
         }
@@ -254,7 +273,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 
         if (touchId >= 0) {
             /* printf("Adding loaded gesture to 1 touch\n"); */
-            if (SDL_AddDollarGesture(touch, templ.path) >= 0)
+            if (SDL_AddDollarGesture(touch, path) >= 0)
                 loaded++;
         }
         else {
@@ -263,7 +282,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
                 touch = &SDL_gestureTouch[i];
                 /* printf("Adding loaded gesture to + touches\n"); */
                 /* TODO: What if this fails? */
-                SDL_AddDollarGesture(touch,templ.path);
+                SDL_AddDollarGesture(touch,path);
             }
             loaded++;
         }
@@ -273,58 +292,40 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 }
 
 
-static float dollarDifference(SDL_FloatPoint* points,SDL_FloatPoint* templ,float ang)
+/* The average distance between the points, once they're rotated by 'ang' */
+static float dollarDifference(const float *x,const float *y,const SDL_DollarTemplate *templ,float ang)
 {
-    /*  SDL_FloatPoint p[DOLLARNPOINTS]; */
+    const float c = (float)SDL_cos(ang);
+    const float s = (float)SDL_sin(ang);
     float dist = 0;
-    SDL_FloatPoint p;
     int i;
     for (i = 0; i < DOLLARNPOINTS; i++) {
-        p.x = (float)(points[i].x * SDL_cos(ang) - points[i].y * SDL_sin(ang));
-        p.y = (float)(points[i].x * SDL_sin(ang) + points[i].y * SDL_cos(ang));
-        dist += (float)(SDL_sqrt((p.x-templ[i].x)*(p.x-templ[i].x)+
-                                 (p.y-templ[i].y)*(p.y-templ[i].y)));
+        float dx = x[i]*c - y[i]*s - templ->x[i];
+        float dy = x[i]*s + y[i]*c - templ->y[i];
+        dist += (float)SDL_sqrt(dx*dx + dy*dy);
     }
     return dist/DOLLARNPOINTS;
-
 }
 
-static float bestDollarDifference(SDL_FloatPoint* points,SDL_FloatPoint* templ)
+/* Sum the dot products 'a' and cross products 'b' of the points, such that
+   rotating the first set by 'ang' changes the sum of the squared distances
+   between them by -2*(a*cos(ang) + b*sin(ang)).  There are four partial
+   sums, so the loop vectorizes without reordering floating point math. */
+static void dollarProducts(const float *x,const float *y,
+                           const float *tx,const float *ty,int n,
+                           float *a,float *b)
 {
-    /*------------BEGIN DOLLAR BLACKBOX------------------
-      -TRANSLATED DIRECTLY FROM PSUDEO-CODE AVAILABLE AT-
-      -"http://depts.washington.edu/aimgroup/proj/dollar/"
-    */
-    double ta = -M_PI/4;
-    double tb = M_PI/4;
-    double dt = M_PI/90;
-    float x1 = (float)(PHI*ta + (1-PHI)*tb);
-    float f1 = dollarDifference(points,templ,x1);
-    float x2 = (float)((1-PHI)*ta + PHI*tb);
-    float f2 = dollarDifference(points,templ,x2);
-    while (SDL_fabs(ta-tb) > dt) {
-        if (f1 < f2) {
-            tb = x2;
-            x2 = x1;
-            f2 = f1;
-            x1 = (float)(PHI*ta + (1-PHI)*tb);
-            f1 = dollarDifference(points,templ,x1);
-        }
-        else {
-            ta = x1;
-            x1 = x2;
-            f1 = f2;
-            x2 = (float)((1-PHI)*ta + PHI*tb);
-            f2 = dollarDifference(points,templ,x2);
+    float as[4] = { 0, 0, 0, 0 };
+    float bs[4] = { 0, 0, 0, 0 };
+    int i, j;
+    for (i = 0; i < n; i += 4) {
+        for (j = 0; j < 4; j++) {
+            as[j] += tx[i+j]*x[i+j] + ty[i+j]*y[i+j];
+            bs[j] += ty[i+j]*x[i+j] - tx[i+j]*y[i+j];
         }
     }
-    /*
-      if (f1 <= f2)
-          printf("Min angle (x1): %f\n",x1);
-      else if (f1 >  f2)
-          printf("Min angle (x2): %f\n",x2);
-    */
-    return SDL_min(f1,f2);
+    *a = (as[0] + as[1]) + (as[2] + as[3]);
+    *b = (bs[0] + bs[1]) + (bs[2] + bs[3]);
 }
 
 /* DollarPath contains raw points, plus (possibly) the calculated length */
@@ -420,23 +421,67 @@ static int dollarNormalize(const SDL_DollarPath *path,SDL_FloatPoint *points)
     return numPoints;
 }
 
+/* Match the path against each template at the rotation within 45 degrees
+   either way that brings them closest, which is found in closed form, as in
+   the Protractor recognizer.  No rotation changes the length of the points
+   as a vector, nor brings all of the points closer than it can bring the
+   coarse outline, so most templates are ruled out before the full match. */
 static float dollarRecognize(const SDL_DollarPath *path,int *bestTempl,SDL_GestureTouch* touch)
 {
     SDL_FloatPoint points[DOLLARNPOINTS];
+    float x[DOLLARNPOINTS], y[DOLLARNPOINTS];
+    float coarseX[DOLLARNCOARSE], coarseY[DOLLARNCOARSE];
+    float lengthSq = 0, coarseLengthSq = 0, length;
+    float bestDist = 1e30f, bestAng = 0;
     int i;
-    float bestDiff = 10000;
 
     SDL_memset(points, 0, sizeof(points));
 
     dollarNormalize(path,points);
 
     /* PrintPath(points); */
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        lengthSq += x[i]*x[i] + y[i]*y[i];
+    }
+    for (i = 0; i < DOLLARNCOARSE; i++) {
+        coarseX[i] = x[i*(DOLLARNPOINTS/DOLLARNCOARSE)];
+        coarseY[i] = y[i*(DOLLARNPOINTS/DOLLARNCOARSE)];
+        coarseLengthSq += coarseX[i]*coarseX[i] + coarseY[i]*coarseY[i];
+    }
+    length = (float)SDL_sqrt(lengthSq);
+
     *bestTempl = -1;
     for (i = 0; i < touch->numDollarTemplates; i++) {
-        float diff = bestDollarDifference(points,touch->dollarTemplate[i].path);
-        if (diff < bestDiff) {bestDiff = diff; *bestTempl = i;}
+        const SDL_DollarTemplate *templ = &touch->dollarTemplate[i];
+        float a, b, ang, dist;
+
+        dist = length - templ->length;
+        if (dist*dist >= bestDist) continue;
+
+        dollarProducts(coarseX,coarseY,templ->coarseX,templ->coarseY,
+                       DOLLARNCOARSE,&a,&b);
+        dist = coarseLengthSq + templ->coarseLength*templ->coarseLength -
+               2*(float)SDL_sqrt(a*a + b*b);
+        if (dist >= bestDist) continue;
+
+        dollarProducts(x,y,templ->x,templ->y,DOLLARNPOINTS,&a,&b);
+        ang = (float)SDL_atan2(b,a);
+        if (ang < -M_PI/4) ang = (float)(-M_PI/4);
+        if (ang > M_PI/4) ang = (float)(M_PI/4);
+        dist = lengthSq + templ->length*templ->length -
+               2*(a*(float)SDL_cos(ang) + b*(float)SDL_sin(ang));
+        if (dist < bestDist) {
+            bestDist = dist;
+            bestAng = ang;
+            *bestTempl = i;
+        }
+    }
+    if (*bestTempl < 0) {
+        return 10000;
     }
-    return bestDiff;
+    return dollarDifference(x,y,&touch->dollarTemplate[*bestTempl],bestAng);
 }
 
 int SDL_GestureAddTouch(SDL_TouchID touchId)
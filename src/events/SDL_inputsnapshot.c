@@ -0,0 +1,99 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Snapshots of the keyboard, mouse and touch state for polling */
+
+#include "SDL_atomic.h"
+#include "SDL_events.h"
+#include "SDL_timer.h"
+#include "SDL_events_c.h"
+
+/* The state is double buffered.  The thread pumping events fills in the back
+   buffer, then makes it the front one by bumping the version.  Readers copy
+   the front buffer and start over if the version changed meanwhile, since
+   the buffer they were copying may have become the back one and been
+   written to.
+ */
+static struct
+{
+    SDL_InputSnapshot buffers[2];
+    SDL_atomic_t version;           /* buffers[version & 1] is the front one */
+    SDL_SpinLock lock;              /* held while filling in the back buffer */
+} SDL_input_snapshot;
+
+void
+SDL_PublishInputSnapshot(void)
+{
+    SDL_InputSnapshot *front, *back;
+    int version;
+
+    /* If another thread is pumping events, it's got this covered */
+    if (!SDL_AtomicTryLock(&SDL_input_snapshot.lock)) {
+        return;
+    }
+
+    version = SDL_AtomicGet(&SDL_input_snapshot.version);
+    front = &SDL_input_snapshot.buffers[version & 1];
+    back = &SDL_input_snapshot.buffers[(version + 1) & 1];
+
+    SDL_zerop(back);
+    SDL_GetKeyboardSnapshot(back);
+    SDL_GetMouseSnapshot(back);
+    SDL_GetTouchSnapshot(back);
+
+    /* Only publish changes, so the sequence number says when there are some */
+    back->sequence = front->sequence;
+    back->timestamp_ns = front->timestamp_ns;
+    if (front->sequence == 0 || SDL_memcmp(back, front, sizeof(*back)) != 0) {
+        back->sequence = front->sequence + 1;
+        if (back->sequence == 0) {
+            back->sequence = 1;
+        }
+        back->timestamp_ns = SDL_GetTicksNS();
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&SDL_input_snapshot.version, version + 1);
+    }
+
+    SDL_AtomicUnlock(&SDL_input_snapshot.lock);
+}
+
+Uint32
+SDL_GetInputSnapshot(SDL_InputSnapshot * snapshot)
+{
+    int version;
+
+    if (!snapshot) {
+        SDL_InvalidParamError("snapshot");
+        return 0;
+    }
+
+    do {
+        version = SDL_AtomicGet(&SDL_input_snapshot.version);
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(snapshot, &SDL_input_snapshot.buffers[version & 1], sizeof(*snapshot));
+        SDL_MemoryBarrierAcquire();
+    } while (SDL_AtomicGet(&SDL_input_snapshot.version) != version);
+
+    return snapshot->sequence;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
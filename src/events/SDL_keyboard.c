@@ -829,6 +829,16 @@ SDL_GetKeyboardState(int *numkeys)
     return keyboard->keystate;
 }
 
+void
+SDL_GetKeyboardSnapshot(SDL_InputSnapshot * snapshot)
+{
+    SDL_Keyboard *keyboard = &SDL_keyboard;
+
+    snapshot->keyboard_focus = keyboard->focus ? keyboard->focus->id : 0;
+    snapshot->modstate = keyboard->modstate;
+    SDL_memcpy(snapshot->keystate, keyboard->keystate, sizeof(snapshot->keystate));
+}
+
 SDL_Keymod
 SDL_GetModState(void)
 {
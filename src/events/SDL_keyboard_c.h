@@ -65,6 +65,9 @@ extern char *SDL_UCS4ToUTF8(Uint32 ch, char *dst);
 /* Toggle on or off pieces of the keyboard mod state. */
 extern void SDL_ToggleModState(const SDL_Keymod modstate, const SDL_bool toggle);
 
+/* Copy the keyboard state into an input snapshot */
+extern void SDL_GetKeyboardSnapshot(SDL_InputSnapshot * snapshot);
+
 #endif /* _SDL_keyboard_c_h */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -461,6 +461,17 @@ SDL_MouseQuit(void)
     SDL_zerop(mouse);
 }
 
+void
+SDL_GetMouseSnapshot(SDL_InputSnapshot * snapshot)
+{
+    SDL_Mouse *mouse = SDL_GetMouse();
+
+    snapshot->mouse_focus = mouse->focus ? mouse->focus->id : 0;
+    snapshot->mouse_x = mouse->x;
+    snapshot->mouse_y = mouse->y;
+    snapshot->mouse_buttons = mouse->buttonstate;
+}
+
 Uint32
 SDL_GetMouseState(int *x, int *y)
 {
@@ -24,6 +24,7 @@
 #define _SDL_mouse_c_h
 
 #include "SDL_mouse.h"
+#include "SDL_events.h"
 
 typedef Uint32 SDL_MouseID;
 
@@ -122,6 +123,9 @@ extern int SDL_SendMouseButton(SDL_Window * window, SDL_MouseID mouseID, Uint8 s
 /* Send a mouse wheel event */
 extern int SDL_SendMouseWheel(SDL_Window * window, SDL_MouseID mouseID, int x, int y, SDL_MouseWheelDirection direction);
 
+/* Copy the mouse state into an input snapshot */
+extern void SDL_GetMouseSnapshot(SDL_InputSnapshot * snapshot);
+
 /* Shutdown the mouse subsystem */
 extern void SDL_MouseQuit(void);
 
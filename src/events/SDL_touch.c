@@ -348,6 +348,31 @@ SDL_DelTouch(SDL_TouchID id)
     SDL_touchDevices[index] = SDL_touchDevices[SDL_num_touch];
 }
 
+void
+SDL_GetTouchSnapshot(SDL_InputSnapshot * snapshot)
+{
+    int i, j;
+
+    snapshot->num_fingers = 0;
+    for (i = 0; i < SDL_num_touch; ++i) {
+        SDL_Touch *touch = SDL_touchDevices[i];
+
+        for (j = 0; j < touch->num_fingers; ++j) {
+            SDL_InputSnapshotFinger *finger;
+
+            if (snapshot->num_fingers == SDL_arraysize(snapshot->fingers)) {
+                return;
+            }
+            finger = &snapshot->fingers[snapshot->num_fingers++];
+            finger->touchId = touch->id;
+            finger->fingerId = touch->fingers[j]->id;
+            finger->x = touch->fingers[j]->x;
+            finger->y = touch->fingers[j]->y;
+            finger->pressure = touch->fingers[j]->pressure;
+        }
+    }
+}
+
 void
 SDL_TouchQuit(void)
 {
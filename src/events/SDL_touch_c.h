@@ -20,6 +20,7 @@
 */
 #include "../SDL_internal.h"
 #include "../../include/SDL_touch.h"
+#include "../../include/SDL_events.h"
 
 #ifndef _SDL_touch_c_h
 #define _SDL_touch_c_h
@@ -56,6 +57,9 @@ extern void SDL_DelTouch(SDL_TouchID id);
 /* Shutdown the touch subsystem */
 extern void SDL_TouchQuit(void);
 
+/* Copy the fingers that are down into an input snapshot */
+extern void SDL_GetTouchSnapshot(SDL_InputSnapshot * snapshot);
+
 #endif /* _SDL_touch_c_h */
 
 /* vi: set ts=4 sw=4 expandtab: */
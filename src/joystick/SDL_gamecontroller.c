@@ -105,6 +105,16 @@ struct _SDL_GameController
 int SDL_PrivateGameControllerAxis(SDL_GameController * gamecontroller, SDL_GameControllerAxis axis, Sint16 value);
 int SDL_PrivateGameControllerButton(SDL_GameController * gamecontroller, SDL_GameControllerButton button, Uint8 state);
 
+/* The joystick events SDL_GameControllerEventWatcher() turns into controller events */
+static const Uint32 SDL_gamecontroller_event_types[] = {
+    SDL_JOYAXISMOTION,
+    SDL_JOYBUTTONDOWN,
+    SDL_JOYBUTTONUP,
+    SDL_JOYHATMOTION,
+    SDL_JOYDEVICEADDED,
+    SDL_JOYDEVICEREMOVED
+};
+
 /*
  * Event filter to fire controller events from joystick ones
  */
@@ -874,7 +884,9 @@ SDL_GameControllerInit(void)
     SDL_GameControllerLoadHints();
 
     /* watch for joy events and fire controller ones if needed */
-    SDL_AddEventWatch(SDL_GameControllerEventWatcher, NULL);
+    SDL_AddEventWatchTypes(SDL_GameControllerEventWatcher, NULL,
+                           SDL_gamecontroller_event_types,
+                           SDL_arraysize(SDL_gamecontroller_event_types));
 
     /* Send added events for controllers currently attached */
     for (i = 0; i < SDL_NumJoysticks(); ++i) {
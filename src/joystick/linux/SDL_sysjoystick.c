@@ -34,6 +34,7 @@
 #include <sys/ioctl.h>
 #include <limits.h>             /* For the definition of PATH_MAX */
 #include <linux/joystick.h>
+#include <time.h>
 
 #include "SDL_assert.h"
 #include "SDL_joystick.h"
@@ -52,6 +53,12 @@
 #define SYN_DROPPED 3
 #endif
 
+/* Nor are these */
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
 #include "../../core/linux/SDL_udev.h"
 
 static int MaybeAddDevice(const char *path);
@@ -612,6 +619,14 @@ SDL_SYS_JoystickOpen(SDL_Joystick * joystick, int device_index)
     /* Set the joystick to non-blocking read mode */
     fcntl(fd, F_SETFL, O_NONBLOCK);
 
+#ifdef EVIOCSCLOCKID
+    {
+        /* Get event times that don't jump with the wall clock */
+        int clock_id = CLOCK_MONOTONIC;
+        joystick->hwdata->monotonic_time = (ioctl(fd, EVIOCSCLOCKID, &clock_id) == 0);
+    }
+#endif
+
     /* Get the number of buttons and axes on the joystick */
     ConfigJoystick(joystick, fd);
 
@@ -740,8 +755,24 @@ HandleInputEvents(SDL_Joystick * joystick)
     }
 
     while ((len = read(joystick->hwdata->fd, events, (sizeof events))) > 0) {
+        struct timespec now;
+        Uint64 now_ns = 0;
+
+        if (clock_gettime(joystick->hwdata->monotonic_time ? CLOCK_MONOTONIC : CLOCK_REALTIME, &now) == 0) {
+            now_ns = (Uint64) now.tv_sec * 1000000000 + now.tv_nsec;
+        }
+
         len /= sizeof(events[0]);
         for (i = 0; i < len; ++i) {
+#if !SDL_EVENTS_DISABLED
+            /* Pass along when the kernel saw the event */
+            const Uint64 event_ns = (Uint64) events[i].input_event_sec * 1000000000 +
+                                    (Uint64) events[i].input_event_usec * 1000;
+            if (now_ns && event_ns <= now_ns) {
+                SDL_SetInputTimestampNS(SDL_GetInputTimestampFromAge(now_ns - event_ns));
+            }
+#endif
+
             code = events[i].code;
             switch (events[i].type) {
             case EV_KEY:
@@ -801,6 +832,10 @@ HandleInputEvents(SDL_Joystick * joystick)
             }
         }
     }
+
+#if !SDL_EVENTS_DISABLED
+    SDL_SetInputTimestampNS(0);
+#endif
 }
 
 void
@@ -52,6 +52,7 @@ struct joystick_hwdata
     } abs_correct[ABS_MAX];
 
     int fresh;
+    SDL_bool monotonic_time;    /* events are stamped with CLOCK_MONOTONIC */
 };
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,303 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_rectpack.h"
+
+/* This is a MaxRects packer, after "A Thousand Ways to Pack the Bin" by
+   Jukka Jylanki.  The free area is kept as a list of maximal rectangles,
+   which may overlap, and a new rectangle goes where it leaves the shortest
+   leftover side.  Freed rectangles are merged with the free area around
+   them, and the whole area starts over once nothing is left in it.
+ */
+
+struct SDL_RectPacker
+{
+    int w, h;
+    int num_used;
+
+    SDL_Rect *free_rects;
+    int num_free;
+    int max_free;
+};
+
+static int
+AddFreeRect(SDL_RectPacker * packer, const SDL_Rect * rect)
+{
+    if (packer->num_free == packer->max_free) {
+        int max_free = SDL_max(packer->max_free * 2, 16);
+        SDL_Rect *free_rects = (SDL_Rect *) SDL_realloc(packer->free_rects, max_free * sizeof(*free_rects));
+        if (!free_rects) {
+            return SDL_OutOfMemory();
+        }
+        packer->free_rects = free_rects;
+        packer->max_free = max_free;
+    }
+    packer->free_rects[packer->num_free++] = *rect;
+    return 0;
+}
+
+static void
+ResetFreeRects(SDL_RectPacker * packer)
+{
+    SDL_Rect rect;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = packer->w;
+    rect.h = packer->h;
+    packer->num_free = 0;
+    AddFreeRect(packer, &rect);
+}
+
+static SDL_bool
+ContainsRect(const SDL_Rect * a, const SDL_Rect * b)
+{
+    return (b->x >= a->x && b->y >= a->y &&
+            b->x + b->w <= a->x + a->w &&
+            b->y + b->h <= a->y + a->h);
+}
+
+/* Drop free rectangles that lie entirely within another one */
+static void
+PruneFreeRects(SDL_RectPacker * packer)
+{
+    int i, j;
+
+    for (i = 0; i < packer->num_free; ++i) {
+        for (j = i + 1; j < packer->num_free; ++j) {
+            if (ContainsRect(&packer->free_rects[j], &packer->free_rects[i])) {
+                packer->free_rects[i--] = packer->free_rects[--packer->num_free];
+                break;
+            }
+            if (ContainsRect(&packer->free_rects[i], &packer->free_rects[j])) {
+                packer->free_rects[j--] = packer->free_rects[--packer->num_free];
+            }
+        }
+    }
+}
+
+/* Add the rectangle spanning two free rectangles that touch or overlap, side
+   by side or one above the other, if it isn't already free.  It's made of
+   free area only, since it covers just the rows or columns they share. */
+static int
+AddMergedFreeRect(SDL_RectPacker * packer, const SDL_Rect * a, const SDL_Rect * b,
+                  SDL_bool vertical)
+{
+    SDL_Rect rect;
+    int i;
+
+    if (vertical) {
+        if (a->y > b->y + b->h || b->y > a->y + a->h) {
+            return 0;
+        }
+        rect.y = SDL_min(a->y, b->y);
+        rect.h = SDL_max(a->y + a->h, b->y + b->h) - rect.y;
+        rect.x = SDL_max(a->x, b->x);
+        rect.w = SDL_min(a->x + a->w, b->x + b->w) - rect.x;
+    } else {
+        if (a->x > b->x + b->w || b->x > a->x + a->w) {
+            return 0;
+        }
+        rect.x = SDL_min(a->x, b->x);
+        rect.w = SDL_max(a->x + a->w, b->x + b->w) - rect.x;
+        rect.y = SDL_max(a->y, b->y);
+        rect.h = SDL_min(a->y + a->h, b->y + b->h) - rect.y;
+    }
+    if (rect.w <= 0 || rect.h <= 0) {
+        return 0;
+    }
+    for (i = 0; i < packer->num_free; ++i) {
+        if (ContainsRect(&packer->free_rects[i], &rect)) {
+            return 0;
+        }
+    }
+    return AddFreeRect(packer, &rect);
+}
+
+/* Add a freed rectangle, and the bigger free rectangles it makes with the
+   free area around it */
+static void
+MergeFreeRect(SDL_RectPacker * packer, const SDL_Rect * freed)
+{
+    int next, i;
+
+    next = packer->num_free;
+    if (AddFreeRect(packer, freed) < 0) {
+        return;
+    }
+
+    /* Each rectangle added is merged with the others in turn, until no new
+       ones come up.  There are only so many edges, so this ends. */
+    for ( ; next < packer->num_free; ++next) {
+        for (i = 0; i < packer->num_free; ++i) {
+            const SDL_Rect a = packer->free_rects[next];
+            const SDL_Rect b = packer->free_rects[i];
+
+            if (i == next) {
+                continue;
+            }
+            if (AddMergedFreeRect(packer, &a, &b, SDL_FALSE) < 0 ||
+                AddMergedFreeRect(packer, &a, &b, SDL_TRUE) < 0) {
+                return;
+            }
+        }
+    }
+}
+
+/* Add the parts of a free rectangle around 'used', the caller removes it */
+static int
+SplitFreeRect(SDL_RectPacker * packer, int index, const SDL_Rect * used)
+{
+    const SDL_Rect free_rect = packer->free_rects[index];
+    SDL_Rect rect;
+
+    if (used->x > free_rect.x) {
+        rect = free_rect;
+        rect.w = used->x - free_rect.x;
+        if (AddFreeRect(packer, &rect) < 0) {
+            return -1;
+        }
+    }
+    if (used->x + used->w < free_rect.x + free_rect.w) {
+        rect = free_rect;
+        rect.x = used->x + used->w;
+        rect.w = (free_rect.x + free_rect.w) - rect.x;
+        if (AddFreeRect(packer, &rect) < 0) {
+            return -1;
+        }
+    }
+    if (used->y > free_rect.y) {
+        rect = free_rect;
+        rect.h = used->y - free_rect.y;
+        if (AddFreeRect(packer, &rect) < 0) {
+            return -1;
+        }
+    }
+    if (used->y + used->h < free_rect.y + free_rect.h) {
+        rect = free_rect;
+        rect.y = used->y + used->h;
+        rect.h = (free_rect.y + free_rect.h) - rect.y;
+        if (AddFreeRect(packer, &rect) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+SDL_RectPacker *
+SDL_CreateRectPacker(int w, int h)
+{
+    SDL_RectPacker *packer;
+
+    packer = (SDL_RectPacker *) SDL_calloc(1, sizeof(*packer));
+    if (!packer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    packer->w = w;
+    packer->h = h;
+
+    ResetFreeRects(packer);
+    if (packer->num_free == 0) {
+        SDL_DestroyRectPacker(packer);
+        return NULL;
+    }
+    return packer;
+}
+
+void
+SDL_DestroyRectPacker(SDL_RectPacker * packer)
+{
+    if (packer) {
+        SDL_free(packer->free_rects);
+        SDL_free(packer);
+    }
+}
+
+int
+SDL_PackRect(SDL_RectPacker * packer, int w, int h, SDL_Rect * rect)
+{
+    int best = -1;
+    int best_short = 0, best_long = 0;
+    int i, num_free;
+
+    /* Best short side fit */
+    for (i = 0; i < packer->num_free; ++i) {
+        const SDL_Rect *free_rect = &packer->free_rects[i];
+        int leftover_w, leftover_h, leftover_short, leftover_long;
+
+        if (free_rect->w < w || free_rect->h < h) {
+            continue;
+        }
+        leftover_w = free_rect->w - w;
+        leftover_h = free_rect->h - h;
+        leftover_short = SDL_min(leftover_w, leftover_h);
+        leftover_long = SDL_max(leftover_w, leftover_h);
+        if (best < 0 || leftover_short < best_short ||
+            (leftover_short == best_short && leftover_long < best_long)) {
+            best = i;
+            best_short = leftover_short;
+            best_long = leftover_long;
+        }
+    }
+    if (best < 0) {
+        return -1;
+    }
+
+    rect->x = packer->free_rects[best].x;
+    rect->y = packer->free_rects[best].y;
+    rect->w = w;
+    rect->h = h;
+
+    /* The parts added by the splits go past num_free and don't overlap */
+    num_free = packer->num_free;
+    for (i = 0; i < num_free; ++i) {
+        if (SDL_HasIntersection(&packer->free_rects[i], rect)) {
+            if (SplitFreeRect(packer, i, rect) < 0) {
+                return -1;
+            }
+            packer->free_rects[i].w = 0;
+        }
+    }
+    for (i = 0; i < packer->num_free; ++i) {
+        if (packer->free_rects[i].w == 0) {
+            packer->free_rects[i--] = packer->free_rects[--packer->num_free];
+        }
+    }
+    PruneFreeRects(packer);
+
+    ++packer->num_used;
+    return 0;
+}
+
+void
+SDL_UnpackRect(SDL_RectPacker * packer, const SDL_Rect * rect)
+{
+    if (--packer->num_used == 0) {
+        ResetFreeRects(packer);
+        return;
+    }
+    MergeFreeRect(packer, rect);
+    PruneFreeRects(packer);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
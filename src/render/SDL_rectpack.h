@@ -18,11 +18,21 @@
      misrepresented as being the original software.
   3. This notice may not be removed or altered from any source distribution.
 */
+#include "../SDL_internal.h"
 
-#ifndef MIN
-#define MIN(a,b)    (((a) < (b)) ? (a) : (b))
-#endif
+#include "SDL_rect.h"
 
-extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery, int smooth, int flipx, int flipy, int dstwidth, int dstheight, double cangle, double sangle);
-extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, int *dstwidth, int *dstheight, double *cangle, double *sangle);
+/* Packs rectangles into a fixed size area, for texture atlas pages */
 
+typedef struct SDL_RectPacker SDL_RectPacker;
+
+extern SDL_RectPacker *SDL_CreateRectPacker(int w, int h);
+extern void SDL_DestroyRectPacker(SDL_RectPacker * packer);
+
+/* Find room for a 'w' x 'h' rectangle, returns -1 if there is none */
+extern int SDL_PackRect(SDL_RectPacker * packer, int w, int h, SDL_Rect * rect);
+
+/* Give back the area of a rectangle returned by SDL_PackRect() */
+extern void SDL_UnpackRect(SDL_RectPacker * packer, const SDL_Rect * rect);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -32,6 +32,14 @@
 
 #define SDL_WINDOWRENDERDATA    "_SDL_WindowRenderData"
 
+/* Flush early rather than let an application that never presents grow the queue forever */
+#define SDL_RENDER_MAX_BATCH_RECTS  65536
+
+/* Atlas textures get a transparent border, so linear filtering doesn't pick
+   up their neighbours */
+#define SDL_ATLAS_PADDING           1
+#define SDL_ATLAS_PAGE_SIZE         1024
+
 #define CHECK_RENDERER_MAGIC(renderer, retval) \
     if (!renderer || renderer->magic != &renderer_magic) { \
         SDL_SetError("Invalid renderer"); \
@@ -44,6 +52,18 @@
         return retval; \
     }
 
+#define CHECK_ATLAS_MAGIC(atlas, retval) \
+    if (!atlas || atlas->magic != &atlas_magic) { \
+        SDL_SetError("Invalid texture atlas"); \
+        return retval; \
+    }
+
+#define CHECK_READBACK_MAGIC(readback, retval) \
+    if (!readback || readback->magic != &readback_magic) { \
+        SDL_SetError("Invalid readback"); \
+        return retval; \
+    }
+
 
 #if !SDL_RENDER_DISABLED
 static const SDL_RenderDriver *render_drivers[] = {
@@ -74,8 +94,11 @@ static const SDL_RenderDriver *render_drivers[] = {
 
 static char renderer_magic;
 static char texture_magic;
+static char atlas_magic;
+static char readback_magic;
 
 static int UpdateLogicalSize(SDL_Renderer *renderer);
+static int FlushRenderCommands(SDL_Renderer *renderer);
 
 int
 SDL_GetNumRenderDrivers(void)
@@ -102,6 +125,14 @@ SDL_GetRenderDriverInfo(int index, SDL_RendererInfo * info)
 #endif
 }
 
+/* The events SDL_RendererEventWatch() looks at */
+static const Uint32 SDL_renderer_event_types[] = {
+    SDL_WINDOWEVENT,
+    SDL_MOUSEMOTION,
+    SDL_MOUSEBUTTONDOWN,
+    SDL_MOUSEBUTTONUP
+};
+
 static int
 SDL_RendererEventWatch(void *userdata, SDL_Event *event)
 {
@@ -110,6 +141,8 @@ SDL_RendererEventWatch(void *userdata, SDL_Event *event)
     if (event->type == SDL_WINDOWEVENT) {
         SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
         if (window == renderer->window) {
+            FlushRenderCommands(renderer);
+
             if (renderer->WindowEvent) {
                 renderer->WindowEvent(renderer, &event->window);
             }
@@ -297,11 +330,25 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
             renderer->hidden = SDL_FALSE;
         }
 
+        /* An application that asks for a specific driver may be mixing its
+           own graphics API calls with ours, so don't defer drawing unless
+           it opts in. */
+        if (renderer->RenderBatch) {
+            hint = SDL_GetHint(SDL_HINT_RENDER_BATCHING);
+            if (hint) {
+                renderer->batching = (*hint != '0') ? SDL_TRUE : SDL_FALSE;
+            } else if (!renderer->batching) {
+                renderer->batching = SDL_GetHint(SDL_HINT_RENDER_DRIVER) ? SDL_FALSE : SDL_TRUE;
+            }
+        }
+
         SDL_SetWindowData(window, SDL_WINDOWRENDERDATA, renderer);
 
         SDL_RenderSetViewport(renderer, NULL);
 
-        SDL_AddEventWatch(SDL_RendererEventWatch, renderer);
+        SDL_AddEventWatchTypes(SDL_RendererEventWatch, renderer,
+                               SDL_renderer_event_types,
+                               SDL_arraysize(SDL_renderer_event_types));
 
         SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
                     "Created renderer: %s", renderer->info.name);
@@ -322,10 +369,19 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
     renderer = SW_CreateRendererForSurface(surface);
 
     if (renderer) {
+        const char *hint = SDL_GetHint(SDL_HINT_RENDER_BATCHING);
+
         renderer->magic = &renderer_magic;
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
 
+        /* The application reads the surface directly, so only defer drawing
+           if it explicitly asks for it, or the renderer needs it to draw
+           with several threads */
+        if (hint) {
+            renderer->batching = (*hint != '0') ? SDL_TRUE : SDL_FALSE;
+        }
+
         SDL_RenderSetViewport(renderer, NULL);
     }
     return renderer;
@@ -501,43 +557,26 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     return texture;
 }
 
-SDL_Texture *
-SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
+/* Pick the first packed texture format that has (or lacks) alpha */
+static Uint32
+GetTextureFormatForAlpha(SDL_Renderer * renderer, SDL_bool needAlpha)
 {
-    const SDL_PixelFormat *fmt;
-    SDL_bool needAlpha;
     Uint32 i;
-    Uint32 format;
-    SDL_Texture *texture;
-
-    CHECK_RENDERER_MAGIC(renderer, NULL);
-
-    if (!surface) {
-        SDL_SetError("SDL_CreateTextureFromSurface() passed NULL surface");
-        return NULL;
-    }
 
-    /* See what the best texture format is */
-    fmt = surface->format;
-    if (fmt->Amask || SDL_GetColorKey(surface, NULL) == 0) {
-        needAlpha = SDL_TRUE;
-    } else {
-        needAlpha = SDL_FALSE;
-    }
-    format = renderer->info.texture_formats[0];
     for (i = 0; i < renderer->info.num_texture_formats; ++i) {
         if (!SDL_ISPIXELFORMAT_FOURCC(renderer->info.texture_formats[i]) &&
             SDL_ISPIXELFORMAT_ALPHA(renderer->info.texture_formats[i]) == needAlpha) {
-            format = renderer->info.texture_formats[i];
-            break;
+            return renderer->info.texture_formats[i];
         }
     }
+    return renderer->info.texture_formats[0];
+}
 
-    texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC,
-                                surface->w, surface->h);
-    if (!texture) {
-        return NULL;
-    }
+/* Fill a texture the size of the surface with its pixels and settings */
+static int
+SetTextureFromSurface(SDL_Texture * texture, SDL_Surface * surface)
+{
+    Uint32 format = texture->format;
 
     if (format == surface->format->format) {
         if (SDL_MUSTLOCK(surface)) {
@@ -554,8 +593,7 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
         /* Set up a destination surface for the texture update */
         dst_fmt = SDL_AllocFormat(format);
         if (!dst_fmt) {
-           SDL_DestroyTexture(texture);
-           return NULL;
+           return -1;
         }
         temp = SDL_ConvertSurface(surface, dst_fmt, 0);
         SDL_FreeFormat(dst_fmt);
@@ -563,8 +601,7 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
             SDL_UpdateTexture(texture, NULL, temp->pixels, temp->pitch);
             SDL_FreeSurface(temp);
         } else {
-            SDL_DestroyTexture(texture);
-            return NULL;
+            return -1;
         }
     }
 
@@ -586,9 +623,344 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
             SDL_SetTextureBlendMode(texture, blendMode);
         }
     }
+    return 0;
+}
+
+SDL_Texture *
+SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
+{
+    const SDL_PixelFormat *fmt;
+    SDL_bool needAlpha;
+    Uint32 format;
+    SDL_Texture *texture;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!surface) {
+        SDL_SetError("SDL_CreateTextureFromSurface() passed NULL surface");
+        return NULL;
+    }
+
+    /* See what the best texture format is */
+    fmt = surface->format;
+    if (fmt->Amask || SDL_GetColorKey(surface, NULL) == 0) {
+        needAlpha = SDL_TRUE;
+    } else {
+        needAlpha = SDL_FALSE;
+    }
+    format = GetTextureFormatForAlpha(renderer, needAlpha);
+
+    texture = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STATIC,
+                                surface->w, surface->h);
+    if (!texture) {
+        return NULL;
+    }
+
+    if (SetTextureFromSurface(texture, surface) < 0) {
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
+    return texture;
+}
+
+SDL_TextureAtlas *
+SDL_CreateTextureAtlas(SDL_Renderer * renderer, Uint32 format,
+                       int page_w, int page_h)
+{
+    SDL_TextureAtlas *atlas;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = GetTextureFormatForAlpha(renderer, SDL_TRUE);
+    }
+    if (SDL_BYTESPERPIXEL(format) == 0 || SDL_ISPIXELFORMAT_FOURCC(format) ||
+        SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_SetError("Atlas pages must have a packed pixel format");
+        return NULL;
+    }
+    if (page_w < 0 || page_h < 0) {
+        SDL_SetError("Invalid atlas page size");
+        return NULL;
+    }
+    if (!page_w) {
+        page_w = SDL_ATLAS_PAGE_SIZE;
+        if (renderer->info.max_texture_width) {
+            page_w = SDL_min(page_w, renderer->info.max_texture_width);
+        }
+    }
+    if (!page_h) {
+        page_h = SDL_ATLAS_PAGE_SIZE;
+        if (renderer->info.max_texture_height) {
+            page_h = SDL_min(page_h, renderer->info.max_texture_height);
+        }
+    }
+
+    atlas = (SDL_TextureAtlas *) SDL_calloc(1, sizeof(*atlas));
+    if (!atlas) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    atlas->magic = &atlas_magic;
+    atlas->format = format;
+    atlas->page_w = page_w;
+    atlas->page_h = page_h;
+    atlas->renderer = renderer;
+    atlas->next = renderer->atlases;
+    if (renderer->atlases) {
+        renderer->atlases->prev = atlas;
+    }
+    renderer->atlases = atlas;
+
+    return atlas;
+}
+
+static SDL_AtlasPage *
+CreateAtlasPage(SDL_TextureAtlas * atlas)
+{
+    SDL_AtlasPage *page;
+
+    page = (SDL_AtlasPage *) SDL_calloc(1, sizeof(*page));
+    if (!page) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format,
+                                      SDL_TEXTUREACCESS_STATIC,
+                                      atlas->page_w, atlas->page_h);
+    if (!page->texture) {
+        SDL_free(page);
+        return NULL;
+    }
+
+    /* Packed rectangles include the padding, which may hang off the page */
+    page->packer = SDL_CreateRectPacker(atlas->page_w + 2 * SDL_ATLAS_PADDING,
+                                        atlas->page_h + 2 * SDL_ATLAS_PADDING);
+    if (!page->packer) {
+        SDL_DestroyTexture(page->texture);
+        SDL_free(page);
+        return NULL;
+    }
+
+    page->next = atlas->pages;
+    atlas->pages = page;
+    return page;
+}
+
+static void
+DestroyAtlasPage(SDL_TextureAtlas * atlas, SDL_AtlasPage * page)
+{
+    SDL_AtlasPage **prev;
+
+    for (prev = &atlas->pages; *prev; prev = &(*prev)->next) {
+        if (*prev == page) {
+            *prev = page->next;
+            break;
+        }
+    }
+    SDL_DestroyTexture(page->texture);
+    SDL_DestroyRectPacker(page->packer);
+    SDL_free(page);
+}
+
+SDL_Texture *
+SDL_CreateAtlasTexture(SDL_TextureAtlas * atlas, int w, int h)
+{
+    SDL_AtlasPage *page;
+    SDL_Texture *texture;
+    SDL_Rect rect;
+    void *pixels;
+    int pitch;
+
+    CHECK_ATLAS_MAGIC(atlas, NULL);
+
+    if (w <= 0 || h <= 0) {
+        SDL_SetError("Texture dimensions can't be 0");
+        return NULL;
+    }
+    if (w > atlas->page_w || h > atlas->page_h) {
+        SDL_SetError("Texture dimensions are limited to %dx%d in this atlas", atlas->page_w, atlas->page_h);
+        return NULL;
+    }
+
+    for (page = atlas->pages; page; page = page->next) {
+        if (SDL_PackRect(page->packer, w + 2 * SDL_ATLAS_PADDING,
+                         h + 2 * SDL_ATLAS_PADDING, &rect) == 0) {
+            break;
+        }
+    }
+    if (!page) {
+        page = CreateAtlasPage(atlas);
+        if (!page) {
+            return NULL;
+        }
+        if (SDL_PackRect(page->packer, w + 2 * SDL_ATLAS_PADDING,
+                         h + 2 * SDL_ATLAS_PADDING, &rect) < 0) {
+            DestroyAtlasPage(atlas, page);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    }
+    ++page->count;
+
+    texture = (SDL_Texture *) SDL_calloc(1, sizeof(*texture));
+    if (!texture) {
+        SDL_UnpackRect(page->packer, &rect);
+        --page->count;
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    texture->magic = &texture_magic;
+    texture->format = atlas->format;
+    texture->access = SDL_TEXTUREACCESS_STATIC;
+    texture->w = w;
+    texture->h = h;
+    texture->r = 255;
+    texture->g = 255;
+    texture->b = 255;
+    texture->a = 255;
+    texture->renderer = atlas->renderer;
+    texture->atlas = atlas;
+    texture->page = page;
+    /* Packer coordinates are offset by the padding, so this is the inside */
+    texture->page_rect.x = rect.x;
+    texture->page_rect.y = rect.y;
+    texture->page_rect.w = w;
+    texture->page_rect.h = h;
+    texture->next = atlas->textures;
+    if (atlas->textures) {
+        atlas->textures->prev = texture;
+    }
+    atlas->textures = texture;
+
+    /* Clear whatever was left there, padding included */
+    rect.x -= SDL_ATLAS_PADDING;
+    rect.y -= SDL_ATLAS_PADDING;
+    rect.w = SDL_min(rect.x + rect.w, atlas->page_w) - SDL_max(rect.x, 0);
+    rect.h = SDL_min(rect.y + rect.h, atlas->page_h) - SDL_max(rect.y, 0);
+    rect.x = SDL_max(rect.x, 0);
+    rect.y = SDL_max(rect.y, 0);
+    pitch = rect.w * SDL_BYTESPERPIXEL(atlas->format);
+    pixels = SDL_calloc(rect.h, pitch);
+    if (!pixels) {
+        SDL_DestroyTexture(texture);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    SDL_UpdateTexture(page->texture, &rect, pixels, pitch);
+    SDL_free(pixels);
+
+    return texture;
+}
+
+SDL_Texture *
+SDL_CreateAtlasTextureFromSurface(SDL_TextureAtlas * atlas, SDL_Surface * surface)
+{
+    SDL_Texture *texture;
+
+    CHECK_ATLAS_MAGIC(atlas, NULL);
+
+    if (!surface) {
+        SDL_SetError("SDL_CreateAtlasTextureFromSurface() passed NULL surface");
+        return NULL;
+    }
+
+    texture = SDL_CreateAtlasTexture(atlas, surface->w, surface->h);
+    if (!texture) {
+        return NULL;
+    }
+
+    if (SetTextureFromSurface(texture, surface) < 0) {
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
     return texture;
 }
 
+static void
+DestroyAtlasTexture(SDL_Texture * texture)
+{
+    SDL_TextureAtlas *atlas = texture->atlas;
+    SDL_AtlasPage *page = texture->page;
+    SDL_Rect rect;
+
+    texture->magic = NULL;
+
+    if (texture->next) {
+        texture->next->prev = texture->prev;
+    }
+    if (texture->prev) {
+        texture->prev->next = texture->next;
+    } else {
+        atlas->textures = texture->next;
+    }
+
+    rect.x = texture->page_rect.x;
+    rect.y = texture->page_rect.y;
+    rect.w = texture->w + 2 * SDL_ATLAS_PADDING;
+    rect.h = texture->h + 2 * SDL_ATLAS_PADDING;
+    SDL_UnpackRect(page->packer, &rect);
+
+    /* Keep one page around for the next textures */
+    if (--page->count == 0 && (page != atlas->pages || page->next)) {
+        DestroyAtlasPage(atlas, page);
+    }
+    SDL_free(texture);
+}
+
+void
+SDL_DestroyTextureAtlas(SDL_TextureAtlas * atlas)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_ATLAS_MAGIC(atlas, );
+
+    renderer = atlas->renderer;
+
+    while (atlas->textures) {
+        DestroyAtlasTexture(atlas->textures);
+    }
+    while (atlas->pages) {
+        DestroyAtlasPage(atlas, atlas->pages);
+    }
+
+    atlas->magic = NULL;
+
+    if (atlas->next) {
+        atlas->next->prev = atlas->prev;
+    }
+    if (atlas->prev) {
+        atlas->prev->next = atlas->next;
+    } else {
+        renderer->atlases = atlas->next;
+    }
+    SDL_free(atlas);
+}
+
+/* Point a copy from an atlas texture at its page, which takes on the
+   modulation and blend mode of the texture */
+static SDL_Texture *
+GetAtlasPage(SDL_Texture * texture, SDL_Rect * srcrect)
+{
+    SDL_Texture *page = texture->page->texture;
+
+    if (srcrect) {
+        srcrect->x += texture->page_rect.x;
+        srcrect->y += texture->page_rect.y;
+    }
+    if (page->r != texture->r || page->g != texture->g || page->b != texture->b) {
+        SDL_SetTextureColorMod(page, texture->r, texture->g, texture->b);
+    }
+    if (page->a != texture->a) {
+        SDL_SetTextureAlphaMod(page, texture->a);
+    }
+    if (page->blendMode != texture->blendMode) {
+        SDL_SetTextureBlendMode(page, texture->blendMode);
+    }
+    return page;
+}
+
 int
 SDL_QueryTexture(SDL_Texture * texture, Uint32 * format, int *access,
                  int *w, int *h)
@@ -628,6 +1000,8 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     texture->b = b;
     if (texture->native) {
         return SDL_SetTextureColorMod(texture->native, r, g, b);
+    } else if (texture->page) {
+        return 0;   /* The page takes it on when drawing */
     } else if (renderer->SetTextureColorMod) {
         return renderer->SetTextureColorMod(renderer, texture);
     } else {
@@ -669,6 +1043,8 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
     texture->a = alpha;
     if (texture->native) {
         return SDL_SetTextureAlphaMod(texture->native, alpha);
+    } else if (texture->page) {
+        return 0;   /* The page takes it on when drawing */
     } else if (renderer->SetTextureAlphaMod) {
         return renderer->SetTextureAlphaMod(renderer, texture);
     } else {
@@ -698,6 +1074,8 @@ SDL_SetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode blendMode)
     texture->blendMode = blendMode;
     if (texture->native) {
         return SDL_SetTextureBlendMode(texture->native, blendMode);
+    } else if (texture->page) {
+        return 0;   /* The page takes it on when drawing */
     } else if (renderer->SetTextureBlendMode) {
         return renderer->SetTextureBlendMode(renderer, texture);
     } else {
@@ -799,6 +1177,25 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
     return 0;
 }
 
+static int
+SDL_UpdateTextureAtlas(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch)
+{
+    SDL_Rect page_rect;
+
+    /* Anything outside the texture belongs to its neighbours */
+    if (rect->x < 0 || rect->y < 0 ||
+        rect->x + rect->w > texture->w || rect->y + rect->h > texture->h) {
+        return SDL_SetError("Tried to update outside of an atlas texture");
+    }
+
+    page_rect.x = texture->page_rect.x + rect->x;
+    page_rect.y = texture->page_rect.y + rect->y;
+    page_rect.w = rect->w;
+    page_rect.h = rect->h;
+    return SDL_UpdateTexture(texture->page->texture, &page_rect, pixels, pitch);
+}
+
 int
 SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
                   const void *pixels, int pitch)
@@ -808,6 +1205,9 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
+    /* Queued copies must see the old contents */
+    FlushRenderCommands(texture->renderer);
+
     if (!pixels) {
         return SDL_InvalidParamError("pixels");
     }
@@ -829,6 +1229,8 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
+    } else if (texture->page) {
+        return SDL_UpdateTextureAtlas(texture, rect, pixels, pitch);
     } else {
         renderer = texture->renderer;
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
@@ -893,6 +1295,8 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
+    FlushRenderCommands(texture->renderer);
+
     if (!Yplane) {
         return SDL_InvalidParamError("Yplane");
     }
@@ -971,6 +1375,8 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_SetError("SDL_LockTexture(): texture must be streaming");
     }
 
+    FlushRenderCommands(texture->renderer);
+
     if (!rect) {
         full_rect.x = 0;
         full_rect.y = 0;
@@ -1086,6 +1492,10 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         }
     }
 
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
     if (texture && !renderer->target) {
         /* Make a backup of the viewport */
         renderer->viewport_backup = renderer->viewport;
@@ -1220,6 +1630,8 @@ SDL_RenderSetViewport(SDL_Renderer * renderer, const SDL_Rect * rect)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    FlushRenderCommands(renderer);
+
     if (rect) {
         renderer->viewport.x = (int)SDL_floor(rect->x * renderer->scale.x);
         renderer->viewport.y = (int)SDL_floor(rect->y * renderer->scale.y);
@@ -1253,6 +1665,8 @@ SDL_RenderSetClipRect(SDL_Renderer * renderer, const SDL_Rect * rect)
 {
     CHECK_RENDERER_MAGIC(renderer, -1)
 
+    FlushRenderCommands(renderer);
+
     if (rect) {
         renderer->clipping_enabled = SDL_TRUE;
         renderer->clip_rect.x = (int)SDL_floor(rect->x * renderer->scale.x);
@@ -1361,16 +1775,142 @@ SDL_GetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode *blendMode)
     return 0;
 }
 
-int
-SDL_RenderClear(SDL_Renderer * renderer)
+/* Hand the recorded commands to the backend */
+static int
+FlushRenderCommands(SDL_Renderer *renderer)
 {
-    CHECK_RENDERER_MAGIC(renderer, -1);
+    int status = 0;
 
-    /* Don't draw while we're hidden */
-    if (renderer->hidden) {
-        return 0;
+    if (renderer->num_commands > 0) {
+        status = renderer->RenderBatch(renderer, renderer->commands,
+                                       renderer->num_commands,
+                                       renderer->batch_srcrects,
+                                       renderer->batch_dstrects);
     }
-    return renderer->RenderClear(renderer);
+    renderer->num_commands = 0;
+    renderer->num_batch_rects = 0;
+
+    return status;
+}
+
+/* Record quads, extending the previous command if the state matches */
+static int
+QueueRenderQuads(SDL_Renderer *renderer, SDL_Texture *texture,
+                 Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode,
+                 const SDL_Rect *srcrects, const SDL_FRect *dstrects, int count)
+{
+    SDL_RenderCommand *cmd;
+
+    if (renderer->num_batch_rects + count > SDL_RENDER_MAX_BATCH_RECTS) {
+        if (FlushRenderCommands(renderer) < 0) {
+            return -1;
+        }
+    }
+
+    if (renderer->num_batch_rects + count > renderer->max_batch_rects) {
+        int max_rects = SDL_max(renderer->max_batch_rects * 2, 256);
+        SDL_Rect *srcs;
+        SDL_FRect *dsts;
+
+        while (max_rects < renderer->num_batch_rects + count) {
+            max_rects *= 2;
+        }
+        srcs = (SDL_Rect *) SDL_realloc(renderer->batch_srcrects, max_rects * sizeof(*srcs));
+        if (!srcs) {
+            return SDL_OutOfMemory();
+        }
+        renderer->batch_srcrects = srcs;
+        dsts = (SDL_FRect *) SDL_realloc(renderer->batch_dstrects, max_rects * sizeof(*dsts));
+        if (!dsts) {
+            return SDL_OutOfMemory();
+        }
+        renderer->batch_dstrects = dsts;
+        renderer->max_batch_rects = max_rects;
+    }
+
+    cmd = NULL;
+    if (renderer->num_commands > 0) {
+        cmd = &renderer->commands[renderer->num_commands - 1];
+        if (cmd->texture != texture ||
+            cmd->r != r || cmd->g != g || cmd->b != b || cmd->a != a ||
+            cmd->blendMode != blendMode) {
+            cmd = NULL;
+        }
+    }
+    if (!cmd) {
+        if (renderer->num_commands == renderer->max_commands) {
+            int max_commands = SDL_max(renderer->max_commands * 2, 32);
+            SDL_RenderCommand *commands = (SDL_RenderCommand *) SDL_realloc(renderer->commands, max_commands * sizeof(*commands));
+            if (!commands) {
+                return SDL_OutOfMemory();
+            }
+            renderer->commands = commands;
+            renderer->max_commands = max_commands;
+        }
+        cmd = &renderer->commands[renderer->num_commands++];
+        cmd->texture = texture;
+        cmd->r = r;
+        cmd->g = g;
+        cmd->b = b;
+        cmd->a = a;
+        cmd->blendMode = blendMode;
+        cmd->first = renderer->num_batch_rects;
+        cmd->count = 0;
+    }
+
+    if (srcrects) {
+        SDL_memcpy(&renderer->batch_srcrects[renderer->num_batch_rects], srcrects, count * sizeof(*srcrects));
+    }
+    SDL_memcpy(&renderer->batch_dstrects[renderer->num_batch_rects], dstrects, count * sizeof(*dstrects));
+    renderer->num_batch_rects += count;
+    cmd->count += count;
+
+    return 0;
+}
+
+int
+SDL_RenderFlush(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    return FlushRenderCommands(renderer);
+}
+
+int
+SDL_RenderClear(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+    return renderer->RenderClear(renderer);
+}
+
+/* Scratch space for converting coordinates, kept until the renderer is destroyed */
+static void *
+GetRenderScratch(SDL_Renderer * renderer, size_t size)
+{
+    if (size > renderer->scratch_size) {
+        size_t scratch_size = SDL_max(renderer->scratch_size * 2, 1024);
+        void *scratch;
+
+        while (scratch_size < size) {
+            scratch_size *= 2;
+        }
+        scratch = SDL_realloc(renderer->scratch, scratch_size);
+        if (!scratch) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        renderer->scratch = scratch;
+        renderer->scratch_size = scratch_size;
+    }
+    return renderer->scratch;
 }
 
 int
@@ -1383,17 +1923,26 @@ SDL_RenderDrawPoint(SDL_Renderer * renderer, int x, int y)
     return SDL_RenderDrawPoints(renderer, &point, 1);
 }
 
+int
+SDL_RenderDrawPointF(SDL_Renderer * renderer, float x, float y)
+{
+    SDL_FPoint fpoint;
+
+    fpoint.x = x;
+    fpoint.y = y;
+    return SDL_RenderDrawPointsF(renderer, &fpoint, 1);
+}
+
 static int
 RenderDrawPointsWithRects(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
 {
     SDL_FRect *frects;
     int i;
-    int status;
 
-    frects = SDL_stack_alloc(SDL_FRect, count);
+    frects = (SDL_FRect *) GetRenderScratch(renderer, count * sizeof(*frects));
     if (!frects) {
-        return SDL_OutOfMemory();
+        return -1;
     }
     for (i = 0; i < count; ++i) {
         frects[i].x = points[i].x * renderer->scale.x;
@@ -1402,11 +1951,28 @@ RenderDrawPointsWithRects(SDL_Renderer * renderer,
         frects[i].h = renderer->scale.y;
     }
 
-    status = renderer->RenderFillRects(renderer, frects, count);
+    return renderer->RenderFillRects(renderer, frects, count);
+}
 
-    SDL_stack_free(frects);
+static int
+RenderDrawPointsWithRectsF(SDL_Renderer * renderer,
+                           const SDL_FPoint * fpoints, int count)
+{
+    SDL_FRect *frects;
+    int i;
 
-    return status;
+    frects = (SDL_FRect *) GetRenderScratch(renderer, count * sizeof(*frects));
+    if (!frects) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        frects[i].x = fpoints[i].x * renderer->scale.x;
+        frects[i].y = fpoints[i].y * renderer->scale.y;
+        frects[i].w = renderer->scale.x;
+        frects[i].h = renderer->scale.y;
+    }
+
+    return renderer->RenderFillRects(renderer, frects, count);
 }
 
 int
@@ -1415,7 +1981,6 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
 {
     SDL_FPoint *fpoints;
     int i;
-    int status;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -1429,25 +1994,51 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
     if (renderer->hidden) {
         return 0;
     }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
 
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         return RenderDrawPointsWithRects(renderer, points, count);
     }
 
-    fpoints = SDL_stack_alloc(SDL_FPoint, count);
+    fpoints = (SDL_FPoint *) GetRenderScratch(renderer, count * sizeof(*fpoints));
     if (!fpoints) {
-        return SDL_OutOfMemory();
+        return -1;
     }
     for (i = 0; i < count; ++i) {
-        fpoints[i].x = points[i].x * renderer->scale.x;
-        fpoints[i].y = points[i].y * renderer->scale.y;
+        fpoints[i].x = (float) points[i].x;
+        fpoints[i].y = (float) points[i].y;
     }
 
-    status = renderer->RenderDrawPoints(renderer, fpoints, count);
+    return renderer->RenderDrawPoints(renderer, fpoints, count);
+}
 
-    SDL_stack_free(fpoints);
+int
+SDL_RenderDrawPointsF(SDL_Renderer * renderer,
+                      const SDL_FPoint * points, int count)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
 
-    return status;
+    if (!points) {
+        return SDL_SetError("SDL_RenderDrawPointsF(): Passed NULL points");
+    }
+    if (count < 1) {
+        return 0;
+    }
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
+    if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
+        return RenderDrawPointsWithRectsF(renderer, points, count);
+    }
+
+    return renderer->RenderDrawPoints(renderer, points, count);
 }
 
 int
@@ -1462,6 +2053,18 @@ SDL_RenderDrawLine(SDL_Renderer * renderer, int x1, int y1, int x2, int y2)
     return SDL_RenderDrawLines(renderer, points, 2);
 }
 
+int
+SDL_RenderDrawLineF(SDL_Renderer * renderer, float x1, float y1, float x2, float y2)
+{
+    SDL_FPoint points[2];
+
+    points[0].x = x1;
+    points[0].y = y1;
+    points[1].x = x2;
+    points[1].y = y2;
+    return SDL_RenderDrawLinesF(renderer, points, 2);
+}
+
 static int
 RenderDrawLinesWithRects(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
@@ -1472,9 +2075,9 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
     int i, nrects;
     int status;
 
-    frects = SDL_stack_alloc(SDL_FRect, count-1);
+    frects = (SDL_FRect *) GetRenderScratch(renderer, (count-1) * sizeof(*frects));
     if (!frects) {
-        return SDL_OutOfMemory();
+        return -1;
     }
 
     status = 0;
@@ -1510,7 +2113,59 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
 
     status += renderer->RenderFillRects(renderer, frects, nrects);
 
-    SDL_stack_free(frects);
+    if (status < 0) {
+        status = -1;
+    }
+    return status;
+}
+
+static int
+RenderDrawLinesWithRectsF(SDL_Renderer * renderer,
+                          const SDL_FPoint * points, int count)
+{
+    SDL_FRect *frect;
+    SDL_FRect *frects;
+    SDL_FPoint fpoints[2];
+    int i, nrects;
+    int status;
+
+    frects = (SDL_FRect *) GetRenderScratch(renderer, (count-1) * sizeof(*frects));
+    if (!frects) {
+        return -1;
+    }
+
+    status = 0;
+    nrects = 0;
+    for (i = 0; i < count-1; ++i) {
+        if (points[i].x == points[i+1].x) {
+            const float minY = SDL_min(points[i].y, points[i+1].y);
+            const float maxY = SDL_max(points[i].y, points[i+1].y);
+
+            frect = &frects[nrects++];
+            frect->x = points[i].x * renderer->scale.x;
+            frect->y = minY * renderer->scale.y;
+            frect->w = renderer->scale.x;
+            frect->h = (maxY - minY + 1) * renderer->scale.y;
+        } else if (points[i].y == points[i+1].y) {
+            const float minX = SDL_min(points[i].x, points[i+1].x);
+            const float maxX = SDL_max(points[i].x, points[i+1].x);
+
+            frect = &frects[nrects++];
+            frect->x = minX * renderer->scale.x;
+            frect->y = points[i].y * renderer->scale.y;
+            frect->w = (maxX - minX + 1) * renderer->scale.x;
+            frect->h = renderer->scale.y;
+        } else {
+            /* FIXME: We can't use a rect for this line... */
+            fpoints[0].x = points[i].x * renderer->scale.x;
+            fpoints[0].y = points[i].y * renderer->scale.y;
+            fpoints[1].x = points[i+1].x * renderer->scale.x;
+            fpoints[1].y = points[i+1].y * renderer->scale.y;
+            status += renderer->RenderDrawLines(renderer, fpoints, 2);
+        }
+    }
+
+    status += renderer->RenderFillRects(renderer, frects, nrects);
 
     if (status < 0) {
         status = -1;
@@ -1524,7 +2179,6 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
 {
     SDL_FPoint *fpoints;
     int i;
-    int status;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -1538,25 +2192,51 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
     if (renderer->hidden) {
         return 0;
     }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
 
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         return RenderDrawLinesWithRects(renderer, points, count);
     }
 
-    fpoints = SDL_stack_alloc(SDL_FPoint, count);
+    fpoints = (SDL_FPoint *) GetRenderScratch(renderer, count * sizeof(*fpoints));
     if (!fpoints) {
-        return SDL_OutOfMemory();
+        return -1;
     }
     for (i = 0; i < count; ++i) {
-        fpoints[i].x = points[i].x * renderer->scale.x;
-        fpoints[i].y = points[i].y * renderer->scale.y;
+        fpoints[i].x = (float) points[i].x;
+        fpoints[i].y = (float) points[i].y;
     }
 
-    status = renderer->RenderDrawLines(renderer, fpoints, count);
+    return renderer->RenderDrawLines(renderer, fpoints, count);
+}
 
-    SDL_stack_free(fpoints);
+int
+SDL_RenderDrawLinesF(SDL_Renderer * renderer,
+                     const SDL_FPoint * points, int count)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
 
-    return status;
+    if (!points) {
+        return SDL_SetError("SDL_RenderDrawLinesF(): Passed NULL points");
+    }
+    if (count < 2) {
+        return 0;
+    }
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
+    if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
+        return RenderDrawLinesWithRectsF(renderer, points, count);
+    }
+
+    return renderer->RenderDrawLines(renderer, points, count);
 }
 
 int
@@ -1588,6 +2268,39 @@ SDL_RenderDrawRect(SDL_Renderer * renderer, const SDL_Rect * rect)
     return SDL_RenderDrawLines(renderer, points, 5);
 }
 
+int
+SDL_RenderDrawRectF(SDL_Renderer * renderer, const SDL_FRect * rect)
+{
+    SDL_FRect full_rect;
+    SDL_FPoint points[5];
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    /* If 'rect' == NULL, then outline the whole surface */
+    if (!rect) {
+        SDL_Rect viewport = { 0, 0, 0, 0 };
+
+        SDL_RenderGetViewport(renderer, &viewport);
+        full_rect.x = 0.0f;
+        full_rect.y = 0.0f;
+        full_rect.w = (float) viewport.w;
+        full_rect.h = (float) viewport.h;
+        rect = &full_rect;
+    }
+
+    points[0].x = rect->x;
+    points[0].y = rect->y;
+    points[1].x = rect->x+rect->w-1;
+    points[1].y = rect->y;
+    points[2].x = rect->x+rect->w-1;
+    points[2].y = rect->y+rect->h-1;
+    points[3].x = rect->x;
+    points[3].y = rect->y+rect->h-1;
+    points[4].x = rect->x;
+    points[4].y = rect->y;
+    return SDL_RenderDrawLinesF(renderer, points, 5);
+}
+
 int
 SDL_RenderDrawRects(SDL_Renderer * renderer,
                     const SDL_Rect * rects, int count)
@@ -1615,6 +2328,33 @@ SDL_RenderDrawRects(SDL_Renderer * renderer,
     return 0;
 }
 
+int
+SDL_RenderDrawRectsF(SDL_Renderer * renderer,
+                     const SDL_FRect * rects, int count)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!rects) {
+        return SDL_SetError("SDL_RenderDrawRectsF(): Passed NULL rects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    for (i = 0; i < count; ++i) {
+        if (SDL_RenderDrawRectF(renderer, &rects[i]) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
 int
 SDL_RenderFillRect(SDL_Renderer * renderer, const SDL_Rect * rect)
 {
@@ -1632,13 +2372,45 @@ SDL_RenderFillRect(SDL_Renderer * renderer, const SDL_Rect * rect)
     return SDL_RenderFillRects(renderer, rect, 1);
 }
 
+int
+SDL_RenderFillRectF(SDL_Renderer * renderer, const SDL_FRect * rect)
+{
+    SDL_FRect full_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    /* If 'rect' == NULL, then fill the whole surface */
+    if (!rect) {
+        SDL_Rect viewport = { 0, 0, 0, 0 };
+
+        SDL_RenderGetViewport(renderer, &viewport);
+        full_rect.x = 0.0f;
+        full_rect.y = 0.0f;
+        full_rect.w = (float) viewport.w;
+        full_rect.h = (float) viewport.h;
+        rect = &full_rect;
+    }
+    return SDL_RenderFillRectsF(renderer, rect, 1);
+}
+
+static int
+RenderFillRectsScaled(SDL_Renderer * renderer, const SDL_FRect * frects, int count)
+{
+    if (renderer->batching) {
+        return QueueRenderQuads(renderer, NULL,
+                                renderer->r, renderer->g, renderer->b,
+                                renderer->a, renderer->blendMode,
+                                NULL, frects, count);
+    }
+    return renderer->RenderFillRects(renderer, frects, count);
+}
+
 int
 SDL_RenderFillRects(SDL_Renderer * renderer,
                     const SDL_Rect * rects, int count)
 {
     SDL_FRect *frects;
     int i;
-    int status;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
 
@@ -1653,9 +2425,9 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         return 0;
     }
 
-    frects = SDL_stack_alloc(SDL_FRect, count);
+    frects = (SDL_FRect *) GetRenderScratch(renderer, count * sizeof(*frects));
     if (!frects) {
-        return SDL_OutOfMemory();
+        return -1;
     }
     for (i = 0; i < count; ++i) {
         frects[i].x = rects[i].x * renderer->scale.x;
@@ -1664,19 +2436,68 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         frects[i].h = rects[i].h * renderer->scale.y;
     }
 
-    status = renderer->RenderFillRects(renderer, frects, count);
+    return RenderFillRectsScaled(renderer, frects, count);
+}
+
+int
+SDL_RenderFillRectsF(SDL_Renderer * renderer,
+                     const SDL_FRect * rects, int count)
+{
+    SDL_FRect *frects;
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!rects) {
+        return SDL_SetError("SDL_RenderFillRectsF(): Passed NULL rects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    if (renderer->scale.x == 1.0f && renderer->scale.y == 1.0f) {
+        return RenderFillRectsScaled(renderer, rects, count);
+    }
 
-    SDL_stack_free(frects);
+    frects = (SDL_FRect *) GetRenderScratch(renderer, count * sizeof(*frects));
+    if (!frects) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        frects[i].x = rects[i].x * renderer->scale.x;
+        frects[i].y = rects[i].y * renderer->scale.y;
+        frects[i].w = rects[i].w * renderer->scale.x;
+        frects[i].h = rects[i].h * renderer->scale.y;
+    }
 
-    return status;
+    return RenderFillRectsScaled(renderer, frects, count);
 }
 
 int
 SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect)
+{
+    SDL_FRect dstfrect;
+
+    if (dstrect) {
+        dstfrect.x = (float) dstrect->x;
+        dstfrect.y = (float) dstrect->y;
+        dstfrect.w = (float) dstrect->w;
+        dstfrect.h = (float) dstrect->h;
+    }
+    return SDL_RenderCopyF(renderer, texture, srcrect, dstrect ? &dstfrect : NULL);
+}
+
+int
+SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
     SDL_Rect real_srcrect = { 0, 0, 0, 0 };
-    SDL_Rect real_dstrect = { 0, 0, 0, 0 };
+    SDL_Rect viewport = { 0, 0, 0, 0 };
     SDL_FRect frect;
 
     CHECK_RENDERER_MAGIC(renderer, -1);
@@ -1696,16 +2517,25 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
         }
     }
 
-    SDL_RenderGetViewport(renderer, &real_dstrect);
-    real_dstrect.x = 0;
-    real_dstrect.y = 0;
+    SDL_RenderGetViewport(renderer, &viewport);
     if (dstrect) {
-        if (!SDL_HasIntersection(dstrect, &real_dstrect)) {
+        /* Skip copies that don't touch the viewport */
+        if (dstrect->w <= 0.0f || dstrect->h <= 0.0f ||
+            dstrect->x >= viewport.w || dstrect->x + dstrect->w <= 0.0f ||
+            dstrect->y >= viewport.h || dstrect->y + dstrect->h <= 0.0f) {
             return 0;
         }
-        real_dstrect = *dstrect;
+        frect = *dstrect;
+    } else {
+        frect.x = 0.0f;
+        frect.y = 0.0f;
+        frect.w = (float) viewport.w;
+        frect.h = (float) viewport.h;
     }
 
+    if (texture->page) {
+        texture = GetAtlasPage(texture, &real_srcrect);
+    }
     if (texture->native) {
         texture = texture->native;
     }
@@ -1715,11 +2545,17 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
-    frect.x = real_dstrect.x * renderer->scale.x;
-    frect.y = real_dstrect.y * renderer->scale.y;
-    frect.w = real_dstrect.w * renderer->scale.x;
-    frect.h = real_dstrect.h * renderer->scale.y;
+    frect.x *= renderer->scale.x;
+    frect.y *= renderer->scale.y;
+    frect.w *= renderer->scale.x;
+    frect.h *= renderer->scale.y;
 
+    if (renderer->batching) {
+        return QueueRenderQuads(renderer, texture,
+                                texture->r, texture->g, texture->b,
+                                texture->a, texture->blendMode,
+                                &real_srcrect, &frect, 1);
+    }
     return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
 }
 
@@ -1728,15 +2564,49 @@ int
 SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect,
                const double angle, const SDL_Point *center, const SDL_RendererFlip flip)
+{
+    SDL_FRect dstfrect;
+    SDL_FPoint fcenter;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (dstrect) {
+        dstfrect.x = (float) dstrect->x;
+        dstfrect.y = (float) dstrect->y;
+        dstfrect.w = (float) dstrect->w;
+        dstfrect.h = (float) dstrect->h;
+    }
+
+    /* The default center is rounded down to whole pixels here */
+    if (center) {
+        fcenter.x = (float) center->x;
+        fcenter.y = (float) center->y;
+    } else if (dstrect) {
+        fcenter.x = (float) (dstrect->w / 2);
+        fcenter.y = (float) (dstrect->h / 2);
+    } else {
+        SDL_Rect viewport = { 0, 0, 0, 0 };
+
+        SDL_RenderGetViewport(renderer, &viewport);
+        fcenter.x = (float) (viewport.w / 2);
+        fcenter.y = (float) (viewport.h / 2);
+    }
+
+    return SDL_RenderCopyExF(renderer, texture, srcrect,
+                             dstrect ? &dstfrect : NULL, angle, &fcenter, flip);
+}
+
+int
+SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+                  const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
     SDL_Rect real_srcrect = { 0, 0, 0, 0 };
-    SDL_Rect real_dstrect = { 0, 0, 0, 0 };
-    SDL_Point real_center;
     SDL_FRect frect;
     SDL_FPoint fcenter;
 
     if (flip == SDL_FLIP_NONE && angle == 0) { /* fast path when we don't need rotation or flipping */
-        return SDL_RenderCopy(renderer, texture, srcrect, dstrect);
+        return SDL_RenderCopyF(renderer, texture, srcrect, dstrect);
     }
 
     CHECK_RENDERER_MAGIC(renderer, -1);
@@ -1761,34 +2631,128 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
     /* We don't intersect the dstrect with the viewport as RenderCopy does because of potential rotation clipping issues... TODO: should we? */
     if (dstrect) {
-        real_dstrect = *dstrect;
+        frect = *dstrect;
     } else {
-        SDL_RenderGetViewport(renderer, &real_dstrect);
-        real_dstrect.x = 0;
-        real_dstrect.y = 0;
+        SDL_Rect viewport = { 0, 0, 0, 0 };
+
+        SDL_RenderGetViewport(renderer, &viewport);
+        frect.x = 0.0f;
+        frect.y = 0.0f;
+        frect.w = (float) viewport.w;
+        frect.h = (float) viewport.h;
     }
 
+    if (texture->page) {
+        texture = GetAtlasPage(texture, &real_srcrect);
+    }
     if (texture->native) {
         texture = texture->native;
     }
 
-    if(center) real_center = *center;
-    else {
-        real_center.x = real_dstrect.w/2;
-        real_center.y = real_dstrect.h/2;
+    if (center) {
+        fcenter = *center;
+    } else {
+        fcenter.x = frect.w / 2;
+        fcenter.y = frect.h / 2;
     }
 
-    frect.x = real_dstrect.x * renderer->scale.x;
-    frect.y = real_dstrect.y * renderer->scale.y;
-    frect.w = real_dstrect.w * renderer->scale.x;
-    frect.h = real_dstrect.h * renderer->scale.y;
+    frect.x *= renderer->scale.x;
+    frect.y *= renderer->scale.y;
+    frect.w *= renderer->scale.x;
+    frect.h *= renderer->scale.y;
 
-    fcenter.x = real_center.x * renderer->scale.x;
-    fcenter.y = real_center.y * renderer->scale.y;
+    fcenter.x *= renderer->scale.x;
+    fcenter.y *= renderer->scale.y;
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
 
     return renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
 }
 
+int
+SDL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Vertex * vertices, int num_vertices,
+                   const int *indices, int num_indices)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (indices) {
+        if (num_indices < 0 || (num_indices % 3) != 0) {
+            return SDL_InvalidParamError("num_indices");
+        }
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Vertex index %d out of range", indices[i]);
+            }
+        }
+    } else if ((num_vertices % 3) != 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (!renderer->RenderGeometry) {
+        return SDL_SetError("Renderer does not support RenderGeometry");
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+    if ((indices ? num_indices : num_vertices) == 0) {
+        return 0;
+    }
+
+    if (texture && texture->page) {
+        /* Map the texture coordinates onto the page */
+        SDL_Texture *page = texture->page->texture;
+        const float u0 = (float) texture->page_rect.x / page->w;
+        const float v0 = (float) texture->page_rect.y / page->h;
+        const float du = (float) texture->w / page->w;
+        const float dv = (float) texture->h / page->h;
+        SDL_Vertex *page_vertices;
+
+        page_vertices = (SDL_Vertex *) GetRenderScratch(renderer, num_vertices * sizeof(*page_vertices));
+        if (!page_vertices) {
+            return -1;
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            page_vertices[i] = vertices[i];
+            page_vertices[i].tex_coord.x = u0 + vertices[i].tex_coord.x * du;
+            page_vertices[i].tex_coord.y = v0 + vertices[i].tex_coord.y * dv;
+        }
+        vertices = page_vertices;
+        texture = GetAtlasPage(texture, NULL);
+    }
+    if (texture && texture->native) {
+        texture = texture->native;
+    }
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
+    return renderer->RenderGeometry(renderer, texture, vertices, num_vertices,
+                                    indices, num_indices);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -1801,6 +2765,10 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return SDL_Unsupported();
     }
 
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
     }
@@ -1826,15 +2794,177 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                       format, pixels, pitch);
 }
 
+static int
+CaptureReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    int retval;
+
+    if (readback->rect.w == 0 || readback->rect.h == 0) {
+        readback->captured = SDL_TRUE;
+        readback->complete = SDL_TRUE;
+        return 0;
+    }
+
+    if (renderer->CaptureReadback) {
+        retval = renderer->CaptureReadback(renderer, readback);
+    } else {
+        retval = renderer->RenderReadPixels(renderer, &readback->rect,
+                                            readback->format,
+                                            readback->pixels, readback->pitch);
+        readback->complete = (retval == 0);
+    }
+    /* A failed capture is retried, and reported, when the result is asked for */
+    readback->captured = (retval == 0);
+    return retval;
+}
+
+SDL_RenderReadback *
+SDL_RenderReadPixelsAsync(SDL_Renderer * renderer, const SDL_Rect * rect,
+                          Uint32 format)
+{
+    SDL_RenderReadback *readback;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels && !renderer->CaptureReadback) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    if (!format) {
+        format = SDL_GetWindowPixelFormat(renderer->window);
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_SetError("Readback format must be a packed pixel format");
+        return NULL;
+    }
+
+    readback = (SDL_RenderReadback *) SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    readback->magic = &readback_magic;
+    readback->format = format;
+    readback->renderer = renderer;
+
+    readback->rect = renderer->viewport;
+    if (rect && !SDL_IntersectRect(rect, &readback->rect, &readback->rect)) {
+        readback->rect.w = readback->rect.h = 0;
+    }
+    readback->pitch = readback->rect.w * SDL_BYTESPERPIXEL(format);
+    readback->pixels = SDL_malloc(readback->rect.h * readback->pitch + 1);
+    if (!readback->pixels) {
+        SDL_free(readback);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    readback->next = renderer->readbacks;
+    if (renderer->readbacks) {
+        renderer->readbacks->prev = readback;
+    }
+    renderer->readbacks = readback;
+
+    return readback;
+}
+
+SDL_bool
+SDL_RenderReadbackComplete(SDL_RenderReadback * readback)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_READBACK_MAGIC(readback, SDL_FALSE);
+
+    renderer = readback->renderer;
+    if (readback->complete) {
+        return SDL_TRUE;
+    }
+    if (!readback->captured) {
+        return SDL_FALSE;
+    }
+    return renderer->PollReadback ? renderer->PollReadback(renderer, readback) : SDL_TRUE;
+}
+
+int
+SDL_GetRenderReadbackPixels(SDL_RenderReadback * readback,
+                            const void **pixels, int *pitch)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_READBACK_MAGIC(readback, -1);
+
+    renderer = readback->renderer;
+    if (!readback->captured) {
+        if (FlushRenderCommands(renderer) < 0) {
+            return -1;
+        }
+        if (CaptureReadback(renderer, readback) < 0) {
+            return -1;
+        }
+    }
+    if (!readback->complete) {
+        if (renderer->FinishReadback(renderer, readback) < 0) {
+            return -1;
+        }
+        readback->complete = SDL_TRUE;
+    }
+
+    if (pixels) {
+        *pixels = readback->pixels;
+    }
+    if (pitch) {
+        *pitch = readback->pitch;
+    }
+    return 0;
+}
+
+void
+SDL_FreeRenderReadback(SDL_RenderReadback * readback)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_READBACK_MAGIC(readback, );
+
+    renderer = readback->renderer;
+    readback->magic = NULL;
+
+    if (readback->next) {
+        readback->next->prev = readback->prev;
+    }
+    if (readback->prev) {
+        readback->prev->next = readback->next;
+    } else {
+        renderer->readbacks = readback->next;
+    }
+
+    if (renderer->DestroyReadback) {
+        renderer->DestroyReadback(renderer, readback);
+    }
+    SDL_free(readback->pixels);
+    SDL_free(readback);
+}
+
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
+    SDL_RenderReadback *readback;
+
     CHECK_RENDERER_MAGIC(renderer, );
 
     /* Don't draw while we're hidden */
     if (renderer->hidden) {
         return;
     }
+    FlushRenderCommands(renderer);
+
+    /* Readbacks requested during this frame see it just as it's presented */
+    for (readback = renderer->readbacks; readback; readback = readback->next) {
+        if (!readback->captured) {
+            CaptureReadback(renderer, readback);
+        }
+    }
+
     renderer->RenderPresent(renderer);
 }
 
@@ -1845,10 +2975,16 @@ SDL_DestroyTexture(SDL_Texture * texture)
 
     CHECK_TEXTURE_MAGIC(texture, );
 
+    if (texture->atlas) {
+        DestroyAtlasTexture(texture);
+        return;
+    }
+
     renderer = texture->renderer;
     if (texture == renderer->target) {
         SDL_SetRenderTarget(renderer, NULL);
     }
+    FlushRenderCommands(renderer);
 
     texture->magic = NULL;
 
@@ -1880,11 +3016,26 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
-    /* Free existing textures for this renderer */
+    /* Drop anything that was never flushed */
+    renderer->num_commands = 0;
+    renderer->num_batch_rects = 0;
+
+    /* Free existing readbacks, atlases and textures for this renderer */
+    while (renderer->readbacks) {
+        SDL_FreeRenderReadback(renderer->readbacks);
+    }
+    while (renderer->atlases) {
+        SDL_DestroyTextureAtlas(renderer->atlases);
+    }
     while (renderer->textures) {
         SDL_DestroyTexture(renderer->textures);
     }
 
+    SDL_free(renderer->commands);
+    SDL_free(renderer->batch_srcrects);
+    SDL_free(renderer->batch_dstrects);
+    SDL_free(renderer->scratch);
+
     if (renderer->window) {
         SDL_SetWindowData(renderer->window, SDL_WINDOWRENDERDATA, NULL);
     }
@@ -1902,8 +3053,11 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
+    FlushRenderCommands(renderer);
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
+    } else if (texture->page) {
+        return SDL_SetError("Can't bind a texture packed into an atlas");
     } else if (renderer && renderer->GL_BindTexture) {
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
@@ -1919,6 +3073,8 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
     renderer = texture->renderer;
     if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
+    } else if (texture->page) {
+        return SDL_SetError("Can't bind a texture packed into an atlas");
     } else if (renderer && renderer->GL_UnbindTexture) {
         return renderer->GL_UnbindTexture(renderer, texture);
     }
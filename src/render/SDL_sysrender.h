@@ -26,24 +26,47 @@
 #include "SDL_render.h"
 #include "SDL_events.h"
 #include "SDL_yuv_sw_c.h"
+#include "SDL_rectpack.h"
 
 /* The SDL 2D rendering system */
 
 typedef struct SDL_RenderDriver SDL_RenderDriver;
 
+/* A run of consecutive quads drawn with the same state, see SDL_RenderFlush() */
 typedef struct
 {
-    float x;
-    float y;
-} SDL_FPoint;
-
-typedef struct
+    SDL_Texture *texture;       /**< The texture to copy from, or NULL for fills */
+    Uint8 r, g, b, a;           /**< Texture modulation or fill color */
+    SDL_BlendMode blendMode;    /**< The blend mode */
+    int first;                  /**< Index of the first quad in the batch arrays */
+    int count;                  /**< The number of quads */
+} SDL_RenderCommand;
+
+/* A texture shared by the textures of an atlas, see SDL_CreateTextureAtlas() */
+typedef struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    SDL_RectPacker *packer;
+    int count;                  /**< The number of textures packed into it */
+    struct SDL_AtlasPage *next;
+} SDL_AtlasPage;
+
+/* Define the SDL texture atlas structure */
+struct SDL_TextureAtlas
 {
-    float x;
-    float y;
-    float w;
-    float h;
-} SDL_FRect;
+    const void *magic;
+    Uint32 format;              /**< The pixel format of the pages */
+    int page_w;                 /**< The width of the pages */
+    int page_h;                 /**< The height of the pages */
+
+    SDL_Renderer *renderer;
+
+    SDL_AtlasPage *pages;
+    SDL_Texture *textures;      /**< The textures packed into the pages */
+
+    SDL_TextureAtlas *prev;
+    SDL_TextureAtlas *next;
+};
 
 /* Define the SDL texture structure */
 struct SDL_Texture
@@ -66,12 +89,36 @@ struct SDL_Texture
     int pitch;
     SDL_Rect locked_rect;
 
+    /* Support for textures packed into an atlas page, these have no driverdata */
+    SDL_TextureAtlas *atlas;
+    SDL_AtlasPage *page;
+    SDL_Rect page_rect;         /**< The area of the page, without padding */
+
     void *driverdata;           /**< Driver specific texture representation */
 
     SDL_Texture *prev;
     SDL_Texture *next;
 };
 
+/* Define the SDL readback structure, see SDL_RenderReadPixelsAsync() */
+struct SDL_RenderReadback
+{
+    const void *magic;
+    SDL_Rect rect;              /**< The area to read, clipped to the viewport */
+    Uint32 format;              /**< The pixel format of the result */
+    void *pixels;               /**< The result, once complete */
+    int pitch;
+    SDL_bool captured;          /**< The read has been issued */
+    SDL_bool complete;          /**< The result is in pixels */
+
+    SDL_Renderer *renderer;
+
+    void *driverdata;           /**< Driver specific readback representation */
+
+    SDL_RenderReadback *prev;
+    SDL_RenderReadback *next;
+};
+
 /* Define the SDL renderer structure */
 struct SDL_Renderer
 {
@@ -112,8 +159,22 @@ struct SDL_Renderer
     int (*RenderCopyEx) (SDL_Renderer * renderer, SDL_Texture * texture,
                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    /* Draws the whole queue, in order; the commands index into the rect arrays */
+    int (*RenderBatch) (SDL_Renderer * renderer,
+                        const SDL_RenderCommand * cmds, int num_commands,
+                        const SDL_Rect * srcrects, const SDL_FRect * dstrects);
+    /* Vertex positions are unscaled, indices have been validated */
+    int (*RenderGeometry) (SDL_Renderer * renderer, SDL_Texture * texture,
+                           const SDL_Vertex * vertices, int num_vertices,
+                           const int *indices, int num_indices);
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
+    /* Optional: the read is issued by CaptureReadback, polled without
+       blocking, and converted into readback->pixels by FinishReadback */
+    int (*CaptureReadback) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
+    SDL_bool (*PollReadback) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
+    int (*FinishReadback) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
+    void (*DestroyReadback) (SDL_Renderer * renderer, SDL_RenderReadback * readback);
     void (*RenderPresent) (SDL_Renderer * renderer);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
 
@@ -155,9 +216,29 @@ struct SDL_Renderer
     SDL_Texture *textures;
     SDL_Texture *target;
 
+    /* The list of texture atlases */
+    SDL_TextureAtlas *atlases;
+
+    /* The list of readbacks, those not yet captured wait for the next present */
+    SDL_RenderReadback *readbacks;
+
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
+    /* Copies and fills recorded until the next SDL_RenderFlush() */
+    SDL_bool batching;
+    SDL_RenderCommand *commands;
+    int num_commands;
+    int max_commands;
+    SDL_Rect *batch_srcrects;
+    SDL_FRect *batch_dstrects;
+    int num_batch_rects;
+    int max_batch_rects;
+
+    /* Scratch space for converting coordinates, kept between calls */
+    void *scratch;
+    size_t scratch_size;
+
     void *driverdata;
 };
 
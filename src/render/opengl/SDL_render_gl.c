@@ -82,8 +82,18 @@ static int GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+static int GL_RenderBatch(SDL_Renderer * renderer,
+                          const SDL_RenderCommand * cmds, int num_commands,
+                          const SDL_Rect * srcrects, const SDL_FRect * dstrects);
+static int GL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Vertex * vertices, int num_vertices,
+                             const int *indices, int num_indices);
 static int GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                Uint32 pixel_format, void * pixels, int pitch);
+static int GL_CaptureReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
+static SDL_bool GL_PollReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
+static int GL_FinishReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
+static void GL_DestroyReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
 static void GL_RenderPresent(SDL_Renderer * renderer);
 static void GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture);
 static void GL_DestroyRenderer(SDL_Renderer * renderer);
@@ -127,8 +137,21 @@ typedef struct
         GL_Shader shader;
         Uint32 color;
         int blendMode;
+        GLenum texture_type;        /* target enabled on unit 0, or 0 */
+        int texture_unit;
+        GLenum texture_types[3];    /* 0 if the binding is unknown */
+        GLuint textures[3];
+        Uint32 client_arrays;
+        int scissor_enabled;        /* -1 if unknown */
+        SDL_Rect scissor;
+        SDL_Rect viewport;
+        SDL_bool viewport_target;
+        SDL_bool viewport_valid;
     } current;
 
+    /* Number of redundant state changes skipped, for profiling */
+    Uint32 calls_saved;
+
     SDL_bool GL_EXT_framebuffer_object_supported;
     GL_FBOList *framebuffers;
 
@@ -148,9 +171,28 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Pixel buffer object support, for streaming texture uploads */
+    SDL_bool GL_ARB_pixel_buffer_object_supported;
+    PFNGLGENBUFFERSARBPROC glGenBuffersARB;
+    PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB;
+    PFNGLBINDBUFFERARBPROC glBindBufferARB;
+    PFNGLBUFFERDATAARBPROC glBufferDataARB;
+    PFNGLMAPBUFFERARBPROC glMapBufferARB;
+    PFNGLUNMAPBUFFERARBPROC glUnmapBufferARB;
+
+    /* Sync object support, for asynchronous readback */
+    SDL_bool GL_ARB_sync_supported;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
+    /* Scratch space for batched quads */
+    GLfloat *batch_vertices;
+    int max_batch_vertices;
+
 } GL_RenderData;
 
 typedef struct
@@ -171,9 +213,21 @@ typedef struct
     GLuint utexture;
     GLuint vtexture;
 
+    /* Streaming textures alternate between two pixel buffer objects */
+    GLuint pbos[2];
+    int pbo;
+    size_t pbo_size;
+    void *pbo_pixels;   /* mapped buffer while the texture is locked */
+
     GL_FBOList *fbo;
 } GL_TextureData;
 
+typedef struct
+{
+    GLuint pbo;         /* receives the pixels, bottom-up in ARGB8888 */
+    GLsync fence;       /* signaled once the read has landed in pbo */
+} GL_ReadbackData;
+
 SDL_FORCE_INLINE const char*
 GL_TranslateError (GLenum error)
 {
@@ -307,11 +361,100 @@ GL_ActivateRenderer(SDL_Renderer * renderer)
     return 0;
 }
 
+/* Client arrays enabled through GL_SetClientArrays() */
+#define GL_ARRAY_VERTEX     0x01
+#define GL_ARRAY_TEXCOORD   0x02
+#define GL_ARRAY_COLOR      0x04
+
+/* Texturing is only ever enabled on unit 0, and the active unit is always
+   switched back to 0 before any call that operates on the active unit.
+ */
+static void
+GL_SelectTextureUnit(GL_RenderData * data, int unit)
+{
+    if (unit == data->current.texture_unit) {
+        ++data->calls_saved;
+        return;
+    }
+    data->glActiveTextureARB(GL_TEXTURE0_ARB + unit);
+    data->current.texture_unit = unit;
+}
+
+static void
+GL_BindTextureUnit(GL_RenderData * data, int unit, GLenum type, GLuint texture)
+{
+    if (type == data->current.texture_types[unit] &&
+        texture == data->current.textures[unit]) {
+        ++data->calls_saved;
+        return;
+    }
+    if (unit != data->current.texture_unit) {
+        GL_SelectTextureUnit(data, unit);
+    }
+    data->glBindTexture(type, texture);
+    data->current.texture_types[unit] = type;
+    data->current.textures[unit] = texture;
+}
+
+static void
+GL_SetTextureType(GL_RenderData * data, GLenum type)
+{
+    if (type == data->current.texture_type) {
+        ++data->calls_saved;
+        return;
+    }
+    if (data->current.texture_type) {
+        data->glDisable(data->current.texture_type);
+    }
+    if (type) {
+        data->glEnable(type);
+    }
+    data->current.texture_type = type;
+}
+
+static void
+GL_SetClientArrays(GL_RenderData * data, Uint32 arrays)
+{
+    const Uint32 changed = arrays ^ data->current.client_arrays;
+
+    if (!changed) {
+        ++data->calls_saved;
+        return;
+    }
+    if (changed & GL_ARRAY_VERTEX) {
+        if (arrays & GL_ARRAY_VERTEX) {
+            data->glEnableClientState(GL_VERTEX_ARRAY);
+        } else {
+            data->glDisableClientState(GL_VERTEX_ARRAY);
+        }
+    }
+    if (changed & GL_ARRAY_TEXCOORD) {
+        if (arrays & GL_ARRAY_TEXCOORD) {
+            data->glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        } else {
+            data->glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+    }
+    if (changed & GL_ARRAY_COLOR) {
+        if (arrays & GL_ARRAY_COLOR) {
+            data->glEnableClientState(GL_COLOR_ARRAY);
+        } else {
+            data->glDisableClientState(GL_COLOR_ARRAY);
+        }
+    }
+    data->current.client_arrays = arrays;
+}
+
 /* This is called if we need to invalidate all of the SDL OpenGL state */
 static void
 GL_ResetState(SDL_Renderer *renderer)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    int i;
+
+    data->current.viewport_valid = SDL_FALSE;
+    data->current.scissor_enabled = -1;
+    data->current.scissor.w = -1;
 
     if (SDL_GL_GetCurrentContext() == data->context) {
         GL_UpdateViewport(renderer);
@@ -323,6 +466,26 @@ GL_ResetState(SDL_Renderer *renderer)
     data->current.color = 0;
     data->current.blendMode = -1;
 
+    /* Put the texture state somewhere we know about */
+    if (data->GL_ARB_multitexture_supported) {
+        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    }
+    data->current.texture_unit = 0;
+    for (i = 0; i < SDL_arraysize(data->current.textures); ++i) {
+        data->current.texture_types[i] = 0;
+        data->current.textures[i] = 0;
+    }
+    data->glDisable(GL_TEXTURE_2D);
+    if (data->GL_ARB_texture_rectangle_supported) {
+        data->glDisable(GL_TEXTURE_RECTANGLE_ARB);
+    }
+    data->current.texture_type = 0;
+
+    data->glDisableClientState(GL_VERTEX_ARRAY);
+    data->glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    data->glDisableClientState(GL_COLOR_ARRAY);
+    data->current.client_arrays = 0;
+
     data->glDisable(GL_DEPTH_TEST);
     data->glDisable(GL_CULL_FACE);
     /* This ended up causing video discrepancies between OpenGL and Direct3D */
@@ -443,7 +606,13 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->RenderFillRects = GL_RenderFillRects;
     renderer->RenderCopy = GL_RenderCopy;
     renderer->RenderCopyEx = GL_RenderCopyEx;
+    renderer->RenderBatch = GL_RenderBatch;
+    renderer->RenderGeometry = GL_RenderGeometry;
     renderer->RenderReadPixels = GL_RenderReadPixels;
+    renderer->CaptureReadback = GL_CaptureReadback;
+    renderer->PollReadback = GL_PollReadback;
+    renderer->FinishReadback = GL_FinishReadback;
+    renderer->DestroyReadback = GL_DestroyReadback;
     renderer->RenderPresent = GL_RenderPresent;
     renderer->DestroyTexture = GL_DestroyTexture;
     renderer->DestroyRenderer = GL_DestroyRenderer;
@@ -563,6 +732,39 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     }
     data->framebuffers = NULL;
 
+    if (SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object") &&
+        SDL_GL_ExtensionSupported("GL_ARB_vertex_buffer_object")) {
+        data->glGenBuffersARB = (PFNGLGENBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glGenBuffersARB");
+        data->glDeleteBuffersARB = (PFNGLDELETEBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glDeleteBuffersARB");
+        data->glBindBufferARB = (PFNGLBINDBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glBindBufferARB");
+        data->glBufferDataARB = (PFNGLBUFFERDATAARBPROC)
+            SDL_GL_GetProcAddress("glBufferDataARB");
+        data->glMapBufferARB = (PFNGLMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glMapBufferARB");
+        data->glUnmapBufferARB = (PFNGLUNMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glUnmapBufferARB");
+        if (data->glGenBuffersARB && data->glDeleteBuffersARB &&
+            data->glBindBufferARB && data->glBufferDataARB &&
+            data->glMapBufferARB && data->glUnmapBufferARB) {
+            data->GL_ARB_pixel_buffer_object_supported = SDL_TRUE;
+        }
+    }
+
+    if (SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glFenceSync = (PFNGLFENCESYNCPROC)
+            SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+            SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)
+            SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->GL_ARB_sync_supported = SDL_TRUE;
+        }
+    }
+
     /* Set up parameters for rendering */
     GL_ResetState(renderer);
 
@@ -694,6 +896,26 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
             SDL_free(data);
             return SDL_OutOfMemory();
         }
+
+        /* Upload through pixel buffers so the copy into the texture can
+           happen asynchronously, while the application fills the next frame.
+         */
+        if (renderdata->GL_ARB_pixel_buffer_object_supported
+#ifdef __MACOSX__
+            /* Apple client storage already uploads straight from our pixels */
+            && !(texture->format == SDL_PIXELFORMAT_ARGB8888 && (texture->w % 8) == 0)
+#endif
+           ) {
+            int i;
+
+            data->pbo_size = size;
+            renderdata->glGenBuffersARB(SDL_arraysize(data->pbos), data->pbos);
+            for (i = 0; i < SDL_arraysize(data->pbos); ++i) {
+                renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, data->pbos[i]);
+                renderdata->glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size, NULL, GL_STREAM_DRAW_ARB);
+            }
+            renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        }
     }
 
     if (texture->access == SDL_TEXTUREACCESS_TARGET) {
@@ -736,8 +958,7 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     data->format = format;
     data->formattype = type;
     scaleMode = GetScaleQuality();
-    renderdata->glEnable(data->type);
-    renderdata->glBindTexture(data->type, data->texture);
+    GL_BindTextureUnit(renderdata, 0, data->type, data->texture);
     renderdata->glTexParameteri(data->type, GL_TEXTURE_MIN_FILTER, scaleMode);
     renderdata->glTexParameteri(data->type, GL_TEXTURE_MAG_FILTER, scaleMode);
     /* According to the spec, CLAMP_TO_EDGE is the default for TEXTURE_RECTANGLE
@@ -783,7 +1004,6 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         renderdata->glTexImage2D(data->type, 0, internalFormat, texture_w,
                                  texture_h, 0, format, type, NULL);
     }
-    renderdata->glDisable(data->type);
     if (GL_CheckError("glTexImage2D()", renderer) < 0) {
         return -1;
     }
@@ -794,9 +1014,8 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 
         renderdata->glGenTextures(1, &data->utexture);
         renderdata->glGenTextures(1, &data->vtexture);
-        renderdata->glEnable(data->type);
 
-        renderdata->glBindTexture(data->type, data->utexture);
+        GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MIN_FILTER,
                                     scaleMode);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MAG_FILTER,
@@ -808,7 +1027,7 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         renderdata->glTexImage2D(data->type, 0, internalFormat, texture_w/2,
                                  texture_h/2, 0, format, type, NULL);
 
-        renderdata->glBindTexture(data->type, data->vtexture);
+        GL_BindTextureUnit(renderdata, 0, data->type, data->vtexture);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MIN_FILTER,
                                     scaleMode);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MAG_FILTER,
@@ -819,8 +1038,6 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
                                     GL_CLAMP_TO_EDGE);
         renderdata->glTexImage2D(data->type, 0, internalFormat, texture_w/2,
                                  texture_h/2, 0, format, type, NULL);
-
-        renderdata->glDisable(data->type);
     }
 
     if (texture->format == SDL_PIXELFORMAT_NV12 ||
@@ -828,9 +1045,8 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         data->nv12 = SDL_TRUE;
 
         renderdata->glGenTextures(1, &data->utexture);
-        renderdata->glEnable(data->type);
 
-        renderdata->glBindTexture(data->type, data->utexture);
+        GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MIN_FILTER,
                                     scaleMode);
         renderdata->glTexParameteri(data->type, GL_TEXTURE_MAG_FILTER,
@@ -841,15 +1057,15 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
                                     GL_CLAMP_TO_EDGE);
         renderdata->glTexImage2D(data->type, 0, GL_LUMINANCE_ALPHA, texture_w/2,
                                  texture_h/2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
-        renderdata->glDisable(data->type);
     }
 
     return GL_CheckError("", renderer);
 }
 
+/* If a pixel buffer is bound, the pixel pointers are offsets into it */
 static int
-GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
-                 const SDL_Rect * rect, const void *pixels, int pitch)
+GL_TexSubImage(SDL_Renderer * renderer, SDL_Texture * texture,
+               const SDL_Rect * rect, const void *pixels, int pitch)
 {
     GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
@@ -857,10 +1073,7 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 
     SDL_assert(texturebpp != 0);  /* otherwise, division by zero later. */
 
-    GL_ActivateRenderer(renderer);
-
-    renderdata->glEnable(data->type);
-    renderdata->glBindTexture(data->type, data->texture);
+    GL_BindTextureUnit(renderdata, 0, data->type, data->texture);
     renderdata->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (pitch / texturebpp));
     renderdata->glTexSubImage2D(data->type, 0, rect->x, rect->y, rect->w,
@@ -872,9 +1085,9 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + rect->h * pitch);
         if (texture->format == SDL_PIXELFORMAT_YV12) {
-            renderdata->glBindTexture(data->type, data->vtexture);
+            GL_BindTextureUnit(renderdata, 0, data->type, data->vtexture);
         } else {
-            renderdata->glBindTexture(data->type, data->utexture);
+            GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
         }
         renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
                                     rect->w/2, rect->h/2,
@@ -883,9 +1096,9 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + (rect->h * pitch)/4);
         if (texture->format == SDL_PIXELFORMAT_YV12) {
-            renderdata->glBindTexture(data->type, data->utexture);
+            GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
         } else {
-            renderdata->glBindTexture(data->type, data->vtexture);
+            GL_BindTextureUnit(renderdata, 0, data->type, data->vtexture);
         }
         renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
                                     rect->w/2, rect->h/2,
@@ -897,30 +1110,26 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + rect->h * pitch);
-        renderdata->glBindTexture(data->type, data->utexture);
+        GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
         renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
                                     rect->w/2, rect->h/2,
                                     GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, pixels);
     }
-    renderdata->glDisable(data->type);
 
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
 static int
-GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
-                    const SDL_Rect * rect,
-                    const Uint8 *Yplane, int Ypitch,
-                    const Uint8 *Uplane, int Upitch,
-                    const Uint8 *Vplane, int Vpitch)
+GL_TexSubImageYUV(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Rect * rect,
+                  const Uint8 *Yplane, int Ypitch,
+                  const Uint8 *Uplane, int Upitch,
+                  const Uint8 *Vplane, int Vpitch)
 {
     GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
 
-    GL_ActivateRenderer(renderer);
-
-    renderdata->glEnable(data->type);
-    renderdata->glBindTexture(data->type, data->texture);
+    GL_BindTextureUnit(renderdata, 0, data->type, data->texture);
     renderdata->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Ypitch);
     renderdata->glTexSubImage2D(data->type, 0, rect->x, rect->y, rect->w,
@@ -928,30 +1137,139 @@ GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                                 Yplane);
 
     renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Upitch);
-    renderdata->glBindTexture(data->type, data->utexture);
+    GL_BindTextureUnit(renderdata, 0, data->type, data->utexture);
     renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
                                 rect->w/2, rect->h/2,
                                 data->format, data->formattype, Uplane);
 
     renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Vpitch);
-    renderdata->glBindTexture(data->type, data->vtexture);
+    GL_BindTextureUnit(renderdata, 0, data->type, data->vtexture);
     renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
                                 rect->w/2, rect->h/2,
                                 data->format, data->formattype, Vplane);
-    renderdata->glDisable(data->type);
 
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
+/* Maps the next pixel buffer of a streaming texture, and leaves it bound */
+static void *
+GL_MapPixelBuffer(GL_RenderData * renderdata, GL_TextureData * data)
+{
+    /* Orphan the storage, so we never wait on the upload of an earlier frame */
+    data->pbo = (data->pbo + 1) % SDL_arraysize(data->pbos);
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, data->pbos[data->pbo]);
+    renderdata->glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, data->pbo_size, NULL, GL_STREAM_DRAW_ARB);
+    return renderdata->glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+}
+
+static size_t
+GL_GetPlaneLength(int w, int h, int pitch)
+{
+    return (h > 0) ? ((size_t) (h - 1) * pitch + w) : 0;
+}
+
+static int
+GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
+                 const SDL_Rect * rect, const void *pixels, int pitch)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    size_t length;
+    void *dst;
+    int status;
+
+    GL_ActivateRenderer(renderer);
+
+    if (!data->pbos[0]) {
+        return GL_TexSubImage(renderer, texture, rect, pixels, pitch);
+    }
+
+    if (data->yuv) {
+        /* The chroma planes follow the luma plane, at the offsets
+           GL_TexSubImage() reads them from */
+        length = (size_t) rect->h * pitch + ((size_t) rect->h * pitch) / 4 +
+                 GL_GetPlaneLength(rect->w / 2, rect->h / 2, pitch / 2);
+    } else if (data->nv12) {
+        length = (size_t) rect->h * pitch +
+                 GL_GetPlaneLength((rect->w / 2) * 2, rect->h / 2, pitch);
+    } else {
+        length = GL_GetPlaneLength(rect->w * SDL_BYTESPERPIXEL(texture->format), rect->h, pitch);
+    }
+    if (length > data->pbo_size || !(dst = GL_MapPixelBuffer(renderdata, data))) {
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        return GL_TexSubImage(renderer, texture, rect, pixels, pitch);
+    }
+
+    /* Copying into the buffer is fast, the driver uploads it asynchronously */
+    SDL_memcpy(dst, pixels, length);
+    renderdata->glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+    status = GL_TexSubImage(renderer, texture, rect, NULL, pitch);
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+    return status;
+}
+
+static int
+GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * rect,
+                    const Uint8 *Yplane, int Ypitch,
+                    const Uint8 *Uplane, int Upitch,
+                    const Uint8 *Vplane, int Vpitch)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    const size_t Ylength = GL_GetPlaneLength(rect->w, rect->h, Ypitch);
+    const size_t Ulength = GL_GetPlaneLength(rect->w / 2, rect->h / 2, Upitch);
+    const size_t Vlength = GL_GetPlaneLength(rect->w / 2, rect->h / 2, Vpitch);
+    Uint8 *dst;
+    int status;
+
+    GL_ActivateRenderer(renderer);
+
+    if (!data->pbos[0]) {
+        return GL_TexSubImageYUV(renderer, texture, rect, Yplane, Ypitch,
+                                 Uplane, Upitch, Vplane, Vpitch);
+    }
+
+    if (Ylength + Ulength + Vlength > data->pbo_size ||
+        !(dst = (Uint8 *) GL_MapPixelBuffer(renderdata, data))) {
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        return GL_TexSubImageYUV(renderer, texture, rect, Yplane, Ypitch,
+                                 Uplane, Upitch, Vplane, Vpitch);
+    }
+
+    /* Pack the planes one after another and upload them from the buffer */
+    SDL_memcpy(dst, Yplane, Ylength);
+    SDL_memcpy(dst + Ylength, Uplane, Ulength);
+    SDL_memcpy(dst + Ylength + Ulength, Vplane, Vlength);
+    renderdata->glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+    status = GL_TexSubImageYUV(renderer, texture, rect, NULL, Ypitch,
+                               (const Uint8 *) NULL + Ylength, Upitch,
+                               (const Uint8 *) NULL + Ylength + Ulength, Vpitch);
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+    return status;
+}
+
 static int
 GL_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * rect, void **pixels, int *pitch)
 {
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    Uint8 *base = (Uint8 *) data->pixels;
+
+    /* Let the application write straight into a pixel buffer */
+    if (data->pbos[0]) {
+        GL_ActivateRenderer(renderer);
+        data->pbo_pixels = GL_MapPixelBuffer(renderdata, data);
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        if (data->pbo_pixels) {
+            base = (Uint8 *) data->pbo_pixels;
+        }
+    }
 
     data->locked_rect = *rect;
     *pixels =
-        (void *) ((Uint8 *) data->pixels + rect->y * data->pitch +
+        (void *) (base + rect->y * data->pitch +
                   rect->x * SDL_BYTESPERPIXEL(texture->format));
     *pitch = data->pitch;
     return 0;
@@ -960,15 +1278,26 @@ GL_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 static void
 GL_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
     const SDL_Rect *rect;
-    void *pixels;
+    size_t offset;
+
+    GL_ActivateRenderer(renderer);
 
     rect = &data->locked_rect;
-    pixels =
-        (void *) ((Uint8 *) data->pixels + rect->y * data->pitch +
-                  rect->x * SDL_BYTESPERPIXEL(texture->format));
-    GL_UpdateTexture(renderer, texture, rect, pixels, data->pitch);
+    offset = rect->y * data->pitch + rect->x * SDL_BYTESPERPIXEL(texture->format);
+
+    if (data->pbo_pixels) {
+        data->pbo_pixels = NULL;
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, data->pbos[data->pbo]);
+        if (renderdata->glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB)) {
+            GL_TexSubImage(renderer, texture, rect, (const Uint8 *) NULL + offset, data->pitch);
+        }
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        return;
+    }
+    GL_TexSubImage(renderer, texture, rect, (Uint8 *) data->pixels + offset, data->pitch);
 }
 
 static int
@@ -1001,22 +1330,33 @@ static int
 GL_UpdateViewport(SDL_Renderer * renderer)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    const SDL_bool target = renderer->target ? SDL_TRUE : SDL_FALSE;
+    SDL_Rect viewport = renderer->viewport;
 
     if (SDL_CurrentContext != data->context) {
         /* We'll update the viewport after we rebind the context */
         return 0;
     }
 
-    if (renderer->target) {
-        data->glViewport(renderer->viewport.x, renderer->viewport.y,
-                         renderer->viewport.w, renderer->viewport.h);
-    } else {
+    if (!target) {
         int w, h;
 
         SDL_GetRendererOutputSize(renderer, &w, &h);
-        data->glViewport(renderer->viewport.x, (h - renderer->viewport.y - renderer->viewport.h),
-                         renderer->viewport.w, renderer->viewport.h);
+        viewport.y = (h - renderer->viewport.y - renderer->viewport.h);
+    }
+
+    /* The projection only depends on the viewport size and orientation */
+    if (data->current.viewport_valid &&
+        data->current.viewport_target == target &&
+        SDL_memcmp(&data->current.viewport, &viewport, sizeof(viewport)) == 0) {
+        ++data->calls_saved;
+        return 0;
     }
+    data->current.viewport = viewport;
+    data->current.viewport_target = target;
+    data->current.viewport_valid = SDL_TRUE;
+
+    data->glViewport(viewport.x, viewport.y, viewport.w, viewport.h);
 
     data->glMatrixMode(GL_PROJECTION);
     data->glLoadIdentity();
@@ -1045,17 +1385,37 @@ GL_UpdateClipRect(SDL_Renderer * renderer)
 
     if (renderer->clipping_enabled) {
         const SDL_Rect *rect = &renderer->clip_rect;
-        data->glEnable(GL_SCISSOR_TEST);
+        SDL_Rect scissor;
+
+        scissor.x = renderer->viewport.x + rect->x;
+        scissor.w = rect->w;
+        scissor.h = rect->h;
         if (renderer->target) {
-            data->glScissor(renderer->viewport.x + rect->x, renderer->viewport.y + rect->y, rect->w, rect->h);
+            scissor.y = renderer->viewport.y + rect->y;
         } else {
             int w, h;
 
             SDL_GetRendererOutputSize(renderer, &w, &h);
-            data->glScissor(renderer->viewport.x + rect->x, h - renderer->viewport.y - rect->y - rect->h, rect->w, rect->h);
+            scissor.y = h - renderer->viewport.y - rect->y - rect->h;
         }
-    } else {
+
+        if (data->current.scissor_enabled != 1) {
+            data->glEnable(GL_SCISSOR_TEST);
+            data->current.scissor_enabled = 1;
+        } else {
+            ++data->calls_saved;
+        }
+        if (SDL_memcmp(&data->current.scissor, &scissor, sizeof(scissor)) != 0) {
+            data->glScissor(scissor.x, scissor.y, scissor.w, scissor.h);
+            data->current.scissor = scissor;
+        } else {
+            ++data->calls_saved;
+        }
+    } else if (data->current.scissor_enabled != 0) {
         data->glDisable(GL_SCISSOR_TEST);
+        data->current.scissor_enabled = 0;
+    } else {
+        ++data->calls_saved;
     }
     return 0;
 }
@@ -1066,6 +1426,8 @@ GL_SetShader(GL_RenderData * data, GL_Shader shader)
     if (data->shaders && shader != data->current.shader) {
         GL_SelectShader(data->shaders, shader);
         data->current.shader = shader;
+    } else if (data->shaders) {
+        ++data->calls_saved;
     }
 }
 
@@ -1080,6 +1442,8 @@ GL_SetColor(GL_RenderData * data, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
                         (GLfloat) b * inv255f,
                         (GLfloat) a * inv255f);
         data->current.color = color;
+    } else {
+        ++data->calls_saved;
     }
 }
 
@@ -1109,6 +1473,8 @@ GL_SetBlendMode(GL_RenderData * data, int blendMode)
             break;
         }
         data->current.blendMode = blendMode;
+    } else {
+        ++data->calls_saved;
     }
 }
 
@@ -1127,6 +1493,8 @@ GL_SetDrawingState(SDL_Renderer * renderer)
     GL_SetBlendMode(data, renderer->blendMode);
 
     GL_SetShader(data, SHADER_SOLID);
+
+    GL_SetTextureType(data, 0);
 }
 
 static int
@@ -1245,36 +1613,27 @@ GL_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 }
 
 static int
-GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture)
+GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
 
-    data->glEnable(texturedata->type);
     if (texturedata->yuv) {
-        data->glActiveTextureARB(GL_TEXTURE2_ARB);
-        data->glBindTexture(texturedata->type, texturedata->vtexture);
-
-        data->glActiveTextureARB(GL_TEXTURE1_ARB);
-        data->glBindTexture(texturedata->type, texturedata->utexture);
-
-        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+        GL_BindTextureUnit(data, 2, texturedata->type, texturedata->vtexture);
+        GL_BindTextureUnit(data, 1, texturedata->type, texturedata->utexture);
+        GL_SelectTextureUnit(data, 0);
     }
     if (texturedata->nv12) {
-        data->glActiveTextureARB(GL_TEXTURE1_ARB);
-        data->glBindTexture(texturedata->type, texturedata->utexture);
-
-        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+        GL_BindTextureUnit(data, 1, texturedata->type, texturedata->utexture);
+        GL_SelectTextureUnit(data, 0);
     }
-    data->glBindTexture(texturedata->type, texturedata->texture);
+    GL_BindTextureUnit(data, 0, texturedata->type, texturedata->texture);
+    GL_SetTextureType(data, texturedata->type);
 
-    if (texture->modMode) {
-        GL_SetColor(data, texture->r, texture->g, texture->b, texture->a);
-    } else {
-        GL_SetColor(data, 255, 255, 255, 255);
-    }
+    GL_SetColor(data, r, g, b, a);
 
-    GL_SetBlendMode(data, texture->blendMode);
+    GL_SetBlendMode(data, blendMode);
 
     if (texturedata->yuv) {
         GL_SetShader(data, SHADER_YUV);
@@ -1301,7 +1660,8 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
-    if (GL_SetupCopy(renderer, texture) < 0) {
+    if (GL_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                     texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1330,7 +1690,181 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     data->glVertex2f(maxx, maxy);
     data->glEnd();
 
-    data->glDisable(texturedata->type);
+    return GL_CheckError("", renderer);
+}
+
+static int
+GL_RenderCommand(SDL_Renderer * renderer, const SDL_RenderCommand * cmd,
+                 const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    SDL_Texture *texture = cmd->texture;
+    const int stride = texture ? 4 : 2;
+    const int num_vertices = cmd->count * 4;
+    GLfloat *vertices;
+    int i;
+
+    GL_ActivateRenderer(renderer);
+
+    if (num_vertices * stride > data->max_batch_vertices) {
+        vertices = (GLfloat *) SDL_realloc(data->batch_vertices, num_vertices * stride * sizeof(GLfloat));
+        if (!vertices) {
+            return SDL_OutOfMemory();
+        }
+        data->batch_vertices = vertices;
+        data->max_batch_vertices = num_vertices * stride;
+    }
+    vertices = data->batch_vertices;
+
+    /* Every quad in the run goes into one vertex array and one draw call */
+    if (texture) {
+        GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+
+        if (GL_SetupCopy(renderer, texture, cmd->r, cmd->g, cmd->b, cmd->a,
+                         cmd->blendMode) < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < cmd->count; ++i) {
+            const SDL_Rect *srcrect = &srcrects[i];
+            const SDL_FRect *dstrect = &dstrects[i];
+            const GLfloat minx = dstrect->x;
+            const GLfloat miny = dstrect->y;
+            const GLfloat maxx = dstrect->x + dstrect->w;
+            const GLfloat maxy = dstrect->y + dstrect->h;
+            const GLfloat minu = ((GLfloat) srcrect->x / texture->w) * texturedata->texw;
+            const GLfloat maxu = ((GLfloat) (srcrect->x + srcrect->w) / texture->w) * texturedata->texw;
+            const GLfloat minv = ((GLfloat) srcrect->y / texture->h) * texturedata->texh;
+            const GLfloat maxv = ((GLfloat) (srcrect->y + srcrect->h) / texture->h) * texturedata->texh;
+
+            *vertices++ = minx; *vertices++ = miny; *vertices++ = minu; *vertices++ = minv;
+            *vertices++ = maxx; *vertices++ = miny; *vertices++ = maxu; *vertices++ = minv;
+            *vertices++ = maxx; *vertices++ = maxy; *vertices++ = maxu; *vertices++ = maxv;
+            *vertices++ = minx; *vertices++ = maxy; *vertices++ = minu; *vertices++ = maxv;
+        }
+
+        GL_SetClientArrays(data, GL_ARRAY_VERTEX | GL_ARRAY_TEXCOORD);
+        data->glTexCoordPointer(2, GL_FLOAT, stride * sizeof(GLfloat), data->batch_vertices + 2);
+    } else {
+        GL_SetColor(data, cmd->r, cmd->g, cmd->b, cmd->a);
+        GL_SetBlendMode(data, cmd->blendMode);
+        GL_SetShader(data, SHADER_SOLID);
+        GL_SetTextureType(data, 0);
+        GL_SetClientArrays(data, GL_ARRAY_VERTEX);
+
+        for (i = 0; i < cmd->count; ++i) {
+            const SDL_FRect *rect = &dstrects[i];
+
+            *vertices++ = rect->x;           *vertices++ = rect->y;
+            *vertices++ = rect->x + rect->w; *vertices++ = rect->y;
+            *vertices++ = rect->x + rect->w; *vertices++ = rect->y + rect->h;
+            *vertices++ = rect->x;           *vertices++ = rect->y + rect->h;
+        }
+    }
+
+    data->glVertexPointer(2, GL_FLOAT, stride * sizeof(GLfloat), data->batch_vertices);
+    data->glDrawArrays(GL_QUADS, 0, num_vertices);
+
+    return GL_CheckError("", renderer);
+}
+
+static int
+GL_RenderBatch(SDL_Renderer * renderer,
+               const SDL_RenderCommand * cmds, int num_commands,
+               const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    int i;
+    int status = 0;
+
+    for (i = 0; i < num_commands; ++i) {
+        const SDL_RenderCommand *cmd = &cmds[i];
+
+        if (GL_RenderCommand(renderer, cmd, srcrects + cmd->first,
+                             dstrects + cmd->first) < 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+static int
+GL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Vertex * vertices, int num_vertices,
+                  const int *indices, int num_indices)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    const int stride = 8;
+    GLfloat texw = 1.0f, texh = 1.0f;
+    GLfloat mr = inv255f, mg = inv255f, mb = inv255f, ma = inv255f;
+    GLfloat *verts;
+    int i;
+
+    GL_ActivateRenderer(renderer);
+
+    if (num_vertices * stride > data->max_batch_vertices) {
+        verts = (GLfloat *) SDL_realloc(data->batch_vertices, num_vertices * stride * sizeof(GLfloat));
+        if (!verts) {
+            return SDL_OutOfMemory();
+        }
+        data->batch_vertices = verts;
+        data->max_batch_vertices = num_vertices * stride;
+    }
+    verts = data->batch_vertices;
+
+    if (texture) {
+        GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+
+        if (GL_SetupCopy(renderer, texture, 255, 255, 255, 255, texture->blendMode) < 0) {
+            return -1;
+        }
+        /* The vertex colors always modulate the texture, even when not blending */
+        data->glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        data->current.blendMode = -1;
+
+        texw = texturedata->texw;
+        texh = texturedata->texh;
+        mr = (GLfloat) texture->r * inv255f * inv255f;
+        mg = (GLfloat) texture->g * inv255f * inv255f;
+        mb = (GLfloat) texture->b * inv255f * inv255f;
+        ma = (GLfloat) texture->a * inv255f * inv255f;
+    } else {
+        GL_SetBlendMode(data, renderer->blendMode);
+        GL_SetShader(data, SHADER_SOLID);
+        GL_SetTextureType(data, 0);
+    }
+
+    for (i = 0; i < num_vertices; ++i) {
+        const SDL_Vertex *vertex = &vertices[i];
+
+        *verts++ = vertex->position.x * renderer->scale.x;
+        *verts++ = vertex->position.y * renderer->scale.y;
+        *verts++ = vertex->tex_coord.x * texw;
+        *verts++ = vertex->tex_coord.y * texh;
+        *verts++ = vertex->color.r * mr;
+        *verts++ = vertex->color.g * mg;
+        *verts++ = vertex->color.b * mb;
+        *verts++ = vertex->color.a * ma;
+    }
+
+    if (texture) {
+        GL_SetClientArrays(data, GL_ARRAY_VERTEX | GL_ARRAY_TEXCOORD | GL_ARRAY_COLOR);
+        data->glTexCoordPointer(2, GL_FLOAT, stride * sizeof(GLfloat), data->batch_vertices + 2);
+    } else {
+        GL_SetClientArrays(data, GL_ARRAY_VERTEX | GL_ARRAY_COLOR);
+    }
+    data->glVertexPointer(2, GL_FLOAT, stride * sizeof(GLfloat), data->batch_vertices);
+    data->glColorPointer(4, GL_FLOAT, stride * sizeof(GLfloat), data->batch_vertices + 4);
+
+    if (indices) {
+        data->glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_INT, indices);
+    } else {
+        data->glDrawArrays(GL_TRIANGLES, 0, num_vertices);
+    }
+
+    /* Nothing else draws with a color array, and it leaves the current color undefined */
+    GL_SetClientArrays(data, data->current.client_arrays & ~GL_ARRAY_COLOR);
+    data->current.color = 0;
+    GL_SetColor(data, 255, 255, 255, 255);
 
     return GL_CheckError("", renderer);
 }
@@ -1348,7 +1882,8 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
-    if (GL_SetupCopy(renderer, texture) < 0) {
+    if (GL_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                     texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1399,8 +1934,6 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     data->glEnd();
     data->glPopMatrix();
 
-    data->glDisable(texturedata->type);
-
     return GL_CheckError("", renderer);
 }
 
@@ -1465,6 +1998,154 @@ GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     return status;
 }
 
+static int
+GL_CaptureReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_ReadbackData *data = (GL_ReadbackData *) readback->driverdata;
+    const SDL_Rect *rect = &readback->rect;
+    GLint internalFormat;
+    GLenum format, type;
+    int w, h;
+
+    if (!renderdata->GL_ARB_pixel_buffer_object_supported) {
+        if (GL_RenderReadPixels(renderer, rect, readback->format,
+                                readback->pixels, readback->pitch) < 0) {
+            return -1;
+        }
+        readback->complete = SDL_TRUE;
+        return 0;
+    }
+
+    GL_ActivateRenderer(renderer);
+
+    if (!data) {
+        data = (GL_ReadbackData *) SDL_calloc(1, sizeof(*data));
+        if (!data) {
+            return SDL_OutOfMemory();
+        }
+        renderdata->glGenBuffersARB(1, &data->pbo);
+        readback->driverdata = data;
+    }
+
+    convert_format(renderdata, SDL_PIXELFORMAT_ARGB8888, &internalFormat, &format, &type);
+
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+
+    /* The read is queued behind the frame and lands in the buffer, not here */
+    renderdata->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, data->pbo);
+    renderdata->glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, rect->w * rect->h * 4,
+                                NULL, GL_STREAM_READ_ARB);
+    renderdata->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    renderdata->glPixelStorei(GL_PACK_ROW_LENGTH, rect->w);
+    renderdata->glReadPixels(rect->x, (h-rect->y)-rect->h, rect->w, rect->h,
+                             format, type, NULL);
+    renderdata->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+    if (renderdata->GL_ARB_sync_supported) {
+        if (data->fence) {
+            renderdata->glDeleteSync(data->fence);
+        }
+        data->fence = renderdata->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    return GL_CheckError("glReadPixels()", renderer);
+}
+
+static SDL_bool
+GL_PollReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_ReadbackData *data = (GL_ReadbackData *) readback->driverdata;
+    GLenum status;
+
+    /* Without a fence there's no telling, mapping the buffer will wait */
+    if (!data || !data->fence) {
+        return SDL_TRUE;
+    }
+
+    GL_ActivateRenderer(renderer);
+
+    status = renderdata->glClientWaitSync(data->fence, 0, 0);
+    return (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+}
+
+static int
+GL_FinishReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_ReadbackData *data = (GL_ReadbackData *) readback->driverdata;
+    const SDL_Rect *rect = &readback->rect;
+    const int temp_pitch = rect->w * 4;
+    const Uint8 *src;
+    Uint8 *dst;
+    GLenum status;
+    int row;
+    int retval = 0;
+
+    GL_ActivateRenderer(renderer);
+
+    if (data->fence) {
+        do {
+            status = renderdata->glClientWaitSync(data->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        renderdata->glDeleteSync(data->fence);
+        data->fence = NULL;
+        if (status == GL_WAIT_FAILED) {
+            return SDL_SetError("glClientWaitSync() failed");
+        }
+    }
+
+    renderdata->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, data->pbo);
+    src = (const Uint8 *) renderdata->glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+    if (!src) {
+        renderdata->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+        return SDL_SetError("glMapBufferARB() failed");
+    }
+
+    /* Convert the rows top-down while copying them out of the buffer */
+    src += (rect->h - 1) * temp_pitch;
+    dst = (Uint8 *) readback->pixels;
+    for (row = 0; row < rect->h && retval == 0; ++row) {
+        retval = SDL_ConvertPixels(rect->w, 1,
+                                   SDL_PIXELFORMAT_ARGB8888, src, temp_pitch,
+                                   readback->format, dst, readback->pitch);
+        src -= temp_pitch;
+        dst += readback->pitch;
+    }
+
+    renderdata->glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB);
+    renderdata->glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+    /* The buffer isn't needed once the result has been copied out */
+    renderdata->glDeleteBuffersARB(1, &data->pbo);
+    data->pbo = 0;
+
+    return retval;
+}
+
+static void
+GL_DestroyReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
+    GL_ReadbackData *data = (GL_ReadbackData *) readback->driverdata;
+
+    if (!data) {
+        return;
+    }
+
+    GL_ActivateRenderer(renderer);
+
+    if (data->fence) {
+        renderdata->glDeleteSync(data->fence);
+    }
+    if (data->pbo) {
+        renderdata->glDeleteBuffersARB(1, &data->pbo);
+    }
+    SDL_free(data);
+    readback->driverdata = NULL;
+}
+
 static void
 GL_RenderPresent(SDL_Renderer * renderer)
 {
@@ -1478,12 +2159,23 @@ GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    int i;
 
     GL_ActivateRenderer(renderer);
 
     if (!data) {
         return;
     }
+
+    /* Deleting a bound texture reverts that unit to texture 0 */
+    for (i = 0; i < SDL_arraysize(renderdata->current.textures); ++i) {
+        const GLuint bound = renderdata->current.textures[i];
+        if (bound && (bound == data->texture ||
+                      bound == data->utexture || bound == data->vtexture)) {
+            renderdata->current.textures[i] = 0;
+        }
+    }
+
     if (data->texture) {
         renderdata->glDeleteTextures(1, &data->texture);
     }
@@ -1491,6 +2183,9 @@ GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         renderdata->glDeleteTextures(1, &data->utexture);
         renderdata->glDeleteTextures(1, &data->vtexture);
     }
+    if (data->pbos[0]) {
+        renderdata->glDeleteBuffersARB(SDL_arraysize(data->pbos), data->pbos);
+    }
     SDL_free(data->pixels);
     SDL_free(data);
     texture->driverdata = NULL;
@@ -1502,6 +2197,10 @@ GL_DestroyRenderer(SDL_Renderer * renderer)
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
 
     if (data) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER,
+                     "OpenGL renderer skipped %u redundant state changes",
+                     (unsigned int) data->calls_saved);
+
         GL_ClearErrors(renderer);
         if (data->GL_ARB_debug_output_supported) {
             PFNGLDEBUGMESSAGECALLBACKARBPROC glDebugMessageCallbackARBFunc = (PFNGLDEBUGMESSAGECALLBACKARBPROC) SDL_GL_GetProcAddress("glDebugMessageCallbackARB");
@@ -1524,6 +2223,7 @@ GL_DestroyRenderer(SDL_Renderer * renderer)
             }
             SDL_GL_DeleteContext(data->context);
         }
+        SDL_free(data->batch_vertices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -1536,17 +2236,16 @@ GL_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, float *texw, floa
     GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
     GL_ActivateRenderer(renderer);
 
-    data->glEnable(texturedata->type);
-    if (texturedata->yuv) {
-        data->glActiveTextureARB(GL_TEXTURE2_ARB);
-        data->glBindTexture(texturedata->type, texturedata->vtexture);
-
-        data->glActiveTextureARB(GL_TEXTURE1_ARB);
-        data->glBindTexture(texturedata->type, texturedata->utexture);
+    /* The application draws with its own arrays from here on */
+    GL_SetClientArrays(data, 0);
 
-        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    if (texturedata->yuv) {
+        GL_BindTextureUnit(data, 2, texturedata->type, texturedata->vtexture);
+        GL_BindTextureUnit(data, 1, texturedata->type, texturedata->utexture);
+        GL_SelectTextureUnit(data, 0);
     }
-    data->glBindTexture(texturedata->type, texturedata->texture);
+    GL_BindTextureUnit(data, 0, texturedata->type, texturedata->texture);
+    GL_SetTextureType(data, texturedata->type);
 
     if(texw) *texw = (float)texturedata->texw;
     if(texh) *texh = (float)texturedata->texh;
@@ -1558,20 +2257,10 @@ static int
 GL_UnbindTexture (SDL_Renderer * renderer, SDL_Texture *texture)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
-    GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
     GL_ActivateRenderer(renderer);
 
-    if (texturedata->yuv) {
-        data->glActiveTextureARB(GL_TEXTURE2_ARB);
-        data->glDisable(texturedata->type);
-
-        data->glActiveTextureARB(GL_TEXTURE1_ARB);
-        data->glDisable(texturedata->type);
-
-        data->glActiveTextureARB(GL_TEXTURE0_ARB);
-    }
-
-    data->glDisable(texturedata->type);
+    /* Texturing is only ever enabled on unit 0 */
+    GL_SetTextureType(data, 0);
 
     return 0;
 }
@@ -23,24 +23,25 @@
 #if SDL_VIDEO_RENDER_OGL_ES2 && !SDL_RENDER_DISABLED
 
 #include "SDL_hints.h"
+#include "SDL_log.h"
 #include "SDL_opengles2.h"
 #include "../SDL_sysrender.h"
 #include "../../video/SDL_blit.h"
 #include "SDL_shaders_gles2.h"
 
-/* !!! FIXME: Emscripten makes these into WebGL calls, and WebGL doesn't offer
-   !!! FIXME:  client-side arrays (without an Emscripten compatibility hack,
-   !!! FIXME:  at least), but the current VBO code here is dramatically
-   !!! FIXME:  slower on actual iOS devices, even though the iOS Simulator
-   !!! FIXME:  is okay. Some time after 2.0.4 ships, we should revisit this,
-   !!! FIXME:  fix the performance bottleneck, and make everything use VBOs.
+/* Vertex data is streamed through a single buffer object that is filled
+   front to back and orphaned when it runs out of room, so a draw never has
+   to wait for the GPU to finish with an earlier one.  Emscripten (WebGL)
+   requires buffer objects; other platforms can define this to 0 to go back
+   to client-side arrays.
 */
-#ifdef __EMSCRIPTEN__
+#ifndef SDL_GLES2_USE_VBOS
 #define SDL_GLES2_USE_VBOS 1
-#else
-#define SDL_GLES2_USE_VBOS 0
 #endif
 
+/* Initial size of the streaming vertex buffer, it grows as needed */
+#define GLES2_VERTEX_BUFFER_SIZE    (256 * 1024)
+
 /* To prevent unnecessary window recreation,
  * these should match the defaults selected in SDL_GL_ResetAttributes 
  */
@@ -146,6 +147,7 @@ typedef enum
     GLES2_ATTRIBUTE_TEXCOORD = 1,
     GLES2_ATTRIBUTE_ANGLE = 2,
     GLES2_ATTRIBUTE_CENTER = 3,
+    GLES2_ATTRIBUTE_COLOR = 4,
 } GLES2_Attribute;
 
 typedef enum
@@ -178,9 +180,19 @@ typedef struct GLES2_DriverContext
 
     struct {
         int blendMode;
-        SDL_bool tex_coords;
+        Uint32 attributes;          /* mask of enabled vertex attribute arrays */
+        int texture_unit;
+        GLuint textures[3];
+        GLuint array_buffer;
+        int scissor_enabled;        /* -1 if unknown */
+        SDL_Rect scissor;
+        SDL_Rect viewport;
+        SDL_bool viewport_valid;
     } current;
 
+    /* Number of redundant state changes skipped, for profiling */
+    Uint32 calls_saved;
+
 #define SDL_PROC(ret,func,params) ret (APIENTRY *func) params;
 #include "SDL_gles2funcs.h"
 #undef SDL_PROC
@@ -195,9 +207,14 @@ typedef struct GLES2_DriverContext
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
 #if SDL_GLES2_USE_VBOS
-    GLuint vertex_buffers[4];
-    GLsizeiptr vertex_buffer_size[4];
+    GLuint vertex_buffer;
+    GLsizeiptr vertex_buffer_size;
+    GLintptr vertex_buffer_offset;
 #endif
+
+    /* Scratch space for batched quads */
+    GLfloat *batch_vertices;
+    int max_batch_vertices;
 } GLES2_DriverContext;
 
 #define GLES2_MAX_CACHED_PROGRAMS 8
@@ -376,21 +393,28 @@ static int
 GLES2_UpdateViewport(SDL_Renderer * renderer)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    SDL_Rect viewport;
 
     if (SDL_CurrentContext != data->context) {
         /* We'll update the viewport after we rebind the context */
         return 0;
     }
 
-    if (renderer->target) {
-        data->glViewport(renderer->viewport.x, renderer->viewport.y,
-                         renderer->viewport.w, renderer->viewport.h);
-    } else {
+    viewport = renderer->viewport;
+    if (!renderer->target) {
         int w, h;
 
         SDL_GetRendererOutputSize(renderer, &w, &h);
-        data->glViewport(renderer->viewport.x, (h - renderer->viewport.y - renderer->viewport.h),
-                         renderer->viewport.w, renderer->viewport.h);
+        viewport.y = (h - renderer->viewport.y - renderer->viewport.h);
+    }
+
+    if (data->current.viewport_valid &&
+        SDL_memcmp(&data->current.viewport, &viewport, sizeof(viewport)) == 0) {
+        ++data->calls_saved;
+    } else {
+        data->glViewport(viewport.x, viewport.y, viewport.w, viewport.h);
+        data->current.viewport = viewport;
+        data->current.viewport_valid = SDL_TRUE;
     }
 
     if (data->current_program) {
@@ -411,21 +435,69 @@ GLES2_UpdateClipRect(SDL_Renderer * renderer)
 
     if (renderer->clipping_enabled) {
         const SDL_Rect *rect = &renderer->clip_rect;
-        data->glEnable(GL_SCISSOR_TEST);
+        SDL_Rect scissor;
+
+        scissor.x = renderer->viewport.x + rect->x;
+        scissor.w = rect->w;
+        scissor.h = rect->h;
         if (renderer->target) {
-            data->glScissor(renderer->viewport.x + rect->x, renderer->viewport.y + rect->y, rect->w, rect->h);
+            scissor.y = renderer->viewport.y + rect->y;
         } else {
             int w, h;
 
             SDL_GetRendererOutputSize(renderer, &w, &h);
-            data->glScissor(renderer->viewport.x + rect->x, h - renderer->viewport.y - rect->y - rect->h, rect->w, rect->h);
+            scissor.y = h - renderer->viewport.y - rect->y - rect->h;
         }
-    } else {
+
+        if (data->current.scissor_enabled != 1) {
+            data->glEnable(GL_SCISSOR_TEST);
+            data->current.scissor_enabled = 1;
+        } else {
+            ++data->calls_saved;
+        }
+        if (SDL_memcmp(&data->current.scissor, &scissor, sizeof(scissor)) != 0) {
+            data->glScissor(scissor.x, scissor.y, scissor.w, scissor.h);
+            data->current.scissor = scissor;
+        } else {
+            ++data->calls_saved;
+        }
+    } else if (data->current.scissor_enabled != 0) {
         data->glDisable(GL_SCISSOR_TEST);
+        data->current.scissor_enabled = 0;
+    } else {
+        ++data->calls_saved;
     }
     return 0;
 }
 
+/* The active texture unit is always switched back to 0 before returning, so
+   anything operating on "the bound texture" can rely on unit 0 being active.
+ */
+static void
+GLES2_SelectTextureUnit(GLES2_DriverContext *data, int unit)
+{
+    if (unit == data->current.texture_unit) {
+        ++data->calls_saved;
+        return;
+    }
+    data->glActiveTexture(GL_TEXTURE0 + unit);
+    data->current.texture_unit = unit;
+}
+
+static void
+GLES2_BindTextureUnit(GLES2_DriverContext *data, int unit, GLenum type, GLuint texture)
+{
+    if (texture == data->current.textures[unit]) {
+        ++data->calls_saved;
+        return;
+    }
+    if (unit != data->current.texture_unit) {
+        GLES2_SelectTextureUnit(data, unit);
+    }
+    data->glBindTexture(type, texture);
+    data->current.textures[unit] = texture;
+}
+
 static void
 GLES2_DestroyRenderer(SDL_Renderer *renderer)
 {
@@ -433,6 +505,10 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
 
     /* Deallocate everything */
     if (data) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER,
+                     "OpenGL ES 2 renderer skipped %u redundant state changes",
+                     (unsigned int) data->calls_saved);
+
         GLES2_ActivateRenderer(renderer);
 
         {
@@ -458,6 +534,11 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             }
         }
         if (data->context) {
+#if SDL_GLES2_USE_VBOS
+            if (data->vertex_buffer) {
+                data->glDeleteBuffers(1, &data->vertex_buffer);
+            }
+#endif
             while (data->framebuffers) {
                 GLES2_FBOList *nextnode = data->framebuffers->next;
                 data->glDeleteFramebuffers(1, &data->framebuffers->FBO);
@@ -468,6 +549,7 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             SDL_GL_DeleteContext(data->context);
         }
         SDL_free(data->shader_formats);
+        SDL_free(data->batch_vertices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -578,8 +660,7 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         if (GL_CheckError("glGenTexures()", renderer) < 0) {
             return -1;
         }
-        renderdata->glActiveTexture(GL_TEXTURE2);
-        renderdata->glBindTexture(data->texture_type, data->texture_v);
+        GLES2_BindTextureUnit(renderdata, 2, data->texture_type, data->texture_v);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -590,8 +671,7 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         if (GL_CheckError("glGenTexures()", renderer) < 0) {
             return -1;
         }
-        renderdata->glActiveTexture(GL_TEXTURE1);
-        renderdata->glBindTexture(data->texture_type, data->texture_u);
+        GLES2_BindTextureUnit(renderdata, 1, data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -607,8 +687,7 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         if (GL_CheckError("glGenTexures()", renderer) < 0) {
             return -1;
         }
-        renderdata->glActiveTexture(GL_TEXTURE1);
-        renderdata->glBindTexture(data->texture_type, data->texture_u);
+        GLES2_BindTextureUnit(renderdata, 1, data->texture_type, data->texture_u);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
         renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -624,8 +703,7 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         return -1;
     }
     texture->driverdata = data;
-    renderdata->glActiveTexture(GL_TEXTURE0);
-    renderdata->glBindTexture(data->texture_type, data->texture);
+    GLES2_BindTextureUnit(renderdata, 0, data->texture_type, data->texture);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
     renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -692,7 +770,7 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     }
 
     /* Create a texture subimage with the supplied data */
-    data->glBindTexture(tdata->texture_type, tdata->texture);
+    GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x,
                     rect->y,
@@ -706,9 +784,9 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + rect->h * pitch);
         if (texture->format == SDL_PIXELFORMAT_YV12) {
-            data->glBindTexture(tdata->texture_type, tdata->texture_v);
+            GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_v);
         } else {
-            data->glBindTexture(tdata->texture_type, tdata->texture_u);
+            GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_u);
         }
         GLES2_TexSubImage2D(data, tdata->texture_type,
                 rect->x / 2,
@@ -722,9 +800,9 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + (rect->h * pitch)/4);
         if (texture->format == SDL_PIXELFORMAT_YV12) {
-            data->glBindTexture(tdata->texture_type, tdata->texture_u);
+            GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_u);
         } else {
-            data->glBindTexture(tdata->texture_type, tdata->texture_v);
+            GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_v);
         }
         GLES2_TexSubImage2D(data, tdata->texture_type,
                 rect->x / 2,
@@ -739,7 +817,7 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     if (tdata->nv12) {
         /* Skip to the correct offset into the next texture */
         pixels = (const void*)((const Uint8*)pixels + rect->h * pitch);
-        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_u);
         GLES2_TexSubImage2D(data, tdata->texture_type,
                 rect->x / 2,
                 rect->y / 2,
@@ -770,7 +848,7 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
-    data->glBindTexture(tdata->texture_type, tdata->texture_v);
+    GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_v);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x / 2,
                     rect->y / 2,
@@ -780,7 +858,7 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                     tdata->pixel_type,
                     Vplane, Vpitch, 1);
 
-    data->glBindTexture(tdata->texture_type, tdata->texture_u);
+    GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture_u);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x / 2,
                     rect->y / 2,
@@ -790,7 +868,7 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                     tdata->pixel_type,
                     Uplane, Upitch, 1);
 
-    data->glBindTexture(tdata->texture_type, tdata->texture);
+    GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture);
     GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x,
                     rect->y,
@@ -860,11 +938,21 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+    int i;
 
     GLES2_ActivateRenderer(renderer);
 
     /* Destroy the texture */
     if (tdata) {
+        /* Deleting a bound texture reverts that unit to texture 0 */
+        for (i = 0; i < SDL_arraysize(data->current.textures); ++i) {
+            const GLuint bound = data->current.textures[i];
+            if (bound && (bound == tdata->texture ||
+                          bound == tdata->texture_u || bound == tdata->texture_v)) {
+                data->current.textures[i] = 0;
+            }
+        }
+
         data->glDeleteTextures(1, &tdata->texture);
         if (tdata->texture_v) {
             data->glDeleteTextures(1, &tdata->texture_v);
@@ -943,6 +1031,7 @@ GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_ANGLE, "a_angle");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CENTER, "a_center");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
     data->glLinkProgram(entry->id);
     data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
     if (!linkSuccessful) {
@@ -1183,6 +1272,7 @@ GLES2_SelectProgram(SDL_Renderer *renderer, GLES2_ImageSource source, SDL_BlendM
     if (data->current_program &&
         data->current_program->vertex_shader == vertex &&
         data->current_program->fragment_shader == fragment) {
+        ++data->calls_saved;
         return 0;
     }
 
@@ -1257,6 +1347,8 @@ GLES2_SetOrthographicProjection(SDL_Renderer *renderer)
         const GLuint locProjection = data->current_program->uniform_locations[GLES2_UNIFORM_PROJECTION];
         data->glUniformMatrix4fv(locProjection, 1, GL_FALSE, (GLfloat *)projection);
         SDL_memcpy(data->current_program->projection, projection, sizeof (projection));
+    } else {
+        ++data->calls_saved;
     }
 
     return 0;
@@ -1277,6 +1369,12 @@ static int GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const
 static int GLES2_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+static int GLES2_RenderBatch(SDL_Renderer * renderer,
+                             const SDL_RenderCommand * cmds, int num_commands,
+                             const SDL_Rect * srcrects, const SDL_FRect * dstrects);
+static int GLES2_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                                const SDL_Vertex * vertices, int num_vertices,
+                                const int *indices, int num_indices);
 static int GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch);
 static void GLES2_RenderPresent(SDL_Renderer *renderer);
@@ -1355,27 +1453,49 @@ GLES2_SetBlendMode(GLES2_DriverContext *data, int blendMode)
             break;
         }
         data->current.blendMode = blendMode;
+    } else {
+        ++data->calls_saved;
     }
 }
 
+#define GLES2_ATTRIBUTE_MASK(attr)  (1 << (attr))
+
 static void
-GLES2_SetTexCoords(GLES2_DriverContext * data, SDL_bool enabled)
+GLES2_SetAttributes(GLES2_DriverContext * data, Uint32 attributes)
 {
-    if (enabled != data->current.tex_coords) {
-        if (enabled) {
-            data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
+    Uint32 changed;
+    int attr;
+
+    /* Every draw supplies positions */
+    attributes |= GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_POSITION);
+
+    changed = attributes ^ data->current.attributes;
+    if (!changed) {
+        ++data->calls_saved;
+        return;
+    }
+    for (attr = GLES2_ATTRIBUTE_POSITION; attr <= GLES2_ATTRIBUTE_COLOR; ++attr) {
+        if (!(changed & GLES2_ATTRIBUTE_MASK(attr))) {
+            continue;
+        }
+        if (attributes & GLES2_ATTRIBUTE_MASK(attr)) {
+            data->glEnableVertexAttribArray(attr);
         } else {
-            data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
+            data->glDisableVertexAttribArray(attr);
+            if (attr == GLES2_ATTRIBUTE_COLOR) {
+                /* Back to the constant color used by everything but geometry */
+                data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+            }
         }
-        data->current.tex_coords = enabled;
     }
+    data->current.attributes = attributes;
 }
 
 static int
-GLES2_SetDrawingState(SDL_Renderer * renderer)
+GLES2_SetSolidState(SDL_Renderer * renderer, Uint8 cr, Uint8 cg, Uint8 cb,
+                    Uint8 ca, SDL_BlendMode blendMode, Uint32 attributes)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
-    const int blendMode = renderer->blendMode;
     GLES2_ProgramCacheEntry *program;
     Uint8 r, g, b, a;
 
@@ -1383,7 +1503,7 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
 
     GLES2_SetBlendMode(data, blendMode);
 
-    GLES2_SetTexCoords(data, SDL_FALSE);
+    GLES2_SetAttributes(data, attributes);
 
     /* Activate an appropriate shader and set the projection matrix */
     if (GLES2_SelectProgram(renderer, GLES2_IMAGESOURCE_SOLID, blendMode) < 0) {
@@ -1391,17 +1511,17 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
     }
 
     /* Select the color to draw with */
-    g = renderer->g;
-    a = renderer->a;
+    g = cg;
+    a = ca;
 
     if (renderer->target &&
          (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
          renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-        r = renderer->b;
-        b = renderer->r;
+        r = cb;
+        b = cr;
      } else {
-        r = renderer->r;
-        b = renderer->b;
+        r = cr;
+        b = cb;
      }
 
     program = data->current_program;
@@ -1412,34 +1532,58 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
         program->color_g = g;
         program->color_b = b;
         program->color_a = a;
+    } else {
+        ++data->calls_saved;
     }
 
     return 0;
 }
 
+static int
+GLES2_SetDrawingState(SDL_Renderer * renderer)
+{
+    return GLES2_SetSolidState(renderer, renderer->r, renderer->g, renderer->b,
+                               renderer->a, renderer->blendMode, 0);
+}
+
 static int
 GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr,
                          const void *vertexData, size_t dataSizeInBytes)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const GLint size = (attr == GLES2_ATTRIBUTE_ANGLE) ? 1 : (attr == GLES2_ATTRIBUTE_COLOR) ? 4 : 2;
 
 #if !SDL_GLES2_USE_VBOS
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, vertexData);
+    data->glVertexAttribPointer(attr, size, GL_FLOAT, GL_FALSE, 0, vertexData);
 #else
-    if (!data->vertex_buffers[attr]) {
-        data->glGenBuffers(1, &data->vertex_buffers[attr]);
-    }
-
-    data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffers[attr]);
+    const GLsizeiptr length = (GLsizeiptr) ((dataSizeInBytes + 15) & ~15);
 
-    if (data->vertex_buffer_size[attr] < dataSizeInBytes) {
-        data->glBufferData(GL_ARRAY_BUFFER, dataSizeInBytes, vertexData, GL_STREAM_DRAW);
-        data->vertex_buffer_size[attr] = dataSizeInBytes;
+    if (!data->vertex_buffer) {
+        data->glGenBuffers(1, &data->vertex_buffer);
+    }
+    if (data->current.array_buffer != data->vertex_buffer) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_buffer);
+        data->current.array_buffer = data->vertex_buffer;
     } else {
-        data->glBufferSubData(GL_ARRAY_BUFFER, 0, dataSizeInBytes, vertexData);
+        ++data->calls_saved;
+    }
+
+    if (data->vertex_buffer_offset + length > data->vertex_buffer_size) {
+        /* Orphan the old storage instead of overwriting data that queued
+           draws may still be reading, the driver recycles it once they're done.
+         */
+        GLsizeiptr buffer_size = SDL_max(data->vertex_buffer_size, GLES2_VERTEX_BUFFER_SIZE);
+        while (buffer_size < length) {
+            buffer_size *= 2;
+        }
+        data->glBufferData(GL_ARRAY_BUFFER, buffer_size, NULL, GL_STREAM_DRAW);
+        data->vertex_buffer_size = buffer_size;
+        data->vertex_buffer_offset = 0;
     }
 
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, 0);
+    data->glBufferSubData(GL_ARRAY_BUFFER, data->vertex_buffer_offset, dataSizeInBytes, vertexData);
+    data->glVertexAttribPointer(attr, size, GL_FLOAT, GL_FALSE, 0, (const GLvoid *) (size_t) data->vertex_buffer_offset);
+    data->vertex_buffer_offset += length;
 #endif
 
     return 0;
@@ -1542,17 +1686,17 @@ GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 }
 
 static int
-GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
+GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture,
+                Uint8 mr, Uint8 mg, Uint8 mb, Uint8 ma, SDL_BlendMode blendMode,
+                Uint32 attributes)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ImageSource sourceType = GLES2_IMAGESOURCE_TEXTURE_ABGR;
-    SDL_BlendMode blendMode;
     GLES2_ProgramCacheEntry *program;
     Uint8 r, g, b, a;
 
     /* Activate an appropriate shader and set the projection matrix */
-    blendMode = texture->blendMode;
     if (renderer->target) {
         /* Check if we need to do color mapping between the source and render target textures */
         if (renderer->target->format != texture->format) {
@@ -1656,34 +1800,28 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
 
     /* Select the target texture */
     if (tdata->yuv) {
-        data->glActiveTexture(GL_TEXTURE2);
-        data->glBindTexture(tdata->texture_type, tdata->texture_v);
-
-        data->glActiveTexture(GL_TEXTURE1);
-        data->glBindTexture(tdata->texture_type, tdata->texture_u);
-
-        data->glActiveTexture(GL_TEXTURE0);
+        GLES2_BindTextureUnit(data, 2, tdata->texture_type, tdata->texture_v);
+        GLES2_BindTextureUnit(data, 1, tdata->texture_type, tdata->texture_u);
+        GLES2_SelectTextureUnit(data, 0);
     }
     if (tdata->nv12) {
-        data->glActiveTexture(GL_TEXTURE1);
-        data->glBindTexture(tdata->texture_type, tdata->texture_u);
-
-        data->glActiveTexture(GL_TEXTURE0);
+        GLES2_BindTextureUnit(data, 1, tdata->texture_type, tdata->texture_u);
+        GLES2_SelectTextureUnit(data, 0);
     }
-    data->glBindTexture(tdata->texture_type, tdata->texture);
+    GLES2_BindTextureUnit(data, 0, tdata->texture_type, tdata->texture);
 
     /* Configure color modulation */
-    g = texture->g;
-    a = texture->a;
+    g = mg;
+    a = ma;
 
     if (renderer->target &&
         (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
          renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-        r = texture->b;
-        b = texture->r;
+        r = mb;
+        b = mr;
     } else {
-        r = texture->r;
-        b = texture->b;
+        r = mr;
+        b = mb;
     }
 
     program = data->current_program;
@@ -1694,12 +1832,14 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
         program->modulation_g = g;
         program->modulation_b = b;
         program->modulation_a = a;
+    } else {
+        ++data->calls_saved;
     }
 
     /* Configure texture blending */
     GLES2_SetBlendMode(data, blendMode);
 
-    GLES2_SetTexCoords(data, SDL_TRUE);
+    GLES2_SetAttributes(data, GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_TEXCOORD) | attributes);
     return 0;
 }
 
@@ -1713,7 +1853,8 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
 
     GLES2_ActivateRenderer(renderer);
 
-    if (GLES2_SetupCopy(renderer, texture) < 0) {
+    if (GLES2_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                        texture->a, texture->blendMode, 0) < 0) {
         return -1;
     }
 
@@ -1743,6 +1884,185 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
     return GL_CheckError("", renderer);
 }
 
+static int
+GLES2_RenderCommand(SDL_Renderer * renderer, const SDL_RenderCommand * cmd,
+                    const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    SDL_Texture *texture = cmd->texture;
+    const int num_vertices = cmd->count * 6;
+    GLfloat *vertices;
+    GLfloat *texCoords;
+    int i;
+
+    GLES2_ActivateRenderer(renderer);
+
+    if (num_vertices * 4 > data->max_batch_vertices) {
+        vertices = (GLfloat *)SDL_realloc(data->batch_vertices, num_vertices * 4 * sizeof(GLfloat));
+        if (!vertices) {
+            return SDL_OutOfMemory();
+        }
+        data->batch_vertices = vertices;
+        data->max_batch_vertices = num_vertices * 4;
+    }
+    vertices = data->batch_vertices;
+    texCoords = data->batch_vertices + num_vertices * 2;
+
+    if (texture) {
+        if (GLES2_SetupCopy(renderer, texture, cmd->r, cmd->g, cmd->b, cmd->a,
+                            cmd->blendMode, 0) < 0) {
+            return -1;
+        }
+    } else {
+        if (GLES2_SetSolidState(renderer, cmd->r, cmd->g, cmd->b, cmd->a,
+                                cmd->blendMode, 0) < 0) {
+            return -1;
+        }
+    }
+
+    /* Emit the whole run as a single triangle list */
+    for (i = 0; i < cmd->count; ++i) {
+        const SDL_FRect *dstrect = &dstrects[i];
+        const GLfloat xMin = dstrect->x;
+        const GLfloat xMax = (dstrect->x + dstrect->w);
+        const GLfloat yMin = dstrect->y;
+        const GLfloat yMax = (dstrect->y + dstrect->h);
+
+        vertices[0] = xMin;
+        vertices[1] = yMin;
+        vertices[2] = xMax;
+        vertices[3] = yMin;
+        vertices[4] = xMin;
+        vertices[5] = yMax;
+        vertices[6] = xMax;
+        vertices[7] = yMin;
+        vertices[8] = xMax;
+        vertices[9] = yMax;
+        vertices[10] = xMin;
+        vertices[11] = yMax;
+        vertices += 12;
+
+        if (texture) {
+            const SDL_Rect *srcrect = &srcrects[i];
+            const GLfloat uMin = srcrect->x / (GLfloat)texture->w;
+            const GLfloat uMax = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
+            const GLfloat vMin = srcrect->y / (GLfloat)texture->h;
+            const GLfloat vMax = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
+
+            texCoords[0] = uMin;
+            texCoords[1] = vMin;
+            texCoords[2] = uMax;
+            texCoords[3] = vMin;
+            texCoords[4] = uMin;
+            texCoords[5] = vMax;
+            texCoords[6] = uMax;
+            texCoords[7] = vMin;
+            texCoords[8] = uMax;
+            texCoords[9] = vMax;
+            texCoords[10] = uMin;
+            texCoords[11] = vMax;
+            texCoords += 12;
+        }
+    }
+
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, data->batch_vertices, num_vertices * 2 * sizeof(GLfloat));
+    if (texture) {
+        GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, data->batch_vertices + num_vertices * 2, num_vertices * 2 * sizeof(GLfloat));
+    }
+    data->glDrawArrays(GL_TRIANGLES, 0, num_vertices);
+
+    return GL_CheckError("", renderer);
+}
+
+static int
+GLES2_RenderBatch(SDL_Renderer * renderer,
+                  const SDL_RenderCommand * cmds, int num_commands,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    int i;
+    int status = 0;
+
+    for (i = 0; i < num_commands; ++i) {
+        const SDL_RenderCommand *cmd = &cmds[i];
+
+        if (GLES2_RenderCommand(renderer, cmd, srcrects + cmd->first,
+                                dstrects + cmd->first) < 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+static int
+GLES2_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                     const SDL_Vertex * vertices, int num_vertices,
+                     const int *indices, int num_indices)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const int count = indices ? num_indices : num_vertices;
+    const SDL_bool swap_rb = (renderer->target &&
+                              (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
+                               renderer->target->format == SDL_PIXELFORMAT_RGB888));
+    GLfloat *positions, *texCoords, *colors;
+    int i;
+
+    GLES2_ActivateRenderer(renderer);
+
+    if (count * 8 > data->max_batch_vertices) {
+        positions = (GLfloat *)SDL_realloc(data->batch_vertices, count * 8 * sizeof(GLfloat));
+        if (!positions) {
+            return SDL_OutOfMemory();
+        }
+        data->batch_vertices = positions;
+        data->max_batch_vertices = count * 8;
+    }
+    positions = data->batch_vertices;
+    texCoords = positions + count * 2;
+    colors = texCoords + count * 2;
+
+    if (texture) {
+        if (GLES2_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                            texture->a, texture->blendMode,
+                            GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_COLOR)) < 0) {
+            return -1;
+        }
+    } else {
+        if (GLES2_SetSolidState(renderer, 255, 255, 255, 255, renderer->blendMode,
+                                GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_COLOR)) < 0) {
+            return -1;
+        }
+    }
+
+    /* OpenGL ES 2.0 only guarantees 16-bit indices, so expand them here */
+    for (i = 0; i < count; ++i) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+
+        *positions++ = vertex->position.x * renderer->scale.x;
+        *positions++ = vertex->position.y * renderer->scale.y;
+        *texCoords++ = vertex->tex_coord.x;
+        *texCoords++ = vertex->tex_coord.y;
+        if (swap_rb) {
+            *colors++ = vertex->color.b * inv255f;
+            *colors++ = vertex->color.g * inv255f;
+            *colors++ = vertex->color.r * inv255f;
+        } else {
+            *colors++ = vertex->color.r * inv255f;
+            *colors++ = vertex->color.g * inv255f;
+            *colors++ = vertex->color.b * inv255f;
+        }
+        *colors++ = vertex->color.a * inv255f;
+    }
+
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, data->batch_vertices, count * 2 * sizeof(GLfloat));
+    if (texture) {
+        GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, data->batch_vertices + count * 2, count * 2 * sizeof(GLfloat));
+    }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_COLOR, data->batch_vertices + count * 4, count * 4 * sizeof(GLfloat));
+    data->glDrawArrays(GL_TRIANGLES, 0, count);
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
                  const SDL_FRect *dstrect, const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
@@ -1756,12 +2076,13 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
 
     GLES2_ActivateRenderer(renderer);
 
-    if (GLES2_SetupCopy(renderer, texture) < 0) {
+    if (GLES2_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                        texture->a, texture->blendMode,
+                        GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_CENTER) |
+                        GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_ANGLE)) < 0) {
         return -1;
     }
 
-    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
-    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
     fAngle[0] = fAngle[1] = fAngle[2] = fAngle[3] = (GLfloat)(360.0f - angle);
     /* Calculate the center of rotation */
     translate[0] = translate[2] = translate[4] = translate[6] = (center->x + dstrect->x);
@@ -1806,8 +2127,6 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     /*data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, texCoords);*/
     GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, texCoords, 8 * sizeof(GLfloat));
     data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
-    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
 
     return GL_CheckError("", renderer);
 }
@@ -1866,8 +2185,15 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 GLES2_RenderPresent(SDL_Renderer *renderer)
 {
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+
     GLES2_ActivateRenderer(renderer);
 
+#if SDL_GLES2_USE_VBOS
+    /* Start the next frame in fresh vertex buffer storage */
+    data->vertex_buffer_offset = data->vertex_buffer_size;
+#endif
+
     /* Tell the video driver to swap buffers */
     SDL_GL_SwapWindow(renderer->window);
 }
@@ -1885,7 +2211,18 @@ static int GLES2_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, flo
     GLES2_TextureData *texturedata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ActivateRenderer(renderer);
 
-    data->glBindTexture(texturedata->texture_type, texturedata->texture);
+#if SDL_GLES2_USE_VBOS
+    /* Leave the application free to draw from client-side arrays */
+    if (data->current.array_buffer) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        data->current.array_buffer = 0;
+    }
+#endif
+
+    /* The application sets up its own attributes from here on */
+    GLES2_SetAttributes(data, 0);
+
+    GLES2_BindTextureUnit(data, 0, texturedata->texture_type, texturedata->texture);
 
     if (texw) {
         *texw = 1.0;
@@ -1903,7 +2240,7 @@ static int GLES2_UnbindTexture (SDL_Renderer * renderer, SDL_Texture *texture)
     GLES2_TextureData *texturedata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ActivateRenderer(renderer);
 
-    data->glBindTexture(texturedata->texture_type, 0);
+    GLES2_BindTextureUnit(data, 0, texturedata->texture_type, 0);
 
     return 0;
 }
@@ -1920,6 +2257,8 @@ GLES2_ResetState(SDL_Renderer *renderer)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *) renderer->driverdata;
 
+    data->current.viewport_valid = SDL_FALSE;
+
     if (SDL_CurrentContext == data->context) {
         GLES2_UpdateViewport(renderer);
     } else {
@@ -1927,7 +2266,10 @@ GLES2_ResetState(SDL_Renderer *renderer)
     }
 
     data->current.blendMode = -1;
-    data->current.tex_coords = SDL_FALSE;
+    data->current.texture_unit = 0;
+    SDL_zero(data->current.textures);
+    data->current.scissor_enabled = -1;
+    data->current.scissor.w = -1;
 
     data->glActiveTexture(GL_TEXTURE0);
     data->glPixelStorei(GL_PACK_ALIGNMENT, 1);
@@ -1940,6 +2282,18 @@ GLES2_ResetState(SDL_Renderer *renderer)
 
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_POSITION);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    data->current.attributes = GLES2_ATTRIBUTE_MASK(GLES2_ATTRIBUTE_POSITION);
+
+#if SDL_GLES2_USE_VBOS
+    data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    data->current.array_buffer = 0;
+#endif
+
+    /* Everything but SDL_RenderGeometry() draws with an opaque white vertex color */
+    data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
 
     GL_CheckError("", renderer);
 }
@@ -2089,6 +2443,8 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->RenderFillRects     = &GLES2_RenderFillRects;
     renderer->RenderCopy          = &GLES2_RenderCopy;
     renderer->RenderCopyEx        = &GLES2_RenderCopyEx;
+    renderer->RenderBatch         = &GLES2_RenderBatch;
+    renderer->RenderGeometry      = &GLES2_RenderGeometry;
     renderer->RenderReadPixels    = &GLES2_RenderReadPixels;
     renderer->RenderPresent       = &GLES2_RenderPresent;
     renderer->DestroyTexture      = &GLES2_DestroyTexture;
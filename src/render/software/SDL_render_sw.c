@@ -23,6 +23,9 @@
 #if !SDL_RENDER_DISABLED
 
 #include "../SDL_sysrender.h"
+#include "../../video/SDL_sysvideo.h"
+#include "../../video/SDL_blit.h"
+#include "../../video/SDL_pixels_c.h"
 #include "SDL_render_sw_c.h"
 #include "SDL_hints.h"
 
@@ -32,7 +35,8 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
-#include "SDL_rotate.h"
+#include "SDL_triangle.h"
+#include "SDL_tilepool.h"
 
 /* SDL surface based renderer implementation */
 
@@ -68,8 +72,17 @@ static int SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                           const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip);
+static int SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Vertex * vertices, int num_vertices,
+                             const int *indices, int num_indices);
+static int SW_RenderBatch(SDL_Renderer * renderer,
+                          const SDL_RenderCommand * cmds, int num_commands,
+                          const SDL_Rect * srcrects, const SDL_FRect * dstrects);
 static int SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                Uint32 format, void * pixels, int pitch);
+static int SW_CaptureReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
+static int SW_FinishReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
+static void SW_DestroyReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback);
 static void SW_RenderPresent(SDL_Renderer * renderer);
 static void SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture);
 static void SW_DestroyRenderer(SDL_Renderer * renderer);
@@ -99,6 +112,9 @@ typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SDL_SW_TilePool *tiles;     /* Only if SDL_HINT_RENDER_SW_THREADS asks for it */
+    SDL_SW_TileQuad *quads;
+    int max_quads;
 } SW_RenderData;
 
 
@@ -127,6 +143,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
 
     if (!surface) {
         SDL_SetError("Can't create renderer for NULL surface");
@@ -148,6 +165,15 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     data->surface = surface;
     data->window = surface;
 
+    /* Banded drawing needs the whole queue at once, so it implies batching */
+    hint = SDL_GetHint(SDL_HINT_RENDER_SW_THREADS);
+    if (hint && SDL_atoi(hint) > 1) {
+        data->tiles = SDL_SW_CreateTilePool(SDL_atoi(hint));
+        if (data->tiles) {
+            renderer->batching = SDL_TRUE;
+        }
+    }
+
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
     renderer->CreateTexture = SW_CreateTexture;
@@ -166,7 +192,12 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->RenderFillRects = SW_RenderFillRects;
     renderer->RenderCopy = SW_RenderCopy;
     renderer->RenderCopyEx = SW_RenderCopyEx;
+    renderer->RenderBatch = SW_RenderBatch;
+    renderer->RenderGeometry = SW_RenderGeometry;
     renderer->RenderReadPixels = SW_RenderReadPixels;
+    renderer->CaptureReadback = SW_CaptureReadback;
+    renderer->FinishReadback = SW_FinishReadback;
+    renderer->DestroyReadback = SW_DestroyReadback;
     renderer->RenderPresent = SW_RenderPresent;
     renderer->DestroyTexture = SW_DestroyTexture;
     renderer->DestroyRenderer = SW_DestroyRenderer;
@@ -232,8 +263,8 @@ SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     }
 
     texture->driverdata =
-        SDL_CreateRGBSurface(0, texture->w, texture->h, bpp, Rmask, Gmask,
-                             Bmask, Amask);
+        SDL_CreateRGBSurface(SDL_SIMD_ALIGNED, texture->w, texture->h, bpp,
+                             Rmask, Gmask, Bmask, Amask);
     SDL_SetSurfaceColorMod(texture->driverdata, texture->r, texture->g,
                            texture->b);
     SDL_SetSurfaceAlphaMod(texture->driverdata, texture->a);
@@ -429,6 +460,13 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    if (surface->flags & SDL_DIRTYTRACKED) {
+        SDL_Rect bounds;
+        if (SDL_EnclosePoints(final_points, count, &surface->clip_rect, &bounds)) {
+            SDL_AddWindowSurfaceDirtyRect(surface, &bounds);
+        }
+    }
+
     /* Draw the points! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -478,6 +516,21 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    if (surface->flags & SDL_DIRTYTRACKED) {
+        /* A line can cross the clip rectangle with both ends outside it, so
+           enclose all of the ends and clip afterwards */
+        SDL_Rect bounds, clipped;
+        if (SDL_EnclosePoints(final_points, count, NULL, &bounds)) {
+            bounds.x -= 1;
+            bounds.y -= 1;
+            bounds.w += 2;
+            bounds.h += 2;
+            if (SDL_IntersectRect(&bounds, &surface->clip_rect, &clipped)) {
+                SDL_AddWindowSurfaceDirtyRect(surface, &clipped);
+            }
+        }
+    }
+
     /* Draw the lines! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -497,7 +550,8 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 }
 
 static int
-SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
+SW_FillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Rect *final_rects;
@@ -530,22 +584,31 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
         }
     }
 
-    if (renderer->blendMode == SDL_BLENDMODE_NONE) {
-        Uint32 color = SDL_MapRGBA(surface->format,
-                                   renderer->r, renderer->g, renderer->b,
-                                   renderer->a);
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
         status = SDL_FillRects(surface, final_rects, count, color);
     } else {
+        if (surface->flags & SDL_DIRTYTRACKED) {
+            for (i = 0; i < count; ++i) {
+                SDL_AddWindowSurfaceDirtyRect(surface, &final_rects[i]);
+            }
+        }
         status = SDL_BlendFillRects(surface, final_rects, count,
-                                    renderer->blendMode,
-                                    renderer->r, renderer->g, renderer->b,
-                                    renderer->a);
+                                    blendMode, r, g, b, a);
     }
     SDL_stack_free(final_rects);
 
     return status;
 }
 
+static int
+SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
+{
+    return SW_FillRects(renderer, rects, count,
+                        renderer->r, renderer->g, renderer->b, renderer->a,
+                        renderer->blendMode);
+}
+
 static int
 SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect)
@@ -579,6 +642,329 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     }
 }
 
+static int
+SW_RenderCommand(SDL_Renderer * renderer, const SDL_RenderCommand * cmd,
+                 const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    SDL_Texture *texture = cmd->texture;
+    SDL_Surface *src;
+    int i;
+    int status = 0;
+
+    if (!texture) {
+        return SW_FillRects(renderer, dstrects, cmd->count,
+                            cmd->r, cmd->g, cmd->b, cmd->a, cmd->blendMode);
+    }
+
+    /* The texture settings may have changed since the copies were queued,
+       apply the recorded ones once for the whole run. */
+    src = (SDL_Surface *) texture->driverdata;
+    SDL_SetSurfaceColorMod(src, cmd->r, cmd->g, cmd->b);
+    SDL_SetSurfaceAlphaMod(src, cmd->a);
+    SDL_SetSurfaceBlendMode(src, cmd->blendMode);
+
+    for (i = 0; i < cmd->count; ++i) {
+        if (SW_RenderCopy(renderer, texture, &srcrects[i], &dstrects[i]) < 0) {
+            status = -1;
+        }
+    }
+
+    SDL_SetSurfaceColorMod(src, texture->r, texture->g, texture->b);
+    SDL_SetSurfaceAlphaMod(src, texture->a);
+    SDL_SetSurfaceBlendMode(src, texture->blendMode);
+
+    return status;
+}
+
+/* Handing out bands costs more than it saves below this many pixels */
+#define SW_MIN_TILED_AREA       (128 * 128)
+#define SW_MAX_TILED_TEXTURES   64
+
+/* Draw a run of the commands with the tile pool, returning how many were
+   drawn, or 0 if the first one can't be.  A run that turns out to be too
+   small to split is drawn serially; '*status' is set to -1 on errors. */
+static int
+SW_RenderTiledCommands(SDL_Renderer * renderer, SDL_Surface * surface,
+                       const SDL_RenderCommand * cmds, int num_commands,
+                       const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                       int *status)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const SDL_RenderCommand *textures[SW_MAX_TILED_TEXTURES];
+    const SDL_Rect *clip = &surface->clip_rect;
+    int num_textures = 0;
+    int num_quads = 0;
+    int area = 0;
+    SDL_bool mapped = SDL_TRUE;
+    int i, j, n;
+
+    /* Find a run of fills and unscaled copies from other surfaces.  Every
+       band draws the whole run, so a texture has to keep its settings. */
+    for (n = 0; n < num_commands; ++n) {
+        const SDL_RenderCommand *cmd = &cmds[n];
+
+        if (cmd->texture) {
+            SDL_Surface *src = (SDL_Surface *) cmd->texture->driverdata;
+
+            if (src == surface || src->locked) {
+                break;
+            }
+            /* SDL_BlitScaled() rounds differently once clipped, so leave
+               scaled copies to the serial path */
+            for (i = cmd->first; i < cmd->first + cmd->count; ++i) {
+                if (srcrects[i].w != (int)dstrects[i].w ||
+                    srcrects[i].h != (int)dstrects[i].h) {
+                    break;
+                }
+            }
+            if (i < cmd->first + cmd->count) {
+                break;
+            }
+
+            for (j = 0; j < num_textures; ++j) {
+                if (textures[j]->texture == cmd->texture) {
+                    break;
+                }
+            }
+            if (j < num_textures) {
+                const SDL_RenderCommand *prev = textures[j];
+                if (prev->r != cmd->r || prev->g != cmd->g || prev->b != cmd->b ||
+                    prev->a != cmd->a || prev->blendMode != cmd->blendMode) {
+                    break;
+                }
+            } else if (num_textures == SW_MAX_TILED_TEXTURES) {
+                break;
+            } else {
+                textures[num_textures++] = cmd;
+            }
+        }
+        num_quads += cmd->count;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    if (num_quads > data->max_quads) {
+        SDL_SW_TileQuad *quads = (SDL_SW_TileQuad *) SDL_realloc(data->quads, num_quads * sizeof(*quads));
+        if (!quads) {
+            return 0;
+        }
+        data->quads = quads;
+        data->max_quads = num_quads;
+    }
+
+    /* Apply the recorded texture settings and map the surfaces up front,
+       the workers only read them */
+    for (j = 0; j < num_textures; ++j) {
+        const SDL_RenderCommand *cmd = textures[j];
+        SDL_Surface *src = (SDL_Surface *) cmd->texture->driverdata;
+
+        SDL_SetSurfaceColorMod(src, cmd->r, cmd->g, cmd->b);
+        SDL_SetSurfaceAlphaMod(src, cmd->a);
+        SDL_SetSurfaceBlendMode(src, cmd->blendMode);
+        if (src->map->info.flags & SDL_COPY_NEAREST) {
+            src->map->info.flags &= ~SDL_COPY_NEAREST;
+            SDL_InvalidateMap(src->map);
+        }
+        if ((src->map->dst != surface) ||
+            (surface->format->palette &&
+             src->map->dst_palette_version != surface->format->palette->version) ||
+            (src->format->palette &&
+             src->map->src_palette_version != src->format->palette->version)) {
+            if (SDL_MapSurface(src, surface) < 0) {
+                mapped = SDL_FALSE;
+            }
+        }
+    }
+
+    /* Clip the quads the way SDL_BlitSurface() and SDL_FillRect() would */
+    num_quads = 0;
+    for (i = 0; mapped && i < n; ++i) {
+        const SDL_RenderCommand *cmd = &cmds[i];
+        SDL_Surface *src = cmd->texture ? (SDL_Surface *) cmd->texture->driverdata : NULL;
+        Uint32 color = 0;
+
+        if (!src && cmd->blendMode == SDL_BLENDMODE_NONE) {
+            color = SDL_MapRGBA(surface->format, cmd->r, cmd->g, cmd->b, cmd->a);
+        }
+
+        for (j = cmd->first; j < cmd->first + cmd->count; ++j) {
+            SDL_SW_TileQuad *quad = &data->quads[num_quads];
+            SDL_Rect rect;
+            int dx, dy;
+
+            rect.x = (int)(renderer->viewport.x + dstrects[j].x);
+            rect.y = (int)(renderer->viewport.y + dstrects[j].y);
+            quad->src = src;
+            if (src) {
+                quad->srcrect = srcrects[j];
+                rect.w = quad->srcrect.w;
+                rect.h = quad->srcrect.h;
+                if (quad->srcrect.x < 0) {
+                    rect.w += quad->srcrect.x;
+                    rect.x -= quad->srcrect.x;
+                    quad->srcrect.x = 0;
+                }
+                rect.w = SDL_min(rect.w, src->w - quad->srcrect.x);
+                if (quad->srcrect.y < 0) {
+                    rect.h += quad->srcrect.y;
+                    rect.y -= quad->srcrect.y;
+                    quad->srcrect.y = 0;
+                }
+                rect.h = SDL_min(rect.h, src->h - quad->srcrect.y);
+
+                dx = clip->x - rect.x;
+                if (dx > 0) {
+                    rect.w -= dx;
+                    rect.x += dx;
+                    quad->srcrect.x += dx;
+                }
+                dx = rect.x + rect.w - clip->x - clip->w;
+                if (dx > 0) {
+                    rect.w -= dx;
+                }
+                dy = clip->y - rect.y;
+                if (dy > 0) {
+                    rect.h -= dy;
+                    rect.y += dy;
+                    quad->srcrect.y += dy;
+                }
+                dy = rect.y + rect.h - clip->y - clip->h;
+                if (dy > 0) {
+                    rect.h -= dy;
+                }
+                if (rect.w <= 0 || rect.h <= 0) {
+                    continue;
+                }
+                quad->srcrect.w = rect.w;
+                quad->srcrect.h = rect.h;
+                quad->dstrect = rect;
+            } else {
+                rect.w = SDL_max((int)dstrects[j].w, 1);
+                rect.h = SDL_max((int)dstrects[j].h, 1);
+                if (!SDL_IntersectRect(&rect, clip, &quad->dstrect)) {
+                    continue;
+                }
+                quad->color = color;
+                quad->r = cmd->r;
+                quad->g = cmd->g;
+                quad->b = cmd->b;
+                quad->a = cmd->a;
+                quad->blendMode = cmd->blendMode;
+            }
+            area += quad->dstrect.w * quad->dstrect.h;
+            ++num_quads;
+        }
+    }
+
+    if (mapped && area >= SW_MIN_TILED_AREA) {
+        Uint32 dirtytracked = (surface->flags & SDL_DIRTYTRACKED);
+
+        if (dirtytracked) {
+            for (i = 0; i < num_quads; ++i) {
+                SDL_AddWindowSurfaceDirtyRect(surface, &data->quads[i].dstrect);
+            }
+        }
+
+        /* The workers must not record dirty rectangles themselves */
+        surface->flags &= ~SDL_DIRTYTRACKED;
+        SDL_SW_RenderTiles(data->tiles, surface, data->quads, num_quads);
+        surface->flags |= dirtytracked;
+    }
+
+    for (j = 0; j < num_textures; ++j) {
+        SDL_Texture *texture = textures[j]->texture;
+        SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+
+        SDL_SetSurfaceColorMod(src, texture->r, texture->g, texture->b);
+        SDL_SetSurfaceAlphaMod(src, texture->a);
+        SDL_SetSurfaceBlendMode(src, texture->blendMode);
+    }
+
+    if (!mapped || area < SW_MIN_TILED_AREA) {
+        /* Not worth waking the workers for, or the serial path can report
+           why the surfaces couldn't be mapped */
+        for (i = 0; i < n; ++i) {
+            if (SW_RenderCommand(renderer, &cmds[i], srcrects + cmds[i].first,
+                                 dstrects + cmds[i].first) < 0) {
+                *status = -1;
+            }
+        }
+    }
+    return n;
+}
+
+static int
+SW_RenderBatch(SDL_Renderer * renderer,
+               const SDL_RenderCommand * cmds, int num_commands,
+               const SDL_Rect * srcrects, const SDL_FRect * dstrects)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    int i, n;
+    int status = 0;
+
+    if (!surface) {
+        return -1;
+    }
+
+    for (i = 0; i < num_commands; i += n) {
+        n = 0;
+        if (data->tiles && !SDL_MUSTLOCK(surface) && !surface->locked) {
+            n = SW_RenderTiledCommands(renderer, surface, &cmds[i], num_commands - i,
+                                       srcrects, dstrects, &status);
+        }
+        if (n == 0) {
+            const SDL_RenderCommand *cmd = &cmds[i];
+            if (SW_RenderCommand(renderer, cmd, srcrects + cmd->first,
+                                 dstrects + cmd->first) < 0) {
+                status = -1;
+            }
+            n = 1;
+        }
+    }
+    return status;
+}
+
+static int
+SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Vertex * vertices, int num_vertices,
+                  const int *indices, int num_indices)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SDL_Surface *src = texture ? (SDL_Surface *) texture->driverdata : NULL;
+    SDL_Point offset;
+    SDL_Color modulation = { 255, 255, 255, 255 };
+    SDL_BlendMode blendMode = renderer->blendMode;
+    SDL_Rect bounds;
+
+    if (!surface) {
+        return -1;
+    }
+
+    if (texture) {
+        modulation.r = texture->r;
+        modulation.g = texture->g;
+        modulation.b = texture->b;
+        modulation.a = texture->a;
+        blendMode = texture->blendMode;
+    }
+
+    offset.x = renderer->viewport.x;
+    offset.y = renderer->viewport.y;
+
+    if (SDL_SW_FillTriangles(surface, src, vertices, num_vertices,
+                             indices, num_indices, &offset, &renderer->scale,
+                             &modulation, blendMode, &bounds) < 0) {
+        return -1;
+    }
+
+    if ((surface->flags & SDL_DIRTYTRACKED) && !SDL_RectEmpty(&bounds)) {
+        SDL_AddWindowSurfaceDirtyRect(surface, &bounds);
+    }
+    return 0;
+}
+
 static int
 GetScaleQuality(void)
 {
@@ -598,10 +984,10 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect final_rect, tmp_rect;
-    SDL_Surface *surface_rotated, *surface_scaled;
-    int retval, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    SDL_Rect final_rect, bounds;
+    SDL_FPoint corners[4];
+    float cx, cy, cangle, sangle, px, py;
+    int i;
 
     if (!surface) {
         return -1;
@@ -617,113 +1003,52 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     final_rect.w = (int)dstrect->w;
     final_rect.h = (int)dstrect->h;
 
-    /* SDLgfx_rotateSurface doesn't accept a source rectangle, so crop and scale if we need to */
-    tmp_rect = final_rect;
-    tmp_rect.x = 0;
-    tmp_rect.y = 0;
-    if (srcrect->w == final_rect.w && srcrect->h == final_rect.h && srcrect->x == 0 && srcrect->y == 0) {
-        surface_scaled = src; /* but if we don't need to, just use the original */
-        retval = 0;
-    } else {
-        SDL_Surface *blit_src = src;
-        Uint32 colorkey;
-        SDL_BlendMode blendMode;
-        Uint8 alphaMod, r, g, b;
-        SDL_bool cloneSource = SDL_FALSE;
-
-        surface_scaled = SDL_CreateRGBSurface(SDL_SWSURFACE, final_rect.w, final_rect.h, src->format->BitsPerPixel,
-                                              src->format->Rmask, src->format->Gmask,
-                                              src->format->Bmask, src->format->Amask );
-        if (!surface_scaled) {
-            return -1;
-        }
-
-        /* copy the color key, alpha mod, blend mode, and color mod so the scaled surface behaves like the source */
-        if (SDL_GetColorKey(src, &colorkey) == 0) {
-            SDL_SetColorKey(surface_scaled, SDL_TRUE, colorkey);
-            cloneSource = SDL_TRUE;
-        }
-        SDL_GetSurfaceAlphaMod(src, &alphaMod); /* these will be copied to surface_scaled below if necessary */
-        SDL_GetSurfaceBlendMode(src, &blendMode);
-        SDL_GetSurfaceColorMod(src, &r, &g, &b);
-
-        /* now we need to blit the src into surface_scaled. since we want to copy the colors from the source to
-         * surface_scaled rather than blend them, etc. we'll need to disable the blend mode, alpha mod, etc.
-         * but we don't want to modify src (in case it's being used on other threads), so we'll need to clone it
-         * before changing the blend options
-         */
-        cloneSource |= blendMode != SDL_BLENDMODE_NONE || (alphaMod & r & g & b) != 255;
-        if (cloneSource) {
-            blit_src = SDL_ConvertSurface(src, src->format, src->flags); /* clone src */
-            if (!blit_src) {
-                SDL_FreeSurface(surface_scaled);
-                return -1;
-            }
-            SDL_SetSurfaceAlphaMod(blit_src, 255); /* disable all blending options in blit_src */
-            SDL_SetSurfaceBlendMode(blit_src, SDL_BLENDMODE_NONE);
-            SDL_SetColorKey(blit_src, 0, 0);
-            SDL_SetSurfaceColorMod(blit_src, 255, 255, 255);
-            SDL_SetSurfaceRLE(blit_src, 0); /* don't RLE encode a surface we'll only use once */
-
-            SDL_SetSurfaceAlphaMod(surface_scaled, alphaMod); /* copy blending options to surface_scaled */
-            SDL_SetSurfaceBlendMode(surface_scaled, blendMode);
-            SDL_SetSurfaceColorMod(surface_scaled, r, g, b);
-        }
+    /* Corners of the destination, clockwise from the top left of the source */
+    corners[0].x = corners[3].x = (float) final_rect.x;
+    corners[1].x = corners[2].x = (float) (final_rect.x + final_rect.w);
+    corners[0].y = corners[1].y = (float) final_rect.y;
+    corners[2].y = corners[3].y = (float) (final_rect.y + final_rect.h);
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        SDL_FPoint tmp = corners[0];
+        corners[0] = corners[1];
+        corners[1] = tmp;
+        tmp = corners[2];
+        corners[2] = corners[3];
+        corners[3] = tmp;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        SDL_FPoint tmp = corners[0];
+        corners[0] = corners[3];
+        corners[3] = tmp;
+        tmp = corners[1];
+        corners[1] = corners[2];
+        corners[2] = tmp;
+    }
 
-        retval = SDL_BlitScaled(blit_src, srcrect, surface_scaled, &tmp_rect);
-        if (blit_src != src) {
-            SDL_FreeSurface(blit_src);
-        }
+    /* Rotate clockwise around the center, like the other backends */
+    cx = final_rect.x + center->x;
+    cy = final_rect.y + center->y;
+    cangle = (float) SDL_cos(angle * M_PI / 180.0);
+    sangle = (float) SDL_sin(angle * M_PI / 180.0);
+    for (i = 0; i < 4; ++i) {
+        px = corners[i].x - cx;
+        py = corners[i].y - cy;
+        corners[i].x = px * cangle - py * sangle + cx;
+        corners[i].y = px * sangle + py * cangle + cy;
     }
 
-    if (!retval) {
-        SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, -angle, &dstwidth, &dstheight, &cangle, &sangle);
-        surface_rotated = SDLgfx_rotateSurface(surface_scaled, -angle, dstwidth/2, dstheight/2, GetScaleQuality(), flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-        if(surface_rotated) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect.x + (int)center->x;
-            abscentery = final_rect.y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect.x - abscenterx;
-            py = final_rect.y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect.x + final_rect.w - abscenterx;
-            py = final_rect.y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect.x - abscenterx;
-            py = final_rect.y + final_rect.h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect.x + final_rect.w - abscenterx;
-            py = final_rect.y + final_rect.h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            retval = SDL_BlitSurface(surface_rotated, NULL, surface, &tmp_rect);
-            SDL_FreeSurface(surface_rotated);
-        }
+    /* RLE encoded textures are decoded while the mapper locks them, and
+     * encoded again afterwards, so they keep their RLE acceleration.
+     */
+    if (SDL_SW_BlitAffine(src, srcrect, surface, corners,
+                          GetScaleQuality() ? SDL_TRUE : SDL_FALSE, &bounds) < 0) {
+        return -1;
     }
 
-    if (surface_scaled != src) {
-        SDL_FreeSurface(surface_scaled);
+    if ((surface->flags & SDL_DIRTYTRACKED) && !SDL_RectEmpty(&bounds)) {
+        SDL_AddWindowSurfaceDirtyRect(surface, &bounds);
     }
-    return retval;
+    return 0;
 }
 
 static int
@@ -762,6 +1087,66 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                              format, pixels, pitch);
 }
 
+/* The frame is copied as is when presented, and only converted when asked for */
+typedef struct
+{
+    Uint32 format;
+    int pitch;
+    Uint8 pixels[1];
+} SW_ReadbackData;
+
+static int
+SW_CaptureReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_ReadbackData *data;
+    Uint32 format;
+    int pitch;
+
+    if (!surface) {
+        return -1;
+    }
+
+    format = surface->format->format;
+    pitch = readback->rect.w * surface->format->BytesPerPixel;
+    data = (SW_ReadbackData *) SDL_malloc(sizeof(*data) + readback->rect.h * pitch);
+    if (!data) {
+        return SDL_OutOfMemory();
+    }
+    data->format = format;
+    data->pitch = pitch;
+
+    if (SW_RenderReadPixels(renderer, &readback->rect,
+                            format, data->pixels, pitch) < 0) {
+        SDL_free(data);
+        return -1;
+    }
+
+    SDL_free(readback->driverdata);
+    readback->driverdata = data;
+    return 0;
+}
+
+static int
+SW_FinishReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    SW_ReadbackData *data = (SW_ReadbackData *) readback->driverdata;
+    int retval;
+
+    retval = SDL_ConvertPixels(readback->rect.w, readback->rect.h,
+                               data->format, data->pixels, data->pitch,
+                               readback->format, readback->pixels, readback->pitch);
+    SDL_free(data);
+    readback->driverdata = NULL;
+    return retval;
+}
+
+static void
+SW_DestroyReadback(SDL_Renderer * renderer, SDL_RenderReadback * readback)
+{
+    SDL_free(readback->driverdata);
+}
+
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
@@ -785,6 +1170,10 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SDL_SW_DestroyTilePool(data->tiles);
+        SDL_free(data->quads);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
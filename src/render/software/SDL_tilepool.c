@@ -0,0 +1,358 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "../../video/SDL_blit.h"
+#include "SDL_blendfillrect.h"
+#include "SDL_tilepool.h"
+
+/* Bands are never thinner than this, so short targets don't pay for
+   synchronization they can't use */
+#define SW_MIN_BAND_HEIGHT  16
+
+struct SDL_SW_TilePool
+{
+    SDL_Thread **threads;
+    int num_threads;
+    SDL_mutex *lock;
+    SDL_cond *work_ready;
+    SDL_cond *work_done;
+    Uint32 generation;          /* Bumped for every job */
+    int busy;                   /* Workers still on the current job */
+    SDL_bool quit;
+
+    /* The current job */
+    SDL_Surface *dst;
+    const SDL_SW_TileQuad *quads;
+    int num_quads;
+    SDL_Rect area;
+    int band_height;
+    int num_bands;
+    SDL_atomic_t next_band;
+
+    /* The quads of band N are band_quads[band_first[N]] up to
+       band_quads[band_first[N + 1]], in drawing order */
+    int *band_first;
+    int max_bands;
+    int *band_quads;
+    int max_band_quads;
+    SDL_bool binned;            /* Otherwise every band goes through all the quads */
+};
+
+/* The same work as SDL_LowerBlit(), without touching the source map, so
+   several threads can copy from one surface at once */
+static void
+SW_BlitTile(SDL_Surface * src, const SDL_Rect * srcrect,
+            SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    if (src->flags & SDL_RLEACCEL) {
+        /* The RLE blitters only read the map */
+        SDL_Rect sr = *srcrect;
+        SDL_Rect dr = *dstrect;
+
+        src->map->blit(src, &sr, dst, &dr);
+    } else {
+        SDL_BlitInfo info = src->map->info;
+
+        info.src = (Uint8 *) src->pixels + srcrect->y * src->pitch +
+                   srcrect->x * info.src_fmt->BytesPerPixel;
+        info.src_w = srcrect->w;
+        info.src_h = srcrect->h;
+        info.src_pitch = src->pitch;
+        info.src_skip = info.src_pitch - info.src_w * info.src_fmt->BytesPerPixel;
+        info.dst = (Uint8 *) dst->pixels + dstrect->y * dst->pitch +
+                   dstrect->x * info.dst_fmt->BytesPerPixel;
+        info.dst_w = dstrect->w;
+        info.dst_h = dstrect->h;
+        info.dst_pitch = dst->pitch;
+        info.dst_skip = info.dst_pitch - info.dst_w * info.dst_fmt->BytesPerPixel;
+        ((SDL_BlitFunc) src->map->data)(&info);
+    }
+}
+
+static void
+SW_RenderBand(SDL_SW_TilePool * pool, int band)
+{
+    SDL_Surface *dst = pool->dst;
+    SDL_Rect bandrect;
+    SDL_Rect rect;
+    int i, end;
+
+    bandrect = pool->area;
+    bandrect.y += band * pool->band_height;
+    bandrect.h = SDL_min(pool->band_height, pool->area.y + pool->area.h - bandrect.y);
+
+    if (pool->binned) {
+        i = pool->band_first[band];
+        end = pool->band_first[band + 1];
+    } else {
+        i = 0;
+        end = pool->num_quads;
+    }
+    for ( ; i < end; ++i) {
+        const SDL_SW_TileQuad *quad = &pool->quads[pool->binned ? pool->band_quads[i] : i];
+
+        if (!SDL_IntersectRect(&quad->dstrect, &bandrect, &rect)) {
+            continue;
+        }
+        if (quad->src) {
+            SDL_Rect srcrect;
+
+            srcrect.x = quad->srcrect.x + (rect.x - quad->dstrect.x);
+            srcrect.y = quad->srcrect.y + (rect.y - quad->dstrect.y);
+            srcrect.w = rect.w;
+            srcrect.h = rect.h;
+            SW_BlitTile(quad->src, &srcrect, dst, &rect);
+        } else if (quad->blendMode == SDL_BLENDMODE_NONE) {
+            SDL_FillRect(dst, &rect, quad->color);
+        } else {
+            SDL_BlendFillRect(dst, &rect, quad->blendMode,
+                              quad->r, quad->g, quad->b, quad->a);
+        }
+    }
+}
+
+static void
+SW_RenderBands(SDL_SW_TilePool * pool)
+{
+    int band;
+
+    while ((band = SDL_AtomicAdd(&pool->next_band, 1)) < pool->num_bands) {
+        SW_RenderBand(pool, band);
+    }
+}
+
+static int SDLCALL
+SW_TileWorker(void *data)
+{
+    SDL_SW_TilePool *pool = (SDL_SW_TilePool *) data;
+    Uint32 generation = 0;
+
+    SDL_LockMutex(pool->lock);
+    for ( ; ; ) {
+        while (!pool->quit && pool->generation == generation) {
+            SDL_CondWait(pool->work_ready, pool->lock);
+        }
+        if (pool->quit) {
+            break;
+        }
+        generation = pool->generation;
+        SDL_UnlockMutex(pool->lock);
+
+        SW_RenderBands(pool);
+
+        SDL_LockMutex(pool->lock);
+        if (--pool->busy == 0) {
+            SDL_CondSignal(pool->work_done);
+        }
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    return 0;
+}
+
+SDL_SW_TilePool *
+SDL_SW_CreateTilePool(int num_threads)
+{
+    SDL_SW_TilePool *pool;
+    int i;
+
+    if (num_threads < 2) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+    pool = (SDL_SW_TilePool *) SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    pool->threads = (SDL_Thread **) SDL_calloc(num_threads - 1, sizeof(*pool->threads));
+    pool->lock = SDL_CreateMutex();
+    pool->work_ready = SDL_CreateCond();
+    pool->work_done = SDL_CreateCond();
+    if (!pool->threads || !pool->lock || !pool->work_ready || !pool->work_done) {
+        SDL_SW_DestroyTilePool(pool);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads - 1; ++i) {
+        pool->threads[i] = SDL_CreateThread(SW_TileWorker, "SDLSWRender", pool);
+        if (!pool->threads[i]) {
+            SDL_SW_DestroyTilePool(pool);
+            return NULL;
+        }
+        ++pool->num_threads;
+    }
+    return pool;
+}
+
+void
+SDL_SW_DestroyTilePool(SDL_SW_TilePool * pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        pool->quit = SDL_TRUE;
+        SDL_CondBroadcast(pool->work_ready);
+        SDL_UnlockMutex(pool->lock);
+    }
+    for (i = 0; i < pool->num_threads; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+
+    SDL_free(pool->band_first);
+    SDL_free(pool->band_quads);
+    SDL_free(pool->threads);
+    if (pool->work_done) {
+        SDL_DestroyCond(pool->work_done);
+    }
+    if (pool->work_ready) {
+        SDL_DestroyCond(pool->work_ready);
+    }
+    if (pool->lock) {
+        SDL_DestroyMutex(pool->lock);
+    }
+    SDL_free(pool);
+}
+
+/* Return the first and last band a quad's rows fall into, last is less
+   than first if there are none */
+static void
+SW_GetQuadBands(const SDL_SW_TilePool * pool, const SDL_SW_TileQuad * quad,
+                int *first, int *last)
+{
+    const int top = SDL_max(quad->dstrect.y, pool->area.y) - pool->area.y;
+    const int bottom = SDL_min(quad->dstrect.y + quad->dstrect.h,
+                               pool->area.y + pool->area.h) - pool->area.y;
+
+    if (bottom <= top) {
+        *first = 0;
+        *last = -1;
+        return;
+    }
+    *first = top / pool->band_height;
+    *last = (bottom - 1) / pool->band_height;
+}
+
+/* Sort the quads into the bands they cover, once for all the threads */
+static int
+SW_BinQuads(SDL_SW_TilePool * pool)
+{
+    int *band_first;
+    int total = 0;
+    int i, band, first, last;
+
+    if (pool->num_bands + 1 > pool->max_bands) {
+        int *array = (int *) SDL_realloc(pool->band_first, (pool->num_bands + 1) * sizeof(*array));
+        if (!array) {
+            return SDL_OutOfMemory();
+        }
+        pool->band_first = array;
+        pool->max_bands = pool->num_bands + 1;
+    }
+    band_first = pool->band_first;
+
+    /* Count the quads of each band, then turn the counts into offsets */
+    SDL_memset(band_first, 0, (pool->num_bands + 1) * sizeof(*band_first));
+    for (i = 0; i < pool->num_quads; ++i) {
+        SW_GetQuadBands(pool, &pool->quads[i], &first, &last);
+        for (band = first; band <= last; ++band) {
+            ++band_first[band + 1];
+            ++total;
+        }
+    }
+    for (band = 0; band < pool->num_bands; ++band) {
+        band_first[band + 1] += band_first[band];
+    }
+
+    if (total > pool->max_band_quads) {
+        int *array = (int *) SDL_realloc(pool->band_quads, total * sizeof(*array));
+        if (!array) {
+            return SDL_OutOfMemory();
+        }
+        pool->band_quads = array;
+        pool->max_band_quads = total;
+    }
+
+    /* Fill the bands in order, each offset ends up at the next band's */
+    for (i = 0; i < pool->num_quads; ++i) {
+        SW_GetQuadBands(pool, &pool->quads[i], &first, &last);
+        for (band = first; band <= last; ++band) {
+            pool->band_quads[band_first[band]++] = i;
+        }
+    }
+    for (band = pool->num_bands; band > 0; --band) {
+        band_first[band] = band_first[band - 1];
+    }
+    band_first[0] = 0;
+    return 0;
+}
+
+void
+SDL_SW_RenderTiles(SDL_SW_TilePool * pool, SDL_Surface * dst,
+                   const SDL_SW_TileQuad * quads, int num_quads)
+{
+    /* A few bands per thread, so an expensive band doesn't stall the rest */
+    const int max_bands = (pool->num_threads + 1) * 4;
+
+    pool->dst = dst;
+    pool->quads = quads;
+    pool->num_quads = num_quads;
+    pool->area = dst->clip_rect;
+    if (SDL_RectEmpty(&pool->area) || num_quads <= 0) {
+        return;
+    }
+    pool->band_height = SDL_max((pool->area.h + max_bands - 1) / max_bands, SW_MIN_BAND_HEIGHT);
+    pool->num_bands = (pool->area.h + pool->band_height - 1) / pool->band_height;
+    pool->binned = (SW_BinQuads(pool) == 0) ? SDL_TRUE : SDL_FALSE;
+    SDL_AtomicSet(&pool->next_band, 0);
+
+    SDL_LockMutex(pool->lock);
+    ++pool->generation;
+    pool->busy = pool->num_threads;
+    SDL_CondBroadcast(pool->work_ready);
+    SDL_UnlockMutex(pool->lock);
+
+    /* Help out rather than sit idle */
+    SW_RenderBands(pool);
+
+    SDL_LockMutex(pool->lock);
+    while (pool->busy > 0) {
+        SDL_CondWait(pool->work_done, pool->lock);
+    }
+    SDL_UnlockMutex(pool->lock);
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
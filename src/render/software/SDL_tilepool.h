@@ -0,0 +1,49 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#include "SDL_render.h"
+
+
+/* A copy or fill that can be drawn one band of the target at a time */
+typedef struct SDL_SW_TileQuad
+{
+    SDL_Surface *src;           /* The surface to copy from, or NULL for fills */
+    SDL_Rect srcrect;           /* Same size as dstrect, copies aren't scaled */
+    SDL_Rect dstrect;
+    Uint32 color;               /* Mapped fill color, for SDL_BLENDMODE_NONE */
+    Uint8 r, g, b, a;           /* Fill color, for the blended modes */
+    SDL_BlendMode blendMode;    /* Fill blend mode */
+} SDL_SW_TileQuad;
+
+typedef struct SDL_SW_TilePool SDL_SW_TilePool;
+
+/* Start 'num_threads' - 1 workers; the thread drawing the tiles is the last one */
+extern SDL_SW_TilePool *SDL_SW_CreateTilePool(int num_threads);
+extern void SDL_SW_DestroyTilePool(SDL_SW_TilePool * pool);
+
+/* Split the clip rectangle of 'dst' into bands and draw all the quads, in
+   order, into each band.  The blit mappings of the source surfaces must be
+   valid for 'dst' and nothing may change them until this returns. */
+extern void SDL_SW_RenderTiles(SDL_SW_TilePool * pool, SDL_Surface * dst,
+                               const SDL_SW_TileQuad * quads, int num_quads);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,689 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_draw.h"
+#include "SDL_triangle.h"
+
+/* Scanline rasterizer for SDL_RenderGeometry() and rotated copies on the
+   software renderer.
+
+   Pixels are covered when their center lies inside the triangle.  A pixel
+   center exactly on an edge belongs to the triangle right of that edge, or
+   below it for a horizontal edge, so triangles sharing an edge never touch
+   a pixel twice.  Texture coordinates and colors are interpolated linearly
+   and the texture is sampled with nearest neighbour or bilinear filtering,
+   clamped to the edges of the source rectangle.  Color keyed texels are
+   transparent.
+*/
+
+enum
+{
+    SW_ATTRIB_U,
+    SW_ATTRIB_V,
+    SW_ATTRIB_R,
+    SW_ATTRIB_G,
+    SW_ATTRIB_B,
+    SW_ATTRIB_A,
+    SW_NUM_ATTRIBS
+};
+
+typedef struct
+{
+    float x, y;
+    float attrib[SW_NUM_ATTRIBS];   /* Texture coordinates in texels, colors in 0..255 */
+} SW_TriangleVertex;
+
+typedef struct
+{
+    SDL_Surface *dst;
+    SDL_Surface *src;
+    SDL_bool dst_direct;
+    SDL_bool src_direct;
+    SDL_Rect texrect;               /* The texels that may be sampled */
+    SDL_bool bilinear;
+    SDL_bool colorkey;
+    Uint32 key;
+    SDL_BlendMode blendMode;
+    int minx, miny, maxx, maxy;     /* The pixels touched so far */
+} SW_TriangleContext;
+
+#define SW_CLAMP_COLOR(v) ((v) <= 0.0f ? 0 : (v) >= 255.0f ? 255 : (Uint8)((v) + 0.5f))
+
+/* 32-bit formats with 8 bits per channel are read and written directly */
+static SDL_bool
+SW_IsDirectFormat(const SDL_PixelFormat * fmt)
+{
+    return (fmt->BytesPerPixel == 4 &&
+            fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+            (fmt->Amask == 0 || fmt->Aloss == 0)) ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_INLINE Uint32
+SW_GetPixel(const Uint8 * p, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        return *p;
+    case 2:
+        return *(const Uint16 *) p;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+        return (p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+    default:
+        return *(const Uint32 *) p;
+    }
+}
+
+static SDL_INLINE void
+SW_PutPixel(Uint8 * p, int bpp, Uint32 pixel)
+{
+    switch (bpp) {
+    case 1:
+        *p = (Uint8) pixel;
+        break;
+    case 2:
+        *(Uint16 *) p = (Uint16) pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        p[0] = (Uint8) pixel;
+        p[1] = (Uint8) (pixel >> 8);
+        p[2] = (Uint8) (pixel >> 16);
+#else
+        p[0] = (Uint8) (pixel >> 16);
+        p[1] = (Uint8) (pixel >> 8);
+        p[2] = (Uint8) pixel;
+#endif
+        break;
+    default:
+        *(Uint32 *) p = pixel;
+        break;
+    }
+}
+
+static SDL_INLINE void
+SW_ReadRGBA(const SDL_PixelFormat * fmt, SDL_bool direct, const Uint8 * p,
+            Uint8 * r, Uint8 * g, Uint8 * b, Uint8 * a)
+{
+    if (direct) {
+        const Uint32 pixel = *(const Uint32 *) p;
+        *r = (Uint8) (pixel >> fmt->Rshift);
+        *g = (Uint8) (pixel >> fmt->Gshift);
+        *b = (Uint8) (pixel >> fmt->Bshift);
+        *a = fmt->Amask ? (Uint8) (pixel >> fmt->Ashift) : 255;
+    } else {
+        SDL_GetRGBA(SW_GetPixel(p, fmt->BytesPerPixel), fmt, r, g, b, a);
+    }
+}
+
+static SDL_INLINE void
+SW_WriteRGBA(const SDL_PixelFormat * fmt, SDL_bool direct, Uint8 * p,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (direct) {
+        *(Uint32 *) p = ((Uint32) r << fmt->Rshift) |
+                        ((Uint32) g << fmt->Gshift) |
+                        ((Uint32) b << fmt->Bshift) |
+                        (((Uint32) a << fmt->Ashift) & fmt->Amask);
+    } else {
+        SW_PutPixel(p, fmt->BytesPerPixel, SDL_MapRGBA(fmt, r, g, b, a));
+    }
+}
+
+/* Returns SDL_FALSE for a color keyed texel */
+static SDL_INLINE SDL_bool
+SW_ReadTexel(const SW_TriangleContext * ctx, int x, int y,
+             Uint8 * r, Uint8 * g, Uint8 * b, Uint8 * a)
+{
+    const SDL_Surface *src = ctx->src;
+    const Uint8 *p = (const Uint8 *) src->pixels + y * src->pitch + x * src->format->BytesPerPixel;
+
+    if (ctx->colorkey && SW_GetPixel(p, src->format->BytesPerPixel) == ctx->key) {
+        *r = *g = *b = *a = 0;
+        return SDL_FALSE;
+    }
+    SW_ReadRGBA(src->format, ctx->src_direct, p, r, g, b, a);
+    return SDL_TRUE;
+}
+
+/* Interpolate each byte of two pixels, 'f' is 0..256 */
+static SDL_INLINE Uint32
+SW_Lerp32(Uint32 a, Uint32 b, unsigned f)
+{
+    const Uint32 rb = (((a & 0x00ff00ff) * (256 - f) + (b & 0x00ff00ff) * f) >> 8) & 0x00ff00ff;
+    const Uint32 ag = (((a >> 8) & 0x00ff00ff) * (256 - f) + ((b >> 8) & 0x00ff00ff) * f) & 0xff00ff00;
+    return rb | ag;
+}
+
+/* Returns SDL_FALSE if nothing should be drawn */
+static SDL_INLINE SDL_bool
+SW_SampleTexture(const SW_TriangleContext * ctx, float u, float v,
+                 Uint8 * r, Uint8 * g, Uint8 * b, Uint8 * a)
+{
+    const SDL_Rect *rect = &ctx->texrect;
+    const int maxx = rect->x + rect->w - 1;
+    const int maxy = rect->y + rect->h - 1;
+
+    if (ctx->bilinear) {
+        Uint8 c[4][4];
+        unsigned fx, fy, top, bottom;
+        int x0, y0, x1, y1, i;
+
+        /* Texel centers are at half coordinates */
+        u -= 0.5f;
+        v -= 0.5f;
+        x0 = (int) u;
+        if (u < x0) {
+            --x0;
+        }
+        y0 = (int) v;
+        if (v < y0) {
+            --y0;
+        }
+        fx = (unsigned) ((u - x0) * 256.0f);
+        fy = (unsigned) ((v - y0) * 256.0f);
+        x1 = SDL_min(SDL_max(x0 + 1, rect->x), maxx);
+        y1 = SDL_min(SDL_max(y0 + 1, rect->y), maxy);
+        x0 = SDL_min(SDL_max(x0, rect->x), maxx);
+        y0 = SDL_min(SDL_max(y0, rect->y), maxy);
+
+        if (ctx->src_direct && !ctx->colorkey) {
+            /* Every byte is a channel, so they can be interpolated in place */
+            const SDL_PixelFormat *fmt = ctx->src->format;
+            const Uint32 *row0 = (const Uint32 *) ((const Uint8 *) ctx->src->pixels + y0 * ctx->src->pitch);
+            const Uint32 *row1 = (const Uint32 *) ((const Uint8 *) ctx->src->pixels + y1 * ctx->src->pitch);
+            const Uint32 pixel = SW_Lerp32(SW_Lerp32(row0[x0], row0[x1], fx),
+                                           SW_Lerp32(row1[x0], row1[x1], fx), fy);
+
+            *r = (Uint8) (pixel >> fmt->Rshift);
+            *g = (Uint8) (pixel >> fmt->Gshift);
+            *b = (Uint8) (pixel >> fmt->Bshift);
+            *a = fmt->Amask ? (Uint8) (pixel >> fmt->Ashift) : 255;
+            return SDL_TRUE;
+        }
+
+        SW_ReadTexel(ctx, x0, y0, &c[0][0], &c[0][1], &c[0][2], &c[0][3]);
+        SW_ReadTexel(ctx, x1, y0, &c[1][0], &c[1][1], &c[1][2], &c[1][3]);
+        SW_ReadTexel(ctx, x0, y1, &c[2][0], &c[2][1], &c[2][2], &c[2][3]);
+        SW_ReadTexel(ctx, x1, y1, &c[3][0], &c[3][1], &c[3][2], &c[3][3]);
+        for (i = 0; i < 4; ++i) {
+            top = c[0][i] * (256 - fx) + c[1][i] * fx;
+            bottom = c[2][i] * (256 - fx) + c[3][i] * fx;
+            c[0][i] = (Uint8) ((top * (256 - fy) + bottom * fy) >> 16);
+        }
+        *r = c[0][0];
+        *g = c[0][1];
+        *b = c[0][2];
+        *a = c[0][3];
+        return SDL_TRUE;
+    } else {
+        int tx = (int) u;
+        int ty = (int) v;
+
+        tx = SDL_min(SDL_max(tx, rect->x), maxx);
+        ty = SDL_min(SDL_max(ty, rect->y), maxy);
+        return SW_ReadTexel(ctx, tx, ty, r, g, b, a);
+    }
+}
+
+/* Blend a source color into a destination color */
+static SDL_INLINE void
+SW_BlendRGBA(SDL_BlendMode blendMode, unsigned sr, unsigned sg, unsigned sb, unsigned sa,
+             Uint8 * dr, Uint8 * dg, Uint8 * db, Uint8 * da)
+{
+    unsigned inva;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        inva = 0xff - sa;
+        *dr = DRAW_MUL(sr, sa) + DRAW_MUL(inva, *dr);
+        *dg = DRAW_MUL(sg, sa) + DRAW_MUL(inva, *dg);
+        *db = DRAW_MUL(sb, sa) + DRAW_MUL(inva, *db);
+        *da = sa + DRAW_MUL(inva, *da);
+        break;
+    case SDL_BLENDMODE_ADD:
+        *dr = (Uint8) SDL_min(*dr + DRAW_MUL(sr, sa), 255);
+        *dg = (Uint8) SDL_min(*dg + DRAW_MUL(sg, sa), 255);
+        *db = (Uint8) SDL_min(*db + DRAW_MUL(sb, sa), 255);
+        break;
+    case SDL_BLENDMODE_MOD:
+        *dr = DRAW_MUL(sr, *dr);
+        *dg = DRAW_MUL(sg, *dg);
+        *db = DRAW_MUL(sb, *db);
+        break;
+    default:
+        *dr = sr;
+        *dg = sg;
+        *db = sb;
+        *da = sa;
+        break;
+    }
+}
+
+static void
+SW_FillSpan(SW_TriangleContext * ctx, int x1, int x2, int y,
+            float *attrib, const float *step)
+{
+    SDL_Surface *dst = ctx->dst;
+    SDL_Surface *src = ctx->src;
+    const int bpp = dst->format->BytesPerPixel;
+    Uint8 *pixel = (Uint8 *) dst->pixels + y * dst->pitch + x1 * bpp;
+    Uint8 sr, sg, sb, sa, dr, dg, db, da;
+    int x, i;
+
+    for (x = x1; x < x2; ++x) {
+        sr = SW_CLAMP_COLOR(attrib[SW_ATTRIB_R]);
+        sg = SW_CLAMP_COLOR(attrib[SW_ATTRIB_G]);
+        sb = SW_CLAMP_COLOR(attrib[SW_ATTRIB_B]);
+        sa = SW_CLAMP_COLOR(attrib[SW_ATTRIB_A]);
+
+        if (src) {
+            Uint8 tr, tg, tb, ta;
+
+            if (!SW_SampleTexture(ctx, attrib[SW_ATTRIB_U], attrib[SW_ATTRIB_V],
+                                  &tr, &tg, &tb, &ta)) {
+                goto next;
+            }
+            sr = DRAW_MUL(sr, tr);
+            sg = DRAW_MUL(sg, tg);
+            sb = DRAW_MUL(sb, tb);
+            sa = DRAW_MUL(sa, ta);
+        }
+
+        if (ctx->blendMode != SDL_BLENDMODE_NONE) {
+            SW_ReadRGBA(dst->format, ctx->dst_direct, pixel, &dr, &dg, &db, &da);
+        }
+        SW_BlendRGBA(ctx->blendMode, sr, sg, sb, sa, &dr, &dg, &db, &da);
+        SW_WriteRGBA(dst->format, ctx->dst_direct, pixel, dr, dg, db, da);
+
+      next:
+        pixel += bpp;
+        for (i = 0; i < SW_NUM_ATTRIBS; ++i) {
+            attrib[i] += step[i];
+        }
+    }
+}
+
+/* SW_FillSpan() for a texture with a constant color, between 32-bit
+   surfaces without a color key.  This is what rotated copies hit, so
+   it steps the texture coordinates in 16.16 fixed point and keeps the
+   formats in locals. */
+static void
+SW_CopySpan(SW_TriangleContext * ctx, int x1, int x2, int y,
+            const float *attrib, const float *step)
+{
+    const SDL_PixelFormat *srcfmt = ctx->src->format;
+    const SDL_PixelFormat *dstfmt = ctx->dst->format;
+    const Uint8 *srcpixels = (const Uint8 *) ctx->src->pixels;
+    const int srcpitch = ctx->src->pitch;
+    const Uint32 srcR = srcfmt->Rshift, srcG = srcfmt->Gshift, srcB = srcfmt->Bshift, srcA = srcfmt->Ashift;
+    const Uint32 srcAmask = srcfmt->Amask;
+    const Uint32 dstR = dstfmt->Rshift, dstG = dstfmt->Gshift, dstB = dstfmt->Bshift, dstA = dstfmt->Ashift;
+    const Uint32 dstAmask = dstfmt->Amask;
+    const int minu = ctx->texrect.x;
+    const int maxu = ctx->texrect.x + ctx->texrect.w - 1;
+    const int minv = ctx->texrect.y;
+    const int maxv = ctx->texrect.y + ctx->texrect.h - 1;
+    const SDL_BlendMode blendMode = ctx->blendMode;
+    const SDL_bool bilinear = ctx->bilinear;
+    const unsigned mr = SW_CLAMP_COLOR(attrib[SW_ATTRIB_R]);
+    const unsigned mg = SW_CLAMP_COLOR(attrib[SW_ATTRIB_G]);
+    const unsigned mb = SW_CLAMP_COLOR(attrib[SW_ATTRIB_B]);
+    const unsigned ma = SW_CLAMP_COLOR(attrib[SW_ATTRIB_A]);
+    const SDL_bool modulate = ((mr & mg & mb & ma) != 0xff) ? SDL_TRUE : SDL_FALSE;
+    const Sint32 du = (Sint32) (step[SW_ATTRIB_U] * 65536.0f);
+    const Sint32 dv = (Sint32) (step[SW_ATTRIB_V] * 65536.0f);
+    Sint32 u = (Sint32) (attrib[SW_ATTRIB_U] * 65536.0f);
+    Sint32 v = (Sint32) (attrib[SW_ATTRIB_V] * 65536.0f);
+    Uint32 *pixel = (Uint32 *) ((Uint8 *) ctx->dst->pixels + y * ctx->dst->pitch) + x1;
+    Uint32 *end = pixel + (x2 - x1);
+    Uint32 texel;
+    unsigned sr, sg, sb, sa;
+    Uint8 dr, dg, db, da;
+
+    for ( ; pixel < end; ++pixel, u += du, v += dv) {
+        if (bilinear) {
+            /* Texel centers are at half coordinates */
+            const Sint32 fu = u - 0x8000;
+            const Sint32 fv = v - 0x8000;
+            const unsigned fx = (fu >> 8) & 0xff;
+            const unsigned fy = (fv >> 8) & 0xff;
+            int u0 = fu >> 16, u1 = u0 + 1;
+            int v0 = fv >> 16, v1 = v0 + 1;
+            const Uint32 *row0, *row1;
+
+            u0 = SDL_min(SDL_max(u0, minu), maxu);
+            u1 = SDL_min(SDL_max(u1, minu), maxu);
+            v0 = SDL_min(SDL_max(v0, minv), maxv);
+            v1 = SDL_min(SDL_max(v1, minv), maxv);
+            row0 = (const Uint32 *) (srcpixels + v0 * srcpitch);
+            row1 = (const Uint32 *) (srcpixels + v1 * srcpitch);
+            texel = SW_Lerp32(SW_Lerp32(row0[u0], row0[u1], fx),
+                              SW_Lerp32(row1[u0], row1[u1], fx), fy);
+        } else {
+            int tu = u >> 16;
+            int tv = v >> 16;
+
+            tu = SDL_min(SDL_max(tu, minu), maxu);
+            tv = SDL_min(SDL_max(tv, minv), maxv);
+            texel = ((const Uint32 *) (srcpixels + tv * srcpitch))[tu];
+        }
+
+        sr = (Uint8) (texel >> srcR);
+        sg = (Uint8) (texel >> srcG);
+        sb = (Uint8) (texel >> srcB);
+        sa = srcAmask ? (Uint8) (texel >> srcA) : 0xff;
+        if (modulate) {
+            sr = DRAW_MUL(sr, mr);
+            sg = DRAW_MUL(sg, mg);
+            sb = DRAW_MUL(sb, mb);
+            sa = DRAW_MUL(sa, ma);
+        }
+
+        if (blendMode == SDL_BLENDMODE_BLEND) {
+            /* Sprites are mostly transparent or opaque */
+            if (sa == 0) {
+                continue;
+            }
+            if (sa == 0xff) {
+                *pixel = ((Uint32) sr << dstR) | ((Uint32) sg << dstG) | ((Uint32) sb << dstB) | dstAmask;
+                continue;
+            }
+        }
+        if (blendMode != SDL_BLENDMODE_NONE) {
+            const Uint32 pix = *pixel;
+            dr = (Uint8) (pix >> dstR);
+            dg = (Uint8) (pix >> dstG);
+            db = (Uint8) (pix >> dstB);
+            da = dstAmask ? (Uint8) (pix >> dstA) : 0xff;
+        }
+        SW_BlendRGBA(blendMode, sr, sg, sb, sa, &dr, &dg, &db, &da);
+        *pixel = ((Uint32) dr << dstR) | ((Uint32) dg << dstG) | ((Uint32) db << dstB) |
+                 (((Uint32) da << dstA) & dstAmask);
+    }
+}
+
+static void
+SW_FillTriangle(SW_TriangleContext * ctx, const SW_TriangleVertex * v0,
+                const SW_TriangleVertex * v1, const SW_TriangleVertex * v2)
+{
+    const SDL_Rect *clip = &ctx->dst->clip_rect;
+    const SW_TriangleVertex *edges[3][2];
+    float area, miny, maxy;
+    float dadx[SW_NUM_ATTRIBS], dady[SW_NUM_ATTRIBS], attrib[SW_NUM_ATTRIBS];
+    SDL_bool copy;
+    int y, y1, y2, i;
+
+    /* Make the winding counter-clockwise in a y-down coordinate system */
+    area = (v1->x - v0->x) * (v2->y - v0->y) - (v1->y - v0->y) * (v2->x - v0->x);
+    if (area == 0.0f) {
+        return;
+    }
+    if (area < 0.0f) {
+        const SW_TriangleVertex *tmp = v1;
+        v1 = v2;
+        v2 = tmp;
+        area = -area;
+    }
+
+    /* Plane equations for the attributes, relative to v0 */
+    for (i = 0; i < SW_NUM_ATTRIBS; ++i) {
+        if (v0->attrib[i] == v1->attrib[i] && v0->attrib[i] == v2->attrib[i]) {
+            /* Keep constant colors exact */
+            dadx[i] = dady[i] = 0.0f;
+            continue;
+        }
+        dadx[i] = ((v1->y - v2->y) * v0->attrib[i] +
+                   (v2->y - v0->y) * v1->attrib[i] +
+                   (v0->y - v1->y) * v2->attrib[i]) / area;
+        dady[i] = ((v2->x - v1->x) * v0->attrib[i] +
+                   (v0->x - v2->x) * v1->attrib[i] +
+                   (v1->x - v0->x) * v2->attrib[i]) / area;
+    }
+
+    copy = (ctx->src && ctx->src_direct && ctx->dst_direct && !ctx->colorkey &&
+            dadx[SW_ATTRIB_R] == 0.0f && dady[SW_ATTRIB_R] == 0.0f &&
+            dadx[SW_ATTRIB_G] == 0.0f && dady[SW_ATTRIB_G] == 0.0f &&
+            dadx[SW_ATTRIB_B] == 0.0f && dady[SW_ATTRIB_B] == 0.0f &&
+            dadx[SW_ATTRIB_A] == 0.0f && dady[SW_ATTRIB_A] == 0.0f) ? SDL_TRUE : SDL_FALSE;
+
+    edges[0][0] = v1; edges[0][1] = v2;
+    edges[1][0] = v2; edges[1][1] = v0;
+    edges[2][0] = v0; edges[2][1] = v1;
+
+    miny = SDL_min(v0->y, SDL_min(v1->y, v2->y));
+    maxy = SDL_max(v0->y, SDL_max(v1->y, v2->y));
+    y1 = SDL_max((int) SDL_ceil(miny - 0.5f), clip->y);
+    y2 = SDL_min((int) SDL_ceil(maxy - 0.5f), clip->y + clip->h);
+
+    for (y = y1; y < y2; ++y) {
+        const float py = y + 0.5f;
+        float left = (float) clip->x;
+        float right = (float) (clip->x + clip->w);
+        SDL_bool empty = SDL_FALSE;
+        int x1, x2;
+
+        /* Intersect the row with the inside of each edge */
+        for (i = 0; i < 3; ++i) {
+            const SW_TriangleVertex *a = edges[i][0];
+            const SW_TriangleVertex *b = edges[i][1];
+            const float ex = b->x - a->x;
+            const float ey = b->y - a->y;
+            const float c = ex * (py - a->y);
+
+            if (ey < 0.0f) {
+                left = SDL_max(left, a->x + c / ey);
+            } else if (ey > 0.0f) {
+                right = SDL_min(right, a->x + c / ey);
+            } else if (c < 0.0f || (c == 0.0f && ex <= 0.0f)) {
+                /* Outside a horizontal edge, or exactly on a bottom edge */
+                empty = SDL_TRUE;
+                break;
+            }
+        }
+        if (empty) {
+            continue;
+        }
+
+        x1 = (int) SDL_ceil(left - 0.5f);
+        x2 = (int) SDL_ceil(right - 0.5f);
+        if (x1 >= x2) {
+            continue;
+        }
+
+        for (i = 0; i < SW_NUM_ATTRIBS; ++i) {
+            attrib[i] = v0->attrib[i] + dadx[i] * (x1 + 0.5f - v0->x) + dady[i] * (py - v0->y);
+        }
+        if (copy) {
+            SW_CopySpan(ctx, x1, x2, y, attrib, dadx);
+        } else {
+            SW_FillSpan(ctx, x1, x2, y, attrib, dadx);
+        }
+
+        ctx->minx = SDL_min(ctx->minx, x1);
+        ctx->maxx = SDL_max(ctx->maxx, x2);
+        ctx->miny = SDL_min(ctx->miny, y);
+        ctx->maxy = SDL_max(ctx->maxy, y + 1);
+    }
+}
+
+static int
+SW_BeginTriangles(SW_TriangleContext * ctx, SDL_Surface * dst, SDL_Surface * texture,
+                  SDL_BlendMode blendMode)
+{
+    if (!dst) {
+        return SDL_SetError("Passed NULL destination surface");
+    }
+
+    /* This function doesn't work on surfaces < 8 bpp */
+    if (dst->format->BitsPerPixel < 8 ||
+        (texture && texture->format->BitsPerPixel < 8)) {
+        return SDL_SetError("SDL_SW_FillTriangles(): Unsupported surface format");
+    }
+
+    if (SDL_LockSurface(dst) < 0) {
+        return -1;
+    }
+    if (texture && SDL_LockSurface(texture) < 0) {
+        SDL_UnlockSurface(dst);
+        return -1;
+    }
+
+    SDL_zerop(ctx);
+    ctx->dst = dst;
+    ctx->src = texture;
+    ctx->dst_direct = SW_IsDirectFormat(dst->format);
+    if (texture) {
+        ctx->src_direct = SW_IsDirectFormat(texture->format);
+        ctx->texrect.w = texture->w;
+        ctx->texrect.h = texture->h;
+        ctx->colorkey = (SDL_GetColorKey(texture, &ctx->key) == 0) ? SDL_TRUE : SDL_FALSE;
+    }
+    ctx->blendMode = blendMode;
+    ctx->minx = dst->clip_rect.x + dst->clip_rect.w;
+    ctx->miny = dst->clip_rect.y + dst->clip_rect.h;
+    ctx->maxx = dst->clip_rect.x;
+    ctx->maxy = dst->clip_rect.y;
+    return 0;
+}
+
+static void
+SW_EndTriangles(SW_TriangleContext * ctx, SDL_Rect * bounds)
+{
+    if (ctx->src) {
+        SDL_UnlockSurface(ctx->src);
+    }
+    SDL_UnlockSurface(ctx->dst);
+
+    if (bounds) {
+        if (ctx->minx < ctx->maxx) {
+            bounds->x = ctx->minx;
+            bounds->y = ctx->miny;
+            bounds->w = ctx->maxx - ctx->minx;
+            bounds->h = ctx->maxy - ctx->miny;
+        } else {
+            SDL_zerop(bounds);
+        }
+    }
+}
+
+int
+SDL_SW_FillTriangles(SDL_Surface * dst, SDL_Surface * texture,
+                     const SDL_Vertex * vertices, int num_vertices,
+                     const int *indices, int num_indices,
+                     const SDL_Point * offset, const SDL_FPoint * scale,
+                     const SDL_Color * modulation, SDL_BlendMode blendMode,
+                     SDL_Rect * bounds)
+{
+    const int count = indices ? num_indices : num_vertices;
+    const float mr = modulation->r / 255.0f;
+    const float mg = modulation->g / 255.0f;
+    const float mb = modulation->b / 255.0f;
+    const float ma = modulation->a / 255.0f;
+    SW_TriangleContext ctx;
+    SW_TriangleVertex triangle[3];
+    int i, j;
+
+    if (SW_BeginTriangles(&ctx, dst, texture, blendMode) < 0) {
+        return -1;
+    }
+
+    for (i = 0; i + 2 < count; i += 3) {
+        for (j = 0; j < 3; ++j) {
+            const SDL_Vertex *vertex = &vertices[indices ? indices[i + j] : i + j];
+            SW_TriangleVertex *v = &triangle[j];
+
+            v->x = vertex->position.x * scale->x + offset->x;
+            v->y = vertex->position.y * scale->y + offset->y;
+            v->attrib[SW_ATTRIB_U] = texture ? vertex->tex_coord.x * texture->w : 0.0f;
+            v->attrib[SW_ATTRIB_V] = texture ? vertex->tex_coord.y * texture->h : 0.0f;
+            v->attrib[SW_ATTRIB_R] = vertex->color.r * mr;
+            v->attrib[SW_ATTRIB_G] = vertex->color.g * mg;
+            v->attrib[SW_ATTRIB_B] = vertex->color.b * mb;
+            v->attrib[SW_ATTRIB_A] = vertex->color.a * ma;
+        }
+        SW_FillTriangle(&ctx, &triangle[0], &triangle[1], &triangle[2]);
+    }
+
+    SW_EndTriangles(&ctx, bounds);
+    return 0;
+}
+
+int
+SDL_SW_BlitAffine(SDL_Surface * src, const SDL_Rect * srcrect,
+                  SDL_Surface * dst, const SDL_FPoint * corners,
+                  SDL_bool bilinear, SDL_Rect * bounds)
+{
+    SW_TriangleContext ctx;
+    SW_TriangleVertex quad[4];
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    int i;
+
+    if (!src) {
+        return SDL_SetError("Passed NULL source surface");
+    }
+    if (SDL_RectEmpty(srcrect)) {
+        if (bounds) {
+            SDL_zerop(bounds);
+        }
+        return 0;
+    }
+
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+
+    if (SW_BeginTriangles(&ctx, dst, src, blendMode) < 0) {
+        return -1;
+    }
+    ctx.texrect = *srcrect;
+    ctx.bilinear = bilinear;
+
+    /* The corners map to the source rectangle clockwise from the top left */
+    for (i = 0; i < 4; ++i) {
+        SW_TriangleVertex *v = &quad[i];
+
+        v->x = corners[i].x;
+        v->y = corners[i].y;
+        v->attrib[SW_ATTRIB_U] = (float) ((i == 1 || i == 2) ? srcrect->x + srcrect->w : srcrect->x);
+        v->attrib[SW_ATTRIB_V] = (float) ((i >= 2) ? srcrect->y + srcrect->h : srcrect->y);
+        v->attrib[SW_ATTRIB_R] = r;
+        v->attrib[SW_ATTRIB_G] = g;
+        v->attrib[SW_ATTRIB_B] = b;
+        v->attrib[SW_ATTRIB_A] = a;
+    }
+    SW_FillTriangle(&ctx, &quad[0], &quad[1], &quad[2]);
+    SW_FillTriangle(&ctx, &quad[0], &quad[2], &quad[3]);
+
+    SW_EndTriangles(&ctx, bounds);
+    return 0;
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
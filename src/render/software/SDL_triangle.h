@@ -0,0 +1,46 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2015 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#include "SDL_render.h"
+
+
+/* Rasterize triangles given in renderer coordinates.  Positions are scaled
+   by 'scale' and moved by 'offset', the result is clipped to the clip
+   rectangle of 'dst'.  If 'bounds' is not NULL it receives the rectangle
+   that was touched. */
+extern int SDL_SW_FillTriangles(SDL_Surface * dst, SDL_Surface * texture,
+                                const SDL_Vertex * vertices, int num_vertices,
+                                const int *indices, int num_indices,
+                                const SDL_Point * offset, const SDL_FPoint * scale,
+                                const SDL_Color * modulation, SDL_BlendMode blendMode,
+                                SDL_Rect * bounds);
+
+/* Map 'srcrect' of 'src' onto the quadrilateral 'corners' of 'dst', applying
+   the color mod, alpha mod, color key and blend mode of 'src'.  The four
+   corners match the top left, top right, bottom right and bottom left of
+   'srcrect', in surface coordinates.  If 'bounds' is not NULL it receives
+   the rectangle that was touched. */
+extern int SDL_SW_BlitAffine(SDL_Surface * src, const SDL_Rect * srcrect,
+                             SDL_Surface * dst, const SDL_FPoint * corners,
+                             SDL_bool bilinear, SDL_Rect * bounds);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -386,4 +386,45 @@ SDL_RemoveTimer(SDL_TimerID id)
     return canceled;
 }
 
+/* SDL_GetTicksNS() counts from the SDL_GetTicks() value when the ticks
+   were started, using the performance counter from there on. */
+static SDL_bool ticks_ns_started = SDL_FALSE;
+static Uint32 ticks_ns_start_ticks;
+static Uint64 ticks_ns_start_counter;
+
+void
+SDL_TicksNSInit(void)
+{
+    if (ticks_ns_started) {
+        return;
+    }
+    ticks_ns_start_ticks = SDL_GetTicks();
+    ticks_ns_start_counter = SDL_GetPerformanceCounter();
+    ticks_ns_started = SDL_TRUE;
+}
+
+void
+SDL_TicksNSQuit(void)
+{
+    ticks_ns_started = SDL_FALSE;
+}
+
+Uint64
+SDL_GetTicksNS(void)
+{
+    Uint64 elapsed, frequency;
+
+    if (!ticks_ns_started) {
+        SDL_TicksInit();
+    }
+
+    frequency = SDL_GetPerformanceFrequency();
+    elapsed = SDL_GetPerformanceCounter() - ticks_ns_start_counter;
+
+    /* Split the conversion so it can't overflow */
+    return ((Uint64) ticks_ns_start_ticks * 1000000) +
+           (elapsed / frequency) * 1000000000 +
+           ((elapsed % frequency) * 1000000000) / frequency;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
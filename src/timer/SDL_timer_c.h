@@ -28,6 +28,8 @@
 
 extern void SDL_TicksInit(void);
 extern void SDL_TicksQuit(void);
+extern void SDL_TicksNSInit(void);
+extern void SDL_TicksNSQuit(void);
 extern int SDL_TimerInit(void);
 extern void SDL_TimerQuit(void);
 
@@ -28,6 +28,7 @@
 #include <errno.h>
 
 #include "SDL_timer.h"
+#include "../SDL_timer_c.h"
 #include "SDL_assert.h"
 
 /* The clock_gettime provides monotonous time, so we should use it if
@@ -91,6 +92,8 @@ SDL_TicksInit(void)
     {
         gettimeofday(&start_tv, NULL);
     }
+
+    SDL_TicksNSInit();
 }
 
 void
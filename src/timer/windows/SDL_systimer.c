@@ -26,6 +26,7 @@
 #include <mmsystem.h>
 
 #include "SDL_timer.h"
+#include "../SDL_timer_c.h"
 #include "SDL_hints.h"
 
 
@@ -102,6 +103,8 @@ SDL_TicksInit(void)
         start = timeGetTime();
 #endif /* __WINRT__ */
     }
+
+    SDL_TicksNSInit();
 }
 
 void
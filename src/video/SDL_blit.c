@@ -84,6 +84,19 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
             info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
         RunBlit = (SDL_BlitFunc) src->map->data;
 
+        /* SIMD aligned surfaces own the padding at the end of each row, so
+           a full width copy between them can run as a single aligned span */
+        if (RunBlit == SDL_BlitCopy &&
+            (src->flags & dst->flags & SDL_SIMD_ALIGNED) &&
+            src->w == dst->w && src->pitch == dst->pitch &&
+            srcrect->x == 0 && srcrect->w == src->w &&
+            dstrect->x == 0 && info->dst_fmt->BytesPerPixel != 3) {
+            info->dst_w = (dst->pitch / info->dst_fmt->BytesPerPixel) * dstrect->h;
+            info->dst_h = 1;
+            info->src_pitch = info->dst_pitch = dst->pitch * dstrect->h;
+            info->src_skip = info->dst_skip = 0;
+        }
+
         /* Run the actual software blit */
         RunBlit(info);
     }
@@ -21,6 +21,7 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 
 
@@ -238,6 +239,7 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 {
     SDL_Rect clipped;
     Uint8 *pixels;
+    int w, h;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -268,8 +270,22 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         return SDL_SetError("SDL_FillRect(): You must lock the surface");
     }
 
+    if (dst->flags & SDL_DIRTYTRACKED) {
+        SDL_AddWindowSurfaceDirtyRect(dst, rect);
+    }
+
     pixels = (Uint8 *) dst->pixels + rect->y * dst->pitch +
                                      rect->x * dst->format->BytesPerPixel;
+    w = rect->w;
+    h = rect->h;
+
+    /* SIMD aligned surfaces own the padding at the end of each row, so a
+       full width fill can run as a single aligned span */
+    if ((dst->flags & SDL_SIMD_ALIGNED) && rect->x == 0 && rect->w == dst->w &&
+        dst->format->BytesPerPixel != 3) {
+        w = (dst->pitch / dst->format->BytesPerPixel) * h;
+        h = 1;
+    }
 
     switch (dst->format->BytesPerPixel) {
     case 1:
@@ -278,11 +294,11 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect1SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect1(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect1(pixels, dst->pitch, color, w, h);
             break;
         }
 
@@ -291,18 +307,18 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect2SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect2(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect2(pixels, dst->pitch, color, w, h);
             break;
         }
 
     case 3:
         /* 24-bit RGB is a slow path, at least for now. */
         {
-            SDL_FillRect3(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect3(pixels, dst->pitch, color, w, h);
             break;
         }
 
@@ -310,11 +326,11 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         {
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect4SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect4(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect4(pixels, dst->pitch, color, w, h);
             break;
         }
     }
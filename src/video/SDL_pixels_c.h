@@ -33,6 +33,10 @@ extern void SDL_InvalidateMap(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
+/* Surface pixel storage functions, found in SDL_surface.c */
+extern void *SDL_AllocSurfacePixels(SDL_Surface * surface);
+extern void SDL_FreeSurfacePixels(SDL_Surface * surface);
+
 /* Miscellaneous functions */
 extern int SDL_CalculatePitch(SDL_Surface * surface);
 extern void SDL_DitherColors(SDL_Color * colors, int bpp);
@@ -522,4 +522,131 @@ SDL_GetSpanEnclosingRect(int width, int height,
     return SDL_FALSE;
 }
 
+static Sint64
+SDL_RectArea(const SDL_Rect * rect)
+{
+    return (Sint64) rect->w * rect->h;
+}
+
+static SDL_bool
+SDL_RectContains(const SDL_Rect * outer, const SDL_Rect * inner)
+{
+    return (inner->x >= outer->x && inner->y >= outer->y &&
+            inner->x + inner->w <= outer->x + outer->w &&
+            inner->y + inner->h <= outer->y + outer->h);
+}
+
+/* Merge rectangles that overlap or share an edge, as long as the bounding
+   box doesn't cost more pixels than updating the two separately */
+static SDL_bool
+SDL_ShouldMergeDirtyRects(const SDL_Rect * A, const SDL_Rect * B,
+                          const SDL_Rect * merged)
+{
+    if (A->x > B->x + B->w || B->x > A->x + A->w ||
+        A->y > B->y + B->h || B->y > A->y + A->h) {
+        return SDL_FALSE;
+    }
+    return (SDL_RectArea(merged) <= SDL_RectArea(A) + SDL_RectArea(B));
+}
+
+void
+SDL_AddDirtyRect(SDL_DirtyRegion * region, const SDL_Rect * rect)
+{
+    SDL_Rect dirty = *rect;
+    SDL_Rect merged;
+    int i;
+
+    if (SDL_RectEmpty(&dirty)) {
+        return;
+    }
+
+    for (;;) {
+        SDL_bool changed = SDL_FALSE;
+
+        for (i = 0; i < region->numrects; ) {
+            SDL_Rect *existing = &region->rects[i];
+
+            if (SDL_RectContains(existing, &dirty)) {
+                return;
+            }
+            SDL_UnionRect(existing, &dirty, &merged);
+            if (SDL_RectContains(&dirty, existing) ||
+                SDL_ShouldMergeDirtyRects(existing, &dirty, &merged)) {
+                /* Absorb it and rescan, the bigger rect may now merge with
+                   rectangles we already looked at */
+                dirty = merged;
+                region->rects[i] = region->rects[--region->numrects];
+                changed = SDL_TRUE;
+            } else {
+                ++i;
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    if (region->numrects == SDL_MAX_DIRTY_RECTS) {
+        /* We're full, fold into whichever rectangle grows the least */
+        Sint64 growth, best_growth = 0;
+        int best = 0;
+
+        for (i = 0; i < region->numrects; ++i) {
+            SDL_UnionRect(&region->rects[i], &dirty, &merged);
+            growth = SDL_RectArea(&merged) - SDL_RectArea(&region->rects[i]);
+            if (i == 0 || growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        SDL_UnionRect(&region->rects[best], &dirty, &merged);
+        region->rects[best] = region->rects[--region->numrects];
+        SDL_AddDirtyRect(region, &merged);
+        return;
+    }
+    region->rects[region->numrects++] = dirty;
+}
+
+void
+SDL_SubtractDirtyRect(SDL_DirtyRegion * region, const SDL_Rect * rect)
+{
+    int i;
+
+    if (SDL_RectEmpty(rect)) {
+        return;
+    }
+
+    for (i = 0; i < region->numrects; ) {
+        SDL_Rect *dirty = &region->rects[i];
+        const int rect_r = rect->x + rect->w;
+        const int rect_b = rect->y + rect->h;
+        const int dirty_r = dirty->x + dirty->w;
+        const int dirty_b = dirty->y + dirty->h;
+
+        if (SDL_RectContains(rect, dirty)) {
+            region->rects[i] = region->rects[--region->numrects];
+            continue;
+        }
+
+        /* Only trim what's left as a single rectangle, anything that would
+           split it stays dirty and gets presented again later */
+        if (rect->x <= dirty->x && rect_r >= dirty_r) {
+            if (rect->y <= dirty->y && rect_b > dirty->y) {
+                dirty->h = dirty_b - rect_b;
+                dirty->y = rect_b;
+            } else if (rect->y < dirty_b && rect_b >= dirty_b) {
+                dirty->h = rect->y - dirty->y;
+            }
+        } else if (rect->y <= dirty->y && rect_b >= dirty_b) {
+            if (rect->x <= dirty->x && rect_r > dirty->x) {
+                dirty->w = dirty_r - rect_r;
+                dirty->x = rect_r;
+            } else if (rect->x < dirty_r && rect_r >= dirty_r) {
+                dirty->w = rect->x - dirty->x;
+            }
+        }
+        ++i;
+    }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
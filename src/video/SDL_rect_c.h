@@ -20,6 +20,25 @@
 */
 #include "../SDL_internal.h"
 
+#ifndef _SDL_rect_c_h
+#define _SDL_rect_c_h
+
 extern SDL_bool SDL_GetSpanEnclosingRect(int width, int height, int numrects, const SDL_Rect * rects, SDL_Rect *span);
 
+/* A bounded set of rectangles that have changed since the last update.
+   Overlapping and adjacent rectangles are merged as they are added. */
+#define SDL_MAX_DIRTY_RECTS 16
+
+typedef struct SDL_DirtyRegion
+{
+    int numrects;
+    SDL_Rect rects[SDL_MAX_DIRTY_RECTS];
+} SDL_DirtyRegion;
+
+extern void SDL_AddDirtyRect(SDL_DirtyRegion * region, const SDL_Rect * rect);
+/* Drops or trims the rectangles that the given one has brought up to date */
+extern void SDL_SubtractDirtyRect(SDL_DirtyRegion * region, const SDL_Rect * rect);
+
+#endif /* _SDL_rect_c_h */
+
 /* vi: set ts=4 sw=4 expandtab: */
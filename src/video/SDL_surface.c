@@ -21,11 +21,177 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+/* Allocate pixel storage honoring the SDL_SIMD_ALIGNED flag */
+void *
+SDL_AllocSurfacePixels(SDL_Surface * surface)
+{
+    const size_t size = (size_t) surface->h * surface->pitch;
+
+    if (surface->flags & SDL_SIMD_ALIGNED) {
+        return SDL_SIMDAlloc(size);
+    }
+    return SDL_malloc(size);
+}
+
+void
+SDL_FreeSurfacePixels(SDL_Surface * surface)
+{
+    if (surface->flags & SDL_SIMD_ALIGNED) {
+        SDL_SIMDFree(surface->pixels);
+    } else {
+        SDL_free(surface->pixels);
+    }
+    surface->pixels = NULL;
+}
+
+/* Surfaces created with SDL_POOLED carry their pool bookkeeping after the
+   public structure, so SDL_FreeSurface() can hand them back for reuse */
+typedef struct SDL_PooledSurface
+{
+    SDL_Surface surface;
+    int w, h;                   /* dimensions the pixels were allocated for */
+    Uint32 flags;               /* allocation flags, without SDL_POOLED */
+    void *pixels;               /* the buffer we allocated */
+    struct SDL_PooledSurface *next;
+} SDL_PooledSurface;
+
+#define SDL_SURFACE_POOL_DEFAULT_BYTES  (16 * 1024 * 1024)
+
+static SDL_SpinLock SDL_surface_pool_lock = 0;
+static SDL_PooledSurface *SDL_surface_pool = NULL;
+static size_t SDL_surface_pool_bytes = 0;
+
+static void SDL_DestroySurface(SDL_Surface * surface);
+
+static size_t
+SDL_GetSurfacePoolLimit(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_POOL_SIZE);
+    if (hint) {
+        return (size_t) SDL_strtoull(hint, NULL, 0);
+    }
+    return SDL_SURFACE_POOL_DEFAULT_BYTES;
+}
+
+static SDL_Surface *
+SDL_TakePooledSurface(int width, int height, Uint32 format, Uint32 flags)
+{
+    SDL_PooledSurface *pooled, *prev = NULL;
+    SDL_Surface *surface;
+
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    for (pooled = SDL_surface_pool; pooled; prev = pooled, pooled = pooled->next) {
+        if (pooled->w == width && pooled->h == height && pooled->flags == flags &&
+            pooled->surface.format->format == format) {
+            if (prev) {
+                prev->next = pooled->next;
+            } else {
+                SDL_surface_pool = pooled->next;
+            }
+            SDL_surface_pool_bytes -= (size_t) pooled->h * pooled->surface.pitch;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+
+    if (!pooled) {
+        return NULL;
+    }
+
+    /* Reset everything the previous owner could have changed.  The format
+       and blit map are reused as is, and the pixel contents are undefined. */
+    pooled->next = NULL;
+    surface = &pooled->surface;
+    surface->flags = pooled->flags | SDL_POOLED;
+    surface->w = pooled->w;
+    surface->h = pooled->h;
+    surface->pixels = pooled->pixels;
+    surface->userdata = NULL;
+    SDL_SetClipRect(surface, NULL);
+    surface->map->info.flags = 0;
+    surface->map->info.r = 0xFF;
+    surface->map->info.g = 0xFF;
+    surface->map->info.b = 0xFF;
+    surface->map->info.a = 0xFF;
+    surface->map->info.colorkey = 0;
+    if (surface->format->Amask) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
+    }
+    surface->refcount = 1;
+    return surface;
+}
+
+/* Returns SDL_TRUE if the pool took ownership of the surface */
+static SDL_bool
+SDL_ReturnSurfaceToPool(SDL_Surface * surface)
+{
+    SDL_PooledSurface *pooled = (SDL_PooledSurface *) surface;
+    SDL_PooledSurface *evict = NULL;
+    const size_t limit = SDL_GetSurfacePoolLimit();
+    const size_t size = (size_t) pooled->h * surface->pitch;
+
+    /* Skip surfaces whose pixels were RLE encoded away or swapped out */
+    if (!surface->pixels || surface->pixels != pooled->pixels || size > limit) {
+        return SDL_FALSE;
+    }
+
+    /* Drop our reference to the last blit target before parking the map */
+    SDL_InvalidateMap(surface->map);
+
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    pooled->next = SDL_surface_pool;
+    SDL_surface_pool = pooled;
+    SDL_surface_pool_bytes += size;
+
+    /* Evict the least recently returned surfaces until we're under budget */
+    if (SDL_surface_pool_bytes > limit) {
+        SDL_PooledSurface *keep = pooled;
+        size_t bytes = size;
+
+        while (keep->next &&
+               bytes + (size_t) keep->next->h * keep->next->surface.pitch <= limit) {
+            keep = keep->next;
+            bytes += (size_t) keep->h * keep->surface.pitch;
+        }
+        evict = keep->next;
+        keep->next = NULL;
+        SDL_surface_pool_bytes = bytes;
+    }
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+
+    while (evict) {
+        SDL_PooledSurface *next = evict->next;
+        SDL_DestroySurface(&evict->surface);
+        evict = next;
+    }
+    return SDL_TRUE;
+}
+
+void
+SDL_FlushSurfacePool(void)
+{
+    SDL_PooledSurface *pooled;
+
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    pooled = SDL_surface_pool;
+    SDL_surface_pool = NULL;
+    SDL_surface_pool_bytes = 0;
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+
+    while (pooled) {
+        SDL_PooledSurface *next = pooled->next;
+        SDL_DestroySurface(&pooled->surface);
+        pooled = next;
+    }
+}
+
 /* Public routines */
 /*
  * Create an empty RGB surface of the appropriate depth
@@ -37,9 +203,7 @@ SDL_CreateRGBSurface(Uint32 flags,
 {
     SDL_Surface *surface;
     Uint32 format;
-
-    /* The flags are no longer used, make the compiler happy */
-    (void)flags;
+    SDL_bool pooled;
 
     /* Get the pixel format */
     format = SDL_MasksToPixelFormatEnum(depth, Rmask, Gmask, Bmask, Amask);
@@ -48,8 +212,24 @@ SDL_CreateRGBSurface(Uint32 flags,
         return NULL;
     }
 
+    /* Palettes are owned by the surface and empty surfaces own nothing,
+       so there's nothing worth recycling for those */
+    pooled = (flags & SDL_POOLED) && width > 0 && height > 0 &&
+             !SDL_ISPIXELFORMAT_INDEXED(format);
+    flags &= SDL_SIMD_ALIGNED;
+    if (pooled) {
+        surface = SDL_TakePooledSurface(width, height, format, flags);
+        if (surface) {
+            return surface;
+        }
+    }
+
     /* Allocate the surface */
-    surface = (SDL_Surface *) SDL_calloc(1, sizeof(*surface));
+    if (pooled) {
+        surface = (SDL_Surface *) SDL_calloc(1, sizeof(SDL_PooledSurface));
+    } else {
+        surface = (SDL_Surface *) SDL_calloc(1, sizeof(*surface));
+    }
     if (surface == NULL) {
         SDL_OutOfMemory();
         return NULL;
@@ -63,6 +243,11 @@ SDL_CreateRGBSurface(Uint32 flags,
     surface->w = width;
     surface->h = height;
     surface->pitch = SDL_CalculatePitch(surface);
+    if (flags & SDL_SIMD_ALIGNED) {
+        const int alignment = (int) SDL_SIMDGetAlignment();
+        surface->flags |= SDL_SIMD_ALIGNED;
+        surface->pitch = (surface->pitch + alignment - 1) & ~(alignment - 1);
+    }
     SDL_SetClipRect(surface, NULL);
 
     if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
@@ -87,7 +272,7 @@ SDL_CreateRGBSurface(Uint32 flags,
 
     /* Get the pixels */
     if (surface->w && surface->h) {
-        surface->pixels = SDL_malloc(surface->h * surface->pitch);
+        surface->pixels = SDL_AllocSurfacePixels(surface);
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
@@ -109,6 +294,15 @@ SDL_CreateRGBSurface(Uint32 flags,
         SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
     }
 
+    if (pooled) {
+        SDL_PooledSurface *data = (SDL_PooledSurface *) surface;
+        data->w = surface->w;
+        data->h = surface->h;
+        data->flags = surface->flags;
+        data->pixels = surface->pixels;
+        surface->flags |= SDL_POOLED;
+    }
+
     /* The surface is ready to go */
     surface->refcount = 1;
     return surface;
@@ -515,6 +709,9 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
 /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
 /*              dst->map->info.flags, src->map->blit); */
     }
+    if (dst->flags & SDL_DIRTYTRACKED) {
+        SDL_AddWindowSurfaceDirtyRect(dst, dstrect);
+    }
     return (src->map->blit(src, srcrect, dst, dstrect));
 }
 
@@ -790,6 +987,9 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
     if ( !(src->map->info.flags & complex_copy_flags) &&
          src->format->format == dst->format->format &&
          !SDL_ISPIXELFORMAT_INDEXED(src->format->format) ) {
+        if (dst->flags & SDL_DIRTYTRACKED) {
+            SDL_AddWindowSurfaceDirtyRect(dst, dstrect);
+        }
         return SDL_SoftStretch( src, srcrect, dst, dstrect );
     } else {
         return SDL_LowerBlit( src, srcrect, dst, dstrect );
@@ -1130,6 +1330,15 @@ SDL_FreeSurface(SDL_Surface * surface)
     if (surface->flags & SDL_RLEACCEL) {
         SDL_UnRLESurface(surface, 0);
     }
+    if ((surface->flags & SDL_POOLED) && SDL_ReturnSurfaceToPool(surface)) {
+        return;
+    }
+    SDL_DestroySurface(surface);
+}
+
+static void
+SDL_DestroySurface(SDL_Surface * surface)
+{
     if (surface->format) {
         SDL_SetSurfacePalette(surface, NULL);
         SDL_FreeFormat(surface->format);
@@ -1140,7 +1349,7 @@ SDL_FreeSurface(SDL_Surface * surface)
         surface->map = NULL;
     }
     if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
+        SDL_FreeSurfacePixels(surface);
     }
     SDL_free(surface);
 }
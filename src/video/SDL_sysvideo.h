@@ -26,6 +26,7 @@
 #include "SDL_messagebox.h"
 #include "SDL_shape.h"
 #include "SDL_thread.h"
+#include "SDL_rect_c.h"
 
 /* The SDL video driver */
 
@@ -92,6 +93,7 @@ struct SDL_Window
 
     SDL_Surface *surface;
     SDL_bool surface_valid;
+    SDL_DirtyRegion surface_dirty;
 
     SDL_bool is_hiding;
     SDL_bool is_destroying;
@@ -248,6 +250,13 @@ struct SDL_VideoDevice
      */
     void (*PumpEvents) (_THIS);
 
+    /* Optional: block until PumpEvents() may have something to do, for at
+       most 'timeout' ms (-1 for no limit), returns 0 if the time ran out.
+       SendWakeupEvent() ends the wait early and may be called from any
+       thread; drivers implement both or neither. */
+    int (*WaitEventTimeout) (_THIS, int timeout);
+    void (*SendWakeupEvent) (_THIS);
+
     /* Suspend the screensaver */
     void (*SuspendScreenSaver) (_THIS);
 
@@ -425,6 +434,7 @@ extern void SDL_OnWindowFocusGained(SDL_Window * window);
 extern void SDL_OnWindowFocusLost(SDL_Window * window);
 extern void SDL_UpdateWindowGrab(SDL_Window * window);
 extern SDL_Window * SDL_GetFocusWindow(void);
+extern void SDL_AddWindowSurfaceDirtyRect(SDL_Surface * surface, const SDL_Rect * rect);
 
 extern SDL_bool SDL_ShouldAllowTopmost(void);
 
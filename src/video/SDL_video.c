@@ -2086,13 +2086,48 @@ SDL_GetWindowSurface(SDL_Window * window)
         }
         window->surface = SDL_CreateWindowFramebuffer(window);
         if (window->surface) {
+            const char *hint = SDL_GetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING);
+
             window->surface_valid = SDL_TRUE;
             window->surface->flags |= SDL_DONTFREE;
+            if (hint && SDL_atoi(hint) > 0) {
+                /* The first update has to show everything */
+                window->surface->flags |= SDL_DIRTYTRACKED;
+                window->surface_dirty.numrects = 1;
+                window->surface_dirty.rects[0].x = 0;
+                window->surface_dirty.rects[0].y = 0;
+                window->surface_dirty.rects[0].w = window->surface->w;
+                window->surface_dirty.rects[0].h = window->surface->h;
+            }
         }
     }
     return window->surface;
 }
 
+void
+SDL_AddWindowSurfaceDirtyRect(SDL_Surface * surface, const SDL_Rect * rect)
+{
+    SDL_Window *window;
+
+    if (!_this) {
+        return;
+    }
+    for (window = _this->windows; window; window = window->next) {
+        if (window->surface == surface) {
+            SDL_Rect bounds, clipped;
+
+            bounds.x = 0;
+            bounds.y = 0;
+            bounds.w = surface->w;
+            bounds.h = surface->h;
+            if (SDL_IntersectRect(rect, &bounds, &clipped)) {
+                SDL_AddDirtyRect(&window->surface_dirty, &clipped);
+            }
+            return;
+        }
+    }
+}
+
 int
 SDL_UpdateWindowSurface(SDL_Window * window)
 {
@@ -2100,6 +2135,16 @@ SDL_UpdateWindowSurface(SDL_Window * window)
 
     CHECK_WINDOW_MAGIC(window, -1);
 
+    if (window->surface_valid && (window->surface->flags & SDL_DIRTYTRACKED)) {
+        SDL_DirtyRegion dirty = window->surface_dirty;
+
+        if (dirty.numrects == 0) {
+            return 0;
+        }
+        window->surface_dirty.numrects = 0;
+        return _this->UpdateWindowFramebuffer(_this, window, dirty.rects, dirty.numrects);
+    }
+
     full_rect.x = 0;
     full_rect.y = 0;
     full_rect.w = window->w;
@@ -2111,13 +2156,35 @@ int
 SDL_UpdateWindowSurfaceRects(SDL_Window * window, const SDL_Rect * rects,
                              int numrects)
 {
+    SDL_DirtyRegion dirty;
+    SDL_Rect bounds, clipped;
+    int i;
+
     CHECK_WINDOW_MAGIC(window, -1);
 
     if (!window->surface_valid) {
         return SDL_SetError("Window surface is invalid, please call SDL_GetWindowSurface() to get a new surface");
     }
 
-    return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
+    /* Drivers issue one copy per rectangle, so clip and merge the list
+       down to a few larger rectangles before handing it over */
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = window->surface->w;
+    bounds.h = window->surface->h;
+    dirty.numrects = 0;
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_IntersectRect(&rects[i], &bounds, &clipped)) {
+            SDL_AddDirtyRect(&dirty, &clipped);
+        }
+    }
+
+    /* Only forget the tracked changes that this update actually covers */
+    for (i = 0; i < dirty.numrects; ++i) {
+        SDL_SubtractDirtyRect(&window->surface_dirty, &dirty.rects[i]);
+    }
+
+    return _this->UpdateWindowFramebuffer(_this, window, dirty.rects, dirty.numrects);
 }
 
 int
@@ -22,14 +22,206 @@
 
 #if SDL_VIDEO_DRIVER_DUMMY
 
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
 #include "../SDL_sysvideo.h"
 #include "SDL_nullframebuffer_c.h"
 
 
-#define DUMMY_SURFACE   "_SDL_DummySurface"
+#define DUMMY_FRAMEBUFFER   "_SDL_DummyFramebuffer"
+
+/* How many frames the save thread may fall behind before updates block */
+#define DUMMY_MAX_QUEUED_FRAMES 8
+
+typedef enum
+{
+    DUMMY_SAVE_NONE,
+    DUMMY_SAVE_BMP,
+    DUMMY_SAVE_RAW
+} DUMMY_SaveFormat;
+
+typedef struct
+{
+    SDL_Surface *surface;
+    int frame_number;
+
+    /* Update timing, in performance counter ticks */
+    Uint32 num_updates;
+    Uint64 first_update;
+    Uint64 last_update;
+    Uint64 total_time;
+    Uint64 min_time;
+    Uint64 max_time;
+} DUMMY_Framebuffer;
+
+typedef struct DUMMY_QueuedFrame
+{
+    SDL_Surface *surface;
+    DUMMY_SaveFormat format;
+    char file[128];
+    struct DUMMY_QueuedFrame *next;
+} DUMMY_QueuedFrame;
+
+/* Frames waiting to be written by the save thread */
+static struct
+{
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    DUMMY_QueuedFrame *head;
+    DUMMY_QueuedFrame *tail;
+    int count;
+    SDL_bool quit;
+} save_queue;
+
+static DUMMY_SaveFormat
+DUMMY_GetSaveFormat(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES);
+
+    if (!hint || !*hint || SDL_strcmp(hint, "0") == 0) {
+        return DUMMY_SAVE_NONE;
+    }
+    if (SDL_strcasecmp(hint, "raw") == 0) {
+        return DUMMY_SAVE_RAW;
+    }
+    return DUMMY_SAVE_BMP;
+}
+
+static void
+DUMMY_SaveFrame(SDL_Surface *surface, DUMMY_SaveFormat format, const char *file)
+{
+    if (format == DUMMY_SAVE_RAW) {
+        SDL_RWops *dst = SDL_RWFromFile(file, "wb");
+        const Uint8 *row = (const Uint8 *) surface->pixels;
+        const size_t length = surface->w * surface->format->BytesPerPixel;
+        int y;
+
+        if (!dst) {
+            return;
+        }
+        for (y = 0; y < surface->h; ++y) {
+            SDL_RWwrite(dst, row, length, 1);
+            row += surface->pitch;
+        }
+        SDL_RWclose(dst);
+    } else {
+        SDL_SaveBMP(surface, file);
+    }
+}
+
+static int SDLCALL
+DUMMY_SaveThread(void *unused)
+{
+    DUMMY_QueuedFrame *frame;
+
+    SDL_LockMutex(save_queue.lock);
+    for ( ; ; ) {
+        while (!save_queue.head && !save_queue.quit) {
+            SDL_CondWait(save_queue.cond, save_queue.lock);
+        }
+
+        /* Drain the queue before honoring a quit request */
+        frame = save_queue.head;
+        if (!frame) {
+            break;
+        }
+        save_queue.head = frame->next;
+        if (!save_queue.head) {
+            save_queue.tail = NULL;
+        }
+        --save_queue.count;
+        SDL_CondBroadcast(save_queue.cond);
+        SDL_UnlockMutex(save_queue.lock);
+
+        DUMMY_SaveFrame(frame->surface, frame->format, frame->file);
+        SDL_FreeSurface(frame->surface);
+        SDL_free(frame);
+
+        SDL_LockMutex(save_queue.lock);
+    }
+    SDL_UnlockMutex(save_queue.lock);
+
+    return 0;
+}
+
+static int
+DUMMY_QueueFrame(SDL_Surface *surface, DUMMY_SaveFormat format, const char *file)
+{
+    DUMMY_QueuedFrame *frame;
+
+    if (!save_queue.thread) {
+        save_queue.lock = SDL_CreateMutex();
+        save_queue.cond = SDL_CreateCond();
+        if (!save_queue.lock || !save_queue.cond) {
+            SDL_DUMMY_QuitFramebuffer(NULL);
+            return -1;
+        }
+        save_queue.quit = SDL_FALSE;
+        save_queue.thread = SDL_CreateThread(DUMMY_SaveThread, "SDLDummySave", NULL);
+        if (!save_queue.thread) {
+            SDL_DUMMY_QuitFramebuffer(NULL);
+            return -1;
+        }
+    }
+
+    frame = (DUMMY_QueuedFrame *) SDL_malloc(sizeof(*frame));
+    if (!frame) {
+        return SDL_OutOfMemory();
+    }
+
+    /* The application keeps drawing into the framebuffer, so take a copy */
+    frame->surface = SDL_ConvertSurface(surface, surface->format, SDL_POOLED);
+    if (!frame->surface) {
+        SDL_free(frame);
+        return -1;
+    }
+    frame->format = format;
+    SDL_strlcpy(frame->file, file, sizeof(frame->file));
+    frame->next = NULL;
+
+    SDL_LockMutex(save_queue.lock);
+    while (save_queue.count >= DUMMY_MAX_QUEUED_FRAMES) {
+        SDL_CondWait(save_queue.cond, save_queue.lock);
+    }
+    if (save_queue.tail) {
+        save_queue.tail->next = frame;
+    } else {
+        save_queue.head = frame;
+    }
+    save_queue.tail = frame;
+    ++save_queue.count;
+    SDL_CondBroadcast(save_queue.cond);
+    SDL_UnlockMutex(save_queue.lock);
+
+    return 0;
+}
+
+static void
+DUMMY_LogStats(SDL_Window * window, const DUMMY_Framebuffer *fb)
+{
+    const double ms = 1000.0 / (double) SDL_GetPerformanceFrequency();
+    double rate = 0.0;
+
+    if (fb->num_updates == 0) {
+        return;
+    }
+    if (fb->num_updates > 1 && fb->last_update > fb->first_update) {
+        rate = (fb->num_updates - 1) * 1000.0 /
+               ((fb->last_update - fb->first_update) * ms);
+    }
+    SDL_Log("Window %d: %u updates, %.3f ms average (min %.3f, max %.3f), %.1f updates/s",
+            SDL_GetWindowID(window), fb->num_updates,
+            (fb->total_time * ms) / fb->num_updates,
+            fb->min_time * ms, fb->max_time * ms, rate);
+}
 
 int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format, void ** pixels, int *pitch)
 {
+    DUMMY_Framebuffer *fb;
     SDL_Surface *surface;
     const Uint32 surface_format = SDL_PIXELFORMAT_RGB888;
     int w, h;
@@ -37,19 +229,28 @@ int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * forma
     Uint32 Rmask, Gmask, Bmask, Amask;
 
     /* Free the old framebuffer surface */
-    surface = (SDL_Surface *) SDL_GetWindowData(window, DUMMY_SURFACE);
-    SDL_FreeSurface(surface);
+    fb = (DUMMY_Framebuffer *) SDL_GetWindowData(window, DUMMY_FRAMEBUFFER);
+    if (!fb) {
+        fb = (DUMMY_Framebuffer *) SDL_calloc(1, sizeof(*fb));
+        if (!fb) {
+            return SDL_OutOfMemory();
+        }
+        SDL_SetWindowData(window, DUMMY_FRAMEBUFFER, fb);
+    }
+    SDL_FreeSurface(fb->surface);
+    fb->surface = NULL;
 
     /* Create a new one */
     SDL_PixelFormatEnumToMasks(surface_format, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
     SDL_GetWindowSize(window, &w, &h);
-    surface = SDL_CreateRGBSurface(0, w, h, bpp, Rmask, Gmask, Bmask, Amask);
+    surface = SDL_CreateRGBSurface(SDL_SIMD_ALIGNED, w, h, bpp, Rmask, Gmask, Bmask, Amask);
     if (!surface) {
         return -1;
     }
 
-    /* Save the info and return! */
-    SDL_SetWindowData(window, DUMMY_SURFACE, surface);
+    /* Save the info and return!  The window surface draws straight into
+       these pixels, nothing is copied unless frames are being saved. */
+    fb->surface = surface;
     *format = surface_format;
     *pixels = surface->pixels;
     *pitch = surface->pitch;
@@ -58,30 +259,92 @@ int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * forma
 
 int SDL_DUMMY_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects, int numrects)
 {
-    static int frame_number;
-    SDL_Surface *surface;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    DUMMY_SaveFormat save_format;
+    DUMMY_Framebuffer *fb;
+    Uint64 elapsed;
 
-    surface = (SDL_Surface *) SDL_GetWindowData(window, DUMMY_SURFACE);
-    if (!surface) {
+    fb = (DUMMY_Framebuffer *) SDL_GetWindowData(window, DUMMY_FRAMEBUFFER);
+    if (!fb || !fb->surface) {
         return SDL_SetError("Couldn't find dummy surface for window");
     }
 
     /* Send the data to the display */
-    if (SDL_getenv("SDL_VIDEO_DUMMY_SAVE_FRAMES")) {
+    save_format = DUMMY_GetSaveFormat();
+    if (save_format != DUMMY_SAVE_NONE) {
+        const char *hint = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_SAVE_THREAD);
         char file[128];
-        SDL_snprintf(file, sizeof(file), "SDL_window%d-%8.8d.bmp",
-                     SDL_GetWindowID(window), ++frame_number);
-        SDL_SaveBMP(surface, file);
+
+        if (save_format == DUMMY_SAVE_RAW) {
+            SDL_snprintf(file, sizeof(file), "SDL_window%d-%dx%d-%8.8d.raw",
+                         SDL_GetWindowID(window), fb->surface->w, fb->surface->h,
+                         ++fb->frame_number);
+        } else {
+            SDL_snprintf(file, sizeof(file), "SDL_window%d-%8.8d.bmp",
+                         SDL_GetWindowID(window), ++fb->frame_number);
+        }
+
+        if (hint && *hint == '1') {
+            if (DUMMY_QueueFrame(fb->surface, save_format, file) < 0) {
+                return -1;
+            }
+        } else {
+            DUMMY_SaveFrame(fb->surface, save_format, file);
+        }
+    }
+
+    fb->last_update = SDL_GetPerformanceCounter();
+    elapsed = fb->last_update - start;
+    if (fb->num_updates == 0) {
+        fb->first_update = start;
+        fb->min_time = elapsed;
+    }
+    ++fb->num_updates;
+    fb->total_time += elapsed;
+    if (elapsed < fb->min_time) {
+        fb->min_time = elapsed;
+    }
+    if (elapsed > fb->max_time) {
+        fb->max_time = elapsed;
     }
     return 0;
 }
 
 void SDL_DUMMY_DestroyWindowFramebuffer(_THIS, SDL_Window * window)
 {
-    SDL_Surface *surface;
+    DUMMY_Framebuffer *fb;
+    const char *hint;
 
-    surface = (SDL_Surface *) SDL_SetWindowData(window, DUMMY_SURFACE, NULL);
-    SDL_FreeSurface(surface);
+    fb = (DUMMY_Framebuffer *) SDL_SetWindowData(window, DUMMY_FRAMEBUFFER, NULL);
+    if (!fb) {
+        return;
+    }
+
+    hint = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_STATS);
+    if (hint && *hint == '1') {
+        DUMMY_LogStats(window, fb);
+    }
+    SDL_FreeSurface(fb->surface);
+    SDL_free(fb);
+}
+
+void SDL_DUMMY_QuitFramebuffer(_THIS)
+{
+    /* Let the save thread finish writing everything that was queued */
+    if (save_queue.thread) {
+        SDL_LockMutex(save_queue.lock);
+        save_queue.quit = SDL_TRUE;
+        SDL_CondBroadcast(save_queue.cond);
+        SDL_UnlockMutex(save_queue.lock);
+        SDL_WaitThread(save_queue.thread, NULL);
+    }
+    if (save_queue.cond) {
+        SDL_DestroyCond(save_queue.cond);
+    }
+    if (save_queue.lock) {
+        SDL_DestroyMutex(save_queue.lock);
+    }
+    SDL_zero(save_queue);
 }
 
 #endif /* SDL_VIDEO_DRIVER_DUMMY */
@@ -39,6 +39,7 @@
 
 #include "SDL_video.h"
 #include "SDL_mouse.h"
+#include "SDL_hints.h"
 #include "../SDL_sysvideo.h"
 #include "../SDL_pixels_c.h"
 #include "../../events/SDL_events_c.h"
@@ -105,23 +106,75 @@ VideoBootStrap DUMMY_bootstrap = {
 };
 
 
+/* Parse one "WxH[@Hz]" entry of SDL_HINT_VIDEO_DUMMY_DISPLAY_MODES */
+static SDL_bool
+DUMMY_ParseDisplayMode(const char **spec, SDL_DisplayMode * mode)
+{
+    const char *text = *spec;
+    char *end;
+
+    SDL_zerop(mode);
+    mode->format = SDL_PIXELFORMAT_RGB888;
+
+    mode->w = (int) SDL_strtol(text, &end, 10);
+    if (end == text || (*end != 'x' && *end != 'X')) {
+        return SDL_FALSE;
+    }
+    text = end + 1;
+    mode->h = (int) SDL_strtol(text, &end, 10);
+    if (end == text) {
+        return SDL_FALSE;
+    }
+    if (*end == '@') {
+        text = end + 1;
+        mode->refresh_rate = (int) SDL_strtol(text, &end, 10);
+        if (end == text) {
+            return SDL_FALSE;
+        }
+    }
+    if (mode->w <= 0 || mode->h <= 0 || mode->refresh_rate < 0) {
+        return SDL_FALSE;
+    }
+    if (*end == ',') {
+        ++end;
+    } else if (*end != '\0') {
+        return SDL_FALSE;
+    }
+
+    *spec = end;
+    return SDL_TRUE;
+}
+
 int
 DUMMY_VideoInit(_THIS)
 {
+    const char *modes = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_DISPLAY_MODES);
+    const char *spec = modes;
     SDL_DisplayMode mode;
 
-    /* Use a fake 32-bpp desktop mode */
-    mode.format = SDL_PIXELFORMAT_RGB888;
-    mode.w = 1024;
-    mode.h = 768;
-    mode.refresh_rate = 0;
-    mode.driverdata = NULL;
+    /* The first configured mode is the desktop mode */
+    if (!modes || !DUMMY_ParseDisplayMode(&spec, &mode)) {
+        /* Use a fake 32-bpp desktop mode */
+        mode.format = SDL_PIXELFORMAT_RGB888;
+        mode.w = 1024;
+        mode.h = 768;
+        mode.refresh_rate = 0;
+        mode.driverdata = NULL;
+        modes = NULL;
+    }
     if (SDL_AddBasicVideoDisplay(&mode) < 0) {
         return -1;
     }
 
-    SDL_zero(mode);
-    SDL_AddDisplayMode(&_this->displays[0], &mode);
+    if (modes) {
+        spec = modes;
+        while (*spec && DUMMY_ParseDisplayMode(&spec, &mode)) {
+            SDL_AddDisplayMode(&_this->displays[0], &mode);
+        }
+    } else {
+        SDL_zero(mode);
+        SDL_AddDisplayMode(&_this->displays[0], &mode);
+    }
 
     /* We're done! */
     return 0;
@@ -136,6 +189,7 @@ DUMMY_SetDisplayMode(_THIS, SDL_VideoDisplay * display, SDL_DisplayMode * mode)
 void
 DUMMY_VideoQuit(_THIS)
 {
+    SDL_DUMMY_QuitFramebuffer(_this);
 }
 
 #endif /* SDL_VIDEO_DRIVER_DUMMY */
@@ -41,5 +41,17 @@ void RPI_PumpEvents(_THIS)
     
 }
 
+#ifdef SDL_INPUT_LINUXEV
+int RPI_WaitEventTimeout(_THIS, int timeout)
+{
+    return SDL_EVDEV_Wait(timeout);
+}
+
+void RPI_SendWakeupEvent(_THIS)
+{
+    SDL_EVDEV_Wakeup();
+}
+#endif
+
 #endif /* SDL_VIDEO_DRIVER_RPI */
 
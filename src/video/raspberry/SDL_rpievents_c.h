@@ -25,6 +25,8 @@
 #include "SDL_rpivideo.h"
 
 void RPI_PumpEvents(_THIS);
+int RPI_WaitEventTimeout(_THIS, int timeout);
+void RPI_SendWakeupEvent(_THIS);
 void RPI_EventInit(_THIS);
 void RPI_EventQuit(_THIS);
 
@@ -125,6 +125,10 @@ RPI_Create()
     device->GL_DeleteContext = RPI_GLES_DeleteContext;
 
     device->PumpEvents = RPI_PumpEvents;
+#ifdef SDL_INPUT_LINUXEV
+    device->WaitEventTimeout = RPI_WaitEventTimeout;
+    device->SendWakeupEvent = RPI_SendWakeupEvent;
+#endif
 
     return device;
 }
@@ -108,6 +108,10 @@ VIVANTE_Create()
     device->GL_DeleteContext = VIVANTE_GLES_DeleteContext;
 
     device->PumpEvents = VIVANTE_PumpEvents;
+#ifdef SDL_INPUT_LINUXEV
+    device->WaitEventTimeout = VIVANTE_WaitEventTimeout;
+    device->SendWakeupEvent = VIVANTE_SendWakeupEvent;
+#endif
 
     return device;
 }
@@ -394,6 +398,18 @@ void VIVANTE_PumpEvents(_THIS)
 #endif
 }
 
+#ifdef SDL_INPUT_LINUXEV
+int VIVANTE_WaitEventTimeout(_THIS, int timeout)
+{
+    return SDL_EVDEV_Wait(timeout);
+}
+
+void VIVANTE_SendWakeupEvent(_THIS)
+{
+    SDL_EVDEV_Wakeup();
+}
+#endif
+
 #endif /* SDL_VIDEO_DRIVER_VIVANTE */
 
 /* vi: set ts=4 sw=4 expandtab: */
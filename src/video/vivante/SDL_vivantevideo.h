@@ -85,6 +85,8 @@ SDL_bool VIVANTE_GetWindowWMInfo(_THIS, SDL_Window * window,
 
 /* Event functions */
 void VIVANTE_PumpEvents(_THIS);
+int VIVANTE_WaitEventTimeout(_THIS, int timeout);
+void VIVANTE_SendWakeupEvent(_THIS);
 
 #endif /* _SDL_vivantevideo_h */
 
@@ -78,6 +78,51 @@ Wayland_PumpEvents(_THIS)
         WAYLAND_wl_display_dispatch_pending(d->display);
 }
 
+int
+Wayland_WaitEventTimeout(_THIS, int timeout)
+{
+    SDL_VideoData *d = _this->driverdata;
+    struct pollfd pfd[2];
+    char buf[16];
+
+    WAYLAND_wl_display_flush(d->display);
+    if (WAYLAND_wl_display_dispatch_pending(d->display) > 0) {
+        return 1;
+    }
+
+    /* Without a pipe nothing can end the wait early, so keep it short */
+    if (d->wakeup_pipe[0] < 0 && (timeout < 0 || timeout > 10)) {
+        timeout = 10;
+    }
+
+    pfd[0].fd = WAYLAND_wl_display_get_fd(d->display);
+    pfd[0].events = POLLIN;
+    pfd[1].fd = d->wakeup_pipe[0];
+    pfd[1].events = POLLIN;
+    if (poll(pfd, 2, timeout) <= 0) {
+        return 0;
+    }
+
+    if (pfd[1].revents & POLLIN) {
+        while (read(d->wakeup_pipe[0], buf, sizeof (buf)) > 0) {
+            continue;
+        }
+    }
+    return 1;
+}
+
+void
+Wayland_SendWakeupEvent(_THIS)
+{
+    SDL_VideoData *d = _this->driverdata;
+    const char wakeup = 0;
+
+    /* The pipe doesn't block; if it's full a wakeup is pending anyway */
+    if (d->wakeup_pipe[1] < 0 || write(d->wakeup_pipe[1], &wakeup, 1) < 0) {
+        return;
+    }
+}
+
 static void
 pointer_handle_enter(void *data, struct wl_pointer *pointer,
                      uint32_t serial, struct wl_surface *surface,
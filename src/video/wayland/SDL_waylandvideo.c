@@ -36,6 +36,7 @@
 #include "SDL_waylandtouch.h"
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <xkbcommon/xkbcommon.h>
 
 #include "SDL_waylanddyn.h"
@@ -103,6 +104,8 @@ Wayland_CreateDevice(int devindex)
     device->GetWindowWMInfo = Wayland_GetWindowWMInfo;
 
     device->PumpEvents = Wayland_PumpEvents;
+    device->WaitEventTimeout = Wayland_WaitEventTimeout;
+    device->SendWakeupEvent = Wayland_SendWakeupEvent;
 
     device->GL_SwapWindow = Wayland_GLES_SwapWindow;
     device->GL_GetSwapInterval = Wayland_GLES_GetSwapInterval;
@@ -283,6 +286,17 @@ Wayland_VideoInit(_THIS)
 
     _this->driverdata = data;
 
+    /* A pipe for waking up a thread blocked waiting for events */
+    if (pipe(data->wakeup_pipe) == 0) {
+        int i;
+        for (i = 0; i < 2; ++i) {
+            fcntl(data->wakeup_pipe[i], F_SETFL, fcntl(data->wakeup_pipe[i], F_GETFL) | O_NONBLOCK);
+            fcntl(data->wakeup_pipe[i], F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        data->wakeup_pipe[0] = data->wakeup_pipe[1] = -1;
+    }
+
     data->display = WAYLAND_wl_display_connect(NULL);
     if (data->display == NULL) {
         return SDL_SetError("Failed to connect to a Wayland display");
@@ -376,6 +390,11 @@ Wayland_VideoQuit(_THIS)
         WAYLAND_wl_display_disconnect(data->display);
     }
 
+    if (data->wakeup_pipe[0] >= 0) {
+        close(data->wakeup_pipe[0]);
+        close(data->wakeup_pipe[1]);
+    }
+
     free(data);
     _this->driverdata = NULL;
 }
@@ -53,6 +53,9 @@ typedef struct {
     struct xkb_context *xkb_context;
     struct SDL_WaylandInput *input;
 
+    /* Written to by Wayland_SendWakeupEvent() to end Wayland_WaitEventTimeout() */
+    int wakeup_pipe[2];
+
 #ifdef SDL_VIDEO_DRIVER_WAYLAND_QT_TOUCH
     struct SDL_WaylandTouch *touch;
     struct qt_surface_extension *surface_extension;
@@ -26,11 +26,14 @@
 #include <sys/time.h>
 #include <signal.h>
 #include <unistd.h>
+#include <poll.h>
+#include <time.h>
 #include <limits.h> /* For INT_MAX */
 
 #include "SDL_x11video.h"
 #include "SDL_x11touch.h"
 #include "SDL_x11xinput2.h"
+#include "SDL_x11framebuffer.h"
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_mouse_c.h"
 #include "../../events/SDL_touch_c.h"
@@ -512,6 +515,31 @@ ProcessHitTest(_THIS, const SDL_WindowData *data, const XEvent *xev)
     return SDL_FALSE;
 }
 
+/* Pass along when the X server saw some input.
+
+   The X.Org server stamps events with CLOCK_MONOTONIC in milliseconds.
+   If the event's age doesn't make sense that way, the server is using some
+   other clock and the event is stamped when it's pushed instead.
+ */
+void
+X11_SetInputTimestamp(Time time)
+{
+    struct timespec now;
+    Uint32 age_ms;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) < 0) {
+        SDL_SetInputTimestampNS(0);
+        return;
+    }
+
+    age_ms = (Uint32) (now.tv_sec * 1000 + now.tv_nsec / 1000000) - (Uint32) time;
+    if (age_ms > 10000) {
+        SDL_SetInputTimestampNS(0);
+        return;
+    }
+    SDL_SetInputTimestampNS(SDL_GetInputTimestampFromAge((Uint64) age_ms * 1000000 + now.tv_nsec % 1000000));
+}
+
 static void
 X11_DispatchEvent(_THIS)
 {
@@ -527,6 +555,27 @@ X11_DispatchEvent(_THIS)
     SDL_zero(xevent);           /* valgrind fix. --ryan. */
     X11_XNextEvent(display, &xevent);
 
+    switch (xevent.type) {
+    case KeyPress:
+    case KeyRelease:
+        X11_SetInputTimestamp(xevent.xkey.time);
+        break;
+    case ButtonPress:
+    case ButtonRelease:
+        X11_SetInputTimestamp(xevent.xbutton.time);
+        break;
+    case MotionNotify:
+        X11_SetInputTimestamp(xevent.xmotion.time);
+        break;
+    case EnterNotify:
+    case LeaveNotify:
+        X11_SetInputTimestamp(xevent.xcrossing.time);
+        break;
+    default:
+        SDL_SetInputTimestampNS(0);
+        break;
+    }
+
     /* Save the original keycode for dead keys, which are filtered out by
        the XFilterEvent() call below.
     */
@@ -613,6 +662,10 @@ X11_DispatchEvent(_THIS)
         return;
     }
 
+    if (X11_HandleFramebufferEvent(data, &xevent)) {
+        return;
+    }
+
     switch (xevent.type) {
 
         /* Gaining mouse coverage? */
@@ -1349,6 +1402,7 @@ X11_PumpEvents(_THIS)
     while (X11_Pending(data->display)) {
         X11_DispatchEvent(_this);
     }
+    SDL_SetInputTimestampNS(0);
 
 #ifdef SDL_USE_IBUS
     if(SDL_GetEventState(SDL_TEXTINPUT) == SDL_ENABLE){
@@ -1360,6 +1414,77 @@ X11_PumpEvents(_THIS)
     X11_HandleFocusChanges(_this);
 }
 
+/* Shorten a wait so that it ends by 'deadline' */
+static int
+X11_LimitTimeout(int timeout, Uint32 now, Uint32 deadline)
+{
+    const int left = SDL_TICKS_PASSED(now, deadline) ? 0 : (int) (deadline - now);
+
+    return (timeout < 0) ? left : SDL_min(timeout, left);
+}
+
+int
+X11_WaitEventTimeout(_THIS, int timeout)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+    const Uint32 now = SDL_GetTicks();
+    struct pollfd pfd[2];
+    char buf[16];
+    int i;
+
+    /* Don't sleep through anything X11_PumpEvents() does on a timer */
+    if (data->last_mode_change_deadline) {
+        timeout = X11_LimitTimeout(timeout, now, data->last_mode_change_deadline);
+    }
+    if (_this->suspend_screensaver && data->screensaver_activity) {
+        timeout = X11_LimitTimeout(timeout, now, data->screensaver_activity + 30000);
+    }
+    for (i = 0; i < data->numwindows; ++i) {
+        SDL_WindowData *windowdata = data->windowlist[i];
+        if (windowdata && windowdata->pending_focus != PENDING_FOCUS_NONE) {
+            timeout = X11_LimitTimeout(timeout, now, windowdata->pending_focus_time);
+        }
+    }
+#ifdef SDL_USE_IBUS
+    /* IBus talks over D-Bus, which isn't watched here */
+    if (SDL_GetEventState(SDL_TEXTINPUT) == SDL_ENABLE) {
+        timeout = X11_LimitTimeout(timeout, now, now + 10);
+    }
+#endif
+
+    X11_XFlush(data->display);
+    if (X11_XEventsQueued(data->display, QueuedAlready)) {
+        return 1;
+    }
+
+    pfd[0].fd = ConnectionNumber(data->display);
+    pfd[0].events = POLLIN;
+    pfd[1].fd = data->wakeup_pipe[0];
+    pfd[1].events = POLLIN;
+    if (poll(pfd, 2, timeout) <= 0) {
+        return 0;
+    }
+
+    if (pfd[1].revents & POLLIN) {
+        while (read(data->wakeup_pipe[0], buf, sizeof (buf)) > 0) {
+            continue;
+        }
+    }
+    return 1;
+}
+
+void
+X11_SendWakeupEvent(_THIS)
+{
+    SDL_VideoData *data = (SDL_VideoData *) _this->driverdata;
+    const char wakeup = 0;
+
+    /* The pipe doesn't block; if it's full a wakeup is pending anyway */
+    if (write(data->wakeup_pipe[1], &wakeup, 1) < 0) {
+        return;
+    }
+}
+
 
 void
 X11_SuspendScreenSaver(_THIS)
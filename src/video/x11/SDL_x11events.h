@@ -24,7 +24,10 @@
 #define _SDL_x11events_h
 
 extern void X11_PumpEvents(_THIS);
+extern int X11_WaitEventTimeout(_THIS, int timeout);
+extern void X11_SendWakeupEvent(_THIS);
 extern void X11_SuspendScreenSaver(_THIS);
+extern void X11_SetInputTimestamp(Time time);
 
 #endif /* _SDL_x11events_h */
 
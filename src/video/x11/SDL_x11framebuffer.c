@@ -22,6 +22,7 @@
 
 #if SDL_VIDEO_DRIVER_X11
 
+#include "SDL_hints.h"
 #include "SDL_x11video.h"
 #include "SDL_x11framebuffer.h"
 
@@ -50,8 +51,153 @@ static SDL_bool have_mitshm(void)
     return SDL_FALSE;
 }
 
+static XImage *
+X11_CreateShmImage(Display *display, SDL_WindowData *data, XVisualInfo *vinfo,
+                   int w, int h, int pitch, XShmSegmentInfo *shminfo)
+{
+    XImage *ximage;
+
+    shminfo->shmid = shmget(IPC_PRIVATE, h*pitch, IPC_CREAT | 0777);
+    if ( shminfo->shmid >= 0 ) {
+        shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
+        shminfo->readOnly = False;
+        if ( shminfo->shmaddr != (char *)-1 ) {
+            shm_error = False;
+            X_handler = X11_XSetErrorHandler(shm_errhandler);
+            X11_XShmAttach(display, shminfo);
+            X11_XSync(display, True);
+            X11_XSetErrorHandler(X_handler);
+            if ( shm_error )
+                shmdt(shminfo->shmaddr);
+        } else {
+            shm_error = True;
+        }
+        shmctl(shminfo->shmid, IPC_RMID, NULL);
+    } else {
+        shm_error = True;
+    }
+    if (shm_error) {
+        return NULL;
+    }
+
+    ximage = X11_XShmCreateImage(display, data->visual,
+                     vinfo->depth, ZPixmap,
+                     shminfo->shmaddr, shminfo, w, h);
+    if (!ximage) {
+        X11_XShmDetach(display, shminfo);
+        X11_XSync(display, False);
+        shmdt(shminfo->shmaddr);
+    }
+    return ximage;
+}
+
+static Bool
+X11_IsShmCompletion(Display *display, XEvent *xevent, XPointer arg)
+{
+    SDL_WindowData *data = (SDL_WindowData *) arg;
+
+    return (xevent->type == data->shm_completion &&
+            ((XShmCompletionEvent *) xevent)->drawable == data->xwindow);
+}
+
+/* Block until the X server is done reading from a shared memory image */
+static void
+X11_WaitShmBuffer(Display *display, SDL_WindowData *data, int buffer)
+{
+    XEvent xevent;
+
+    while (data->shm_buffers[buffer].pending > 0) {
+        X11_XIfEvent(display, &xevent, X11_IsShmCompletion, (XPointer) data);
+        X11_HandleFramebufferEvent(data, &xevent);
+    }
+}
+
+static void
+X11_DestroyShmBuffers(Display *display, SDL_WindowData *data)
+{
+    int i;
+
+    for (i = 0; i < data->num_shm_buffers; ++i) {
+        X11_WaitShmBuffer(display, data, i);
+        XDestroyImage(data->shm_buffers[i].ximage);
+        X11_XShmDetach(display, &data->shm_buffers[i].shminfo);
+    }
+    X11_XSync(display, False);
+    for (i = 0; i < data->num_shm_buffers; ++i) {
+        shmdt(data->shm_buffers[i].shminfo.shmaddr);
+        data->shm_buffers[i].ximage = NULL;
+    }
+    data->num_shm_buffers = 0;
+
+    SDL_free(data->fb_pixels);
+    data->fb_pixels = NULL;
+}
+
+/* The application draws into a private buffer and every update is copied
+   into whichever shared memory image the X server has finished with, so
+   presenting never has to wait for a round trip to the server. */
+static SDL_bool
+X11_CreateShmBuffers(Display *display, SDL_WindowData *data, XVisualInfo *vinfo,
+                     int w, int h, int pitch, int num_buffers)
+{
+    int i;
+
+    if (num_buffers > X11_MAX_SHM_BUFFERS) {
+        num_buffers = X11_MAX_SHM_BUFFERS;
+    }
+
+    data->fb_pixels = SDL_malloc(h*pitch);
+    if (!data->fb_pixels) {
+        return SDL_FALSE;
+    }
+
+    data->shm_completion = X11_XShmGetEventBase(display) + ShmCompletion;
+    for (i = 0; i < num_buffers; ++i) {
+        data->shm_buffers[i].ximage = X11_CreateShmImage(display, data, vinfo,
+                                          w, h, pitch, &data->shm_buffers[i].shminfo);
+        if (!data->shm_buffers[i].ximage) {
+            break;
+        }
+        data->shm_buffers[i].pending = 0;
+    }
+    data->num_shm_buffers = i;
+    data->shm_buffer = 0;
+
+    if (data->num_shm_buffers < 2) {
+        X11_DestroyShmBuffers(display, data);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
 #endif /* !NO_SHARED_MEMORY */
 
+/* Clip an update rectangle to the window, returns SDL_FALSE if it's empty */
+static SDL_bool
+X11_ClipUpdateRect(SDL_Window * window, const SDL_Rect * rect,
+                   int *x, int *y, int *w, int *h)
+{
+    *x = rect->x;
+    *y = rect->y;
+    *w = rect->w;
+    *h = rect->h;
+
+    if (*x < 0) {
+        *w += *x;
+        *x = 0;
+    }
+    if (*y < 0) {
+        *h += *y;
+        *y = 0;
+    }
+    if (*x + *w > window->w)
+        *w = window->w - *x;
+    if (*y + *h > window->h)
+        *h = window->h - *y;
+
+    return (*w > 0 && *h > 0);
+}
+
 int
 X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
                             void ** pixels, int *pitch)
@@ -87,42 +233,23 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
     /* Create the actual image */
 #ifndef NO_SHARED_MEMORY
     if (have_mitshm()) {
-        XShmSegmentInfo *shminfo = &data->shminfo;
-
-        shminfo->shmid = shmget(IPC_PRIVATE, window->h*(*pitch), IPC_CREAT | 0777);
-        if ( shminfo->shmid >= 0 ) {
-            shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
-            shminfo->readOnly = False;
-            if ( shminfo->shmaddr != (char *)-1 ) {
-                shm_error = False;
-                X_handler = X11_XSetErrorHandler(shm_errhandler);
-                X11_XShmAttach(display, shminfo);
-                X11_XSync(display, True);
-                X11_XSetErrorHandler(X_handler);
-                if ( shm_error )
-                    shmdt(shminfo->shmaddr);
-            } else {
-                shm_error = True;
-            }
-            shmctl(shminfo->shmid, IPC_RMID, NULL);
-        } else {
-            shm_error = True;
+        const char *hint = SDL_GetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS);
+
+        if (hint && SDL_atoi(hint) > 1 &&
+            X11_CreateShmBuffers(display, data, &vinfo, window->w, window->h,
+                                 *pitch, SDL_atoi(hint))) {
+            *pixels = data->fb_pixels;
+            return 0;
         }
-        if (!shm_error) {
-            data->ximage = X11_XShmCreateImage(display, data->visual,
-                             vinfo.depth, ZPixmap,
-                             shminfo->shmaddr, shminfo,
-                             window->w, window->h);
-            if (!data->ximage) {
-                X11_XShmDetach(display, shminfo);
-                X11_XSync(display, False);
-                shmdt(shminfo->shmaddr);
-            } else {
-                /* Done! */
-                data->use_mitshm = SDL_TRUE;
-                *pixels = shminfo->shmaddr;
-                return 0;
-            }
+
+        data->ximage = X11_CreateShmImage(display, data, &vinfo,
+                                          window->w, window->h, *pitch,
+                                          &data->shminfo);
+        if (data->ximage) {
+            /* Done! */
+            data->use_mitshm = SDL_TRUE;
+            *pixels = data->shminfo.shmaddr;
+            return 0;
         }
     }
 #endif /* not NO_SHARED_MEMORY */
@@ -151,31 +278,46 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
     int i;
     int x, y, w ,h;
 #ifndef NO_SHARED_MEMORY
-    if (data->use_mitshm) {
-        for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
+    if (data->num_shm_buffers > 0) {
+        const int buffer = data->shm_buffer;
+        XImage *ximage = data->shm_buffers[buffer].ximage;
+        const int pitch = ximage->bytes_per_line;
+        const int bpp = ximage->bits_per_pixel / 8;
+        const Uint8 *src;
+        Uint8 *dst;
+        int row;
+
+        data->shm_buffer = (buffer + 1) % data->num_shm_buffers;
+        X11_WaitShmBuffer(display, data, buffer);
 
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
+        for (i = 0; i < numrects; ++i) {
+            if (!X11_ClipUpdateRect(window, &rects[i], &x, &y, &w, &h)) {
                 continue;
             }
-            if (x < 0)
-            {
-                x += w;
-                w += rects[i].x;
+
+            src = (const Uint8 *) data->fb_pixels + y * pitch + x * bpp;
+            dst = (Uint8 *) ximage->data + y * pitch + x * bpp;
+            for (row = 0; row < h; ++row) {
+                SDL_memcpy(dst, src, w * bpp);
+                src += pitch;
+                dst += pitch;
             }
-            if (y < 0)
-            {
-                y += h;
-                h += rects[i].y;
+
+            X11_XShmPutImage(display, data->xwindow, data->gc, ximage,
+                x, y, x, y, w, h, True);
+            ++data->shm_buffers[buffer].pending;
+        }
+
+        /* The ShmCompletion events tell us when the image is free again */
+        X11_XFlush(display);
+        return 0;
+    }
+
+    if (data->use_mitshm) {
+        for (i = 0; i < numrects; ++i) {
+            if (!X11_ClipUpdateRect(window, &rects[i], &x, &y, &w, &h)) {
+                continue;
             }
-            if (x + w > window->w)
-                w = window->w - x;
-            if (y + h > window->h)
-                h = window->h - y;
 
             X11_XShmPutImage(display, data->xwindow, data->gc, data->ximage,
                 x, y, x, y, w, h, False);
@@ -185,29 +327,9 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
 #endif /* !NO_SHARED_MEMORY */
     {
         for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
-
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
+            if (!X11_ClipUpdateRect(window, &rects[i], &x, &y, &w, &h)) {
                 continue;
             }
-            if (x < 0)
-            {
-                x += w;
-                w += rects[i].x;
-            }
-            if (y < 0)
-            {
-                y += h;
-                h += rects[i].y;
-            }
-            if (x + w > window->w)
-                w = window->w - x;
-            if (y + h > window->h)
-                h = window->h - y;
 
             X11_XPutImage(display, data->xwindow, data->gc, data->ximage,
                 x, y, x, y, w, h);
@@ -232,6 +354,12 @@ X11_DestroyWindowFramebuffer(_THIS, SDL_Window * window)
 
     display = data->videodata->display;
 
+#ifndef NO_SHARED_MEMORY
+    if (data->num_shm_buffers > 0) {
+        X11_DestroyShmBuffers(display, data);
+    }
+#endif /* !NO_SHARED_MEMORY */
+
     if (data->ximage) {
         XDestroyImage(data->ximage);
 
@@ -252,6 +380,28 @@ X11_DestroyWindowFramebuffer(_THIS, SDL_Window * window)
     }
 }
 
+SDL_bool
+X11_HandleFramebufferEvent(SDL_WindowData * data, const XEvent * xevent)
+{
+#ifndef NO_SHARED_MEMORY
+    if (data->num_shm_buffers > 0 && xevent->type == data->shm_completion) {
+        const XShmCompletionEvent *completion = (const XShmCompletionEvent *) xevent;
+        int i;
+
+        for (i = 0; i < data->num_shm_buffers; ++i) {
+            if (data->shm_buffers[i].shminfo.shmseg == completion->shmseg) {
+                if (data->shm_buffers[i].pending > 0) {
+                    --data->shm_buffers[i].pending;
+                }
+                break;
+            }
+        }
+        return SDL_TRUE;
+    }
+#endif /* !NO_SHARED_MEMORY */
+    return SDL_FALSE;
+}
+
 #endif /* SDL_VIDEO_DRIVER_X11 */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -27,5 +27,7 @@ extern int X11_CreateWindowFramebuffer(_THIS, SDL_Window * window,
 extern int X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window,
                                        const SDL_Rect * rects, int numrects);
 extern void X11_DestroyWindowFramebuffer(_THIS, SDL_Window * window);
+extern SDL_bool X11_HandleFramebufferEvent(SDL_WindowData * data,
+                                           const XEvent * xevent);
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -23,6 +23,7 @@
 #if SDL_VIDEO_DRIVER_X11
 
 #include <unistd.h> /* For getpid() and readlink() */
+#include <fcntl.h>
 
 #include "SDL_video.h"
 #include "SDL_mouse.h"
@@ -109,6 +110,10 @@ X11_DeleteDevice(SDL_VideoDevice * device)
     if (data->display) {
         X11_XCloseDisplay(data->display);
     }
+    if (data->wakeup_pipe[0] >= 0) {
+        close(data->wakeup_pipe[0]);
+        close(data->wakeup_pipe[1]);
+    }
     SDL_free(data->windowlist);
     SDL_free(device->driverdata);
     SDL_free(device);
@@ -207,6 +212,17 @@ X11_CreateDevice(int devindex)
     X11_XSynchronize(data->display, True);
 #endif
 
+    /* A pipe for waking up a thread blocked waiting for events */
+    if (pipe(data->wakeup_pipe) == 0) {
+        int i;
+        for (i = 0; i < 2; ++i) {
+            fcntl(data->wakeup_pipe[i], F_SETFL, fcntl(data->wakeup_pipe[i], F_GETFL) | O_NONBLOCK);
+            fcntl(data->wakeup_pipe[i], F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        data->wakeup_pipe[0] = data->wakeup_pipe[1] = -1;
+    }
+
     /* Hook up an X11 error handler to recover the desktop resolution. */
     safety_net_triggered = SDL_FALSE;
     orig_x11_errhandler = X11_XSetErrorHandler(X11_SafetyNetErrHandler);
@@ -220,6 +236,10 @@ X11_CreateDevice(int devindex)
     device->SetDisplayMode = X11_SetDisplayMode;
     device->SuspendScreenSaver = X11_SuspendScreenSaver;
     device->PumpEvents = X11_PumpEvents;
+    if (data->wakeup_pipe[0] >= 0) {
+        device->WaitEventTimeout = X11_WaitEventTimeout;
+        device->SendWakeupEvent = X11_SendWakeupEvent;
+    }
 
     device->CreateWindow = X11_CreateWindow;
     device->CreateWindowFrom = X11_CreateWindowFrom;
@@ -117,6 +117,9 @@ typedef struct SDL_VideoData
     SDL_bool selection_waiting;
 
     Uint32 last_mode_change_deadline;
+
+    /* Written to by X11_SendWakeupEvent() to end X11_WaitEventTimeout() */
+    int wakeup_pipe[2];
 } SDL_VideoData;
 
 extern SDL_bool X11_UseDirectColorVisuals(void);
@@ -29,6 +29,9 @@
 */
 #define PENDING_FOCUS_TIME   200
 
+/* The most MIT-SHM images a window framebuffer can cycle through */
+#define X11_MAX_SHM_BUFFERS  3
+
 #if SDL_VIDEO_OPENGL_EGL   
 #include <EGL/egl.h>
 #endif
@@ -51,6 +54,18 @@ typedef struct
     /* MIT shared memory extension information */
     SDL_bool use_mitshm;
     XShmSegmentInfo shminfo;
+
+    /* Asynchronous multi-buffered MIT-SHM framebuffer, the application draws
+       into fb_pixels and updates are copied into a buffer that's not in use */
+    int num_shm_buffers;
+    int shm_buffer;
+    int shm_completion;
+    struct {
+        XShmSegmentInfo shminfo;
+        XImage *ximage;
+        int pending;
+    } shm_buffers[X11_MAX_SHM_BUFFERS];
+    void *fb_pixels;
 #endif
     XImage *ximage;
     GC gc;
@@ -151,6 +151,7 @@ X11_HandleXinput2Event(SDL_VideoData *videodata,XGenericEventCookie *cookie)
                 return 0;  /* duplicate event, drop it. */
             }
 
+            X11_SetInputTimestamp(rawev->time);
             SDL_SendMouseMotion(mouse->focus,mouse->mouseID,1,(int)relative_coords[0],(int)relative_coords[1]);
             prev_rel_coords[0] = relative_coords[0];
             prev_rel_coords[1] = relative_coords[1];
@@ -161,6 +162,7 @@ X11_HandleXinput2Event(SDL_VideoData *videodata,XGenericEventCookie *cookie)
 #if SDL_VIDEO_DRIVER_X11_XINPUT2_SUPPORTS_MULTITOUCH
         case XI_TouchBegin: {
             const XIDeviceEvent *xev = (const XIDeviceEvent *) cookie->data;
+            X11_SetInputTimestamp(xev->time);
             SDL_SendTouch(xev->sourceid,xev->detail,
                       SDL_TRUE, xev->event_x, xev->event_y, 1.0);
             return 1;
@@ -168,6 +170,7 @@ X11_HandleXinput2Event(SDL_VideoData *videodata,XGenericEventCookie *cookie)
             break;
         case XI_TouchEnd: {
             const XIDeviceEvent *xev = (const XIDeviceEvent *) cookie->data;
+            X11_SetInputTimestamp(xev->time);
             SDL_SendTouch(xev->sourceid,xev->detail,
                       SDL_FALSE, xev->event_x, xev->event_y, 1.0);
             return 1;
@@ -175,6 +178,7 @@ X11_HandleXinput2Event(SDL_VideoData *videodata,XGenericEventCookie *cookie)
             break;
         case XI_TouchUpdate: {
             const XIDeviceEvent *xev = (const XIDeviceEvent *) cookie->data;
+            X11_SetInputTimestamp(xev->time);
             SDL_SendTouchMotion(xev->sourceid,xev->detail,
                                 xev->event_x, xev->event_y, 1.0);
             return 1;
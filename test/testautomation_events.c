@@ -39,6 +39,70 @@ int _events_sampleNullEventFilter(void *userdata, SDL_Event *event)
    return 0;
 }
 
+/* Number of events seen by the typed watcher, and the type of the last one */
+int _typedWatcherCalls = 0;
+Uint32 _typedWatcherLastType = 0;
+
+/* Event watcher that counts the events it is called with */
+int _events_typedEventWatcher(void *userdata, SDL_Event *event)
+{
+   _typedWatcherCalls++;
+   _typedWatcherLastType = event->type;
+   return 0;
+}
+
+/* Producer threads and events each for the multi-threaded push test */
+#define EVENTS_STRESS_THREADS   4
+#define EVENTS_STRESS_EVENTS    50000
+
+/* Set when the producer threads can start pushing */
+static volatile int _stressGo = 0;
+
+/* Producer thread that pushes a numbered sequence of user events */
+int _events_stressProducer(void *data)
+{
+   SDL_Event event;
+   int i = 0;
+
+   while (!_stressGo) {
+      SDL_Delay(0);
+   }
+   while (i < EVENTS_STRESS_EVENTS) {
+      SDL_zero(event);
+      event.type = SDL_USEREVENT + (i & 1);
+      event.user.code = i;
+      event.user.data1 = data;
+      if (SDL_PushEvent(&event) == 1) {
+         i++;
+      } else {
+         /* The queue is full, let the consumer catch up */
+         SDL_Delay(0);
+      }
+   }
+   return 0;
+}
+
+/* Rounds of the wakeup test, and the most their average latency may be */
+#define EVENTS_WAKE_ROUNDS      10
+#define EVENTS_WAKE_MAX_NS      3000000
+
+/* When the waker thread pushed its event */
+static volatile Uint64 _wakePushedNS = 0;
+
+/* Thread that pushes a user event once the main thread is waiting */
+int _events_wakeProducer(void *data)
+{
+   SDL_Event event;
+
+   SDL_Delay(20);
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   event.user.data1 = data;
+   _wakePushedNS = SDL_GetTicksNS();
+   SDL_PushEvent(&event);
+   return 0;
+}
+
 /**
  * @brief Test pumping and peeking events.
  *
@@ -174,6 +238,650 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Adds and deletes an event watch function for a list of event types
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_AddEventWatchTypes
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_DelEventWatch
+ */
+int
+events_addDelEventWatchTypes(void *arg)
+{
+   const Uint32 types[] = { SDL_MOUSEMOTION };
+   SDL_Event event;
+   int result;
+
+   _typedWatcherCalls = 0;
+   _typedWatcherLastType = 0;
+
+   /* Add watch */
+   result = SDL_AddEventWatchTypes(_events_typedEventWatcher, NULL, types, SDL_arraysize(types));
+   SDLTest_AssertPass("Call to SDL_AddEventWatchTypes()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_AddEventWatchTypes, expected: 0, got: %i", result);
+
+   /* Push an event that is not watched */
+   SDL_zero(event);
+   event.type = SDL_KEYDOWN;
+   event.key.keysym.scancode = SDL_SCANCODE_A;
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_KEYDOWN)");
+   SDLTest_AssertCheck(_typedWatcherCalls == 0, "Check that event watcher was NOT called, got: %i calls", _typedWatcherCalls);
+
+   /* Push an event that is watched */
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.xrel = 1;
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_MOUSEMOTION)");
+   SDLTest_AssertCheck(_typedWatcherCalls == 1, "Check that event watcher was called once, got: %i calls", _typedWatcherCalls);
+   SDLTest_AssertCheck(_typedWatcherLastType == SDL_MOUSEMOTION, "Check event type, expected: %i, got: %i", SDL_MOUSEMOTION, _typedWatcherLastType);
+
+   /* Push an event whose type only matches in the low 16 bits */
+   event.type = SDL_MOUSEMOTION | 0x10000;
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_MOUSEMOTION | 0x10000)");
+   SDLTest_AssertCheck(_typedWatcherCalls == 1, "Check that event watcher was NOT called, got: %i calls", _typedWatcherCalls);
+   event.type = SDL_MOUSEMOTION;
+
+   /* Types past SDL_LASTEVENT can't be watched */
+   result = SDL_AddEventWatchTypes(_events_typedEventWatcher, &_userdataValue, &event.type, 1);
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_AddEventWatchTypes, expected: 0, got: %i", result);
+   SDL_DelEventWatch(_events_typedEventWatcher, &_userdataValue);
+   event.type = SDL_LASTEVENT + 1;
+   result = SDL_AddEventWatchTypes(_events_typedEventWatcher, &_userdataValue, &event.type, 1);
+   SDLTest_AssertPass("Call to SDL_AddEventWatchTypes(SDL_LASTEVENT + 1)");
+   SDLTest_AssertCheck(result == -1, "Check result from SDL_AddEventWatchTypes, expected: -1, got: %i", result);
+   event.type = SDL_MOUSEMOTION;
+
+   /* Delete watch */
+   SDL_DelEventWatch(_events_typedEventWatcher, NULL);
+   SDLTest_AssertPass("Call to SDL_DelEventWatch()");
+
+   /* Push the watched event again */
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_MOUSEMOTION)");
+   SDLTest_AssertCheck(_typedWatcherCalls == 1, "Check that event watcher was NOT called again, got: %i calls", _typedWatcherCalls);
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, 0xFFFFFFFF);
+   SDLTest_AssertPass("Call to SDL_FlushEvents()");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks the nanosecond timestamps of pushed input events
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetTicksNS
+ */
+int
+events_pushStampsInputEvents(void *arg)
+{
+   SDL_Event event;
+   Uint64 before, middle, after;
+   Uint64 first, second;
+   int result;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Push two input events, a little apart */
+   SDL_zero(event);
+   event.type = SDL_KEYDOWN;
+   event.key.keysym.scancode = SDL_SCANCODE_A;
+   before = SDL_GetTicksNS();
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_KEYDOWN)");
+   SDL_Delay(10);
+   middle = SDL_GetTicksNS();
+   event.type = SDL_KEYUP;
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_KEYUP)");
+   after = SDL_GetTicksNS();
+
+   /* Check the timestamps they were given */
+   result = SDL_PollEvent(&event);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_KEYDOWN, "Check that the SDL_KEYDOWN event was polled");
+   first = event.key.timestamp_ns;
+   result = SDL_PollEvent(&event);
+   SDLTest_AssertCheck(result == 1 && event.type == SDL_KEYUP, "Check that the SDL_KEYUP event was polled");
+   second = event.key.timestamp_ns;
+
+   SDLTest_AssertCheck(first >= before && first <= middle,
+      "Check first timestamp, expected: %"SDL_PRIu64"..%"SDL_PRIu64", got: %"SDL_PRIu64, before, middle, first);
+   SDLTest_AssertCheck(second >= middle && second <= after,
+      "Check second timestamp, expected: %"SDL_PRIu64"..%"SDL_PRIu64", got: %"SDL_PRIu64, middle, after, second);
+   SDLTest_AssertCheck(second > first, "Check that the timestamps increase");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Pushes events from several threads at once while polling them
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PollEvent
+ */
+int
+events_pushFromMultipleThreads(void *arg)
+{
+   SDL_Thread *threads[EVENTS_STRESS_THREADS];
+   int next[EVENTS_STRESS_THREADS];
+   const int total = EVENTS_STRESS_THREADS * EVENTS_STRESS_EVENTS;
+   int received = 0, outOfOrder = 0, badThread = 0;
+   SDL_Event event;
+   int i, t;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   _stressGo = 0;
+   for (i = 0; i < EVENTS_STRESS_THREADS; i++) {
+      next[i] = 0;
+      threads[i] = SDL_CreateThread(_events_stressProducer, "EventsStressProducer", (void *)(uintptr_t)i);
+      SDLTest_AssertCheck(threads[i] != NULL, "Check that producer thread %d was created", i);
+      if (threads[i] == NULL) {
+         _stressGo = 1;
+         while (--i >= 0) {
+            SDL_WaitThread(threads[i], NULL);
+         }
+         return TEST_ABORTED;
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_CreateThread() %d times", EVENTS_STRESS_THREADS);
+
+   /* Each producer's events must come out in the order it pushed them */
+   _stressGo = 1;
+   while (received < total) {
+      if (SDL_WaitEventTimeout(&event, 5000) != 1) {
+         break;
+      }
+      if (event.type != SDL_USEREVENT && event.type != SDL_USEREVENT + 1) {
+         continue;
+      }
+      t = (int)(uintptr_t)event.user.data1;
+      if (t < 0 || t >= EVENTS_STRESS_THREADS) {
+         badThread++;
+         continue;
+      }
+      if (event.user.code != next[t] || event.type != (Uint32)(SDL_USEREVENT + (next[t] & 1))) {
+         outOfOrder++;
+      }
+      next[t] = event.user.code + 1;
+      received++;
+   }
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout() %d times", received);
+
+   for (i = 0; i < EVENTS_STRESS_THREADS; i++) {
+      SDL_WaitThread(threads[i], NULL);
+   }
+   SDLTest_AssertPass("Call to SDL_WaitThread() %d times", EVENTS_STRESS_THREADS);
+
+   SDLTest_AssertCheck(received == total, "Check number of events received, expected: %d, got: %d", total, received);
+   SDLTest_AssertCheck(outOfOrder == 0, "Check events received out of order, expected: 0, got: %d", outOfOrder);
+   SDLTest_AssertCheck(badThread == 0, "Check events from unknown threads, expected: 0, got: %d", badThread);
+   SDLTest_AssertCheck(SDL_HasEvents(SDL_USEREVENT, SDL_USEREVENT + 1) == SDL_FALSE, "Check that no user events are left");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Waits for events pushed from another thread
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_WaitEventTimeout
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ */
+int
+events_waitWakesOnPush(void *arg)
+{
+   SDL_Thread *thread;
+   SDL_Event event;
+   Uint64 start, woke, latency = 0;
+   int i, result, woken = 0;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* With nothing pushed the wait lasts until the timeout.  It's counted in
+      SDL_GetTicks() milliseconds, which can each be off by up to one. */
+   start = SDL_GetTicksNS();
+   result = SDL_WaitEventTimeout(&event, 50);
+   woke = SDL_GetTicksNS();
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout(50)");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_WaitEventTimeout, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(woke - start >= 48000000,
+      "Check time waited, expected: >= 48000000, got: %"SDL_PRIu64, woke - start);
+
+   /* An event pushed from another thread ends the wait right away */
+   for (i = 0; i < EVENTS_WAKE_ROUNDS; i++) {
+      _wakePushedNS = 0;
+      thread = SDL_CreateThread(_events_wakeProducer, "EventsWakeProducer", &_userdataValue1);
+      SDLTest_AssertCheck(thread != NULL, "Check that waker thread %d was created", i);
+      if (thread == NULL) {
+         return TEST_ABORTED;
+      }
+      do {
+         result = SDL_WaitEventTimeout(&event, 5000);
+         woke = SDL_GetTicksNS();
+      } while (result == 1 && event.type != SDL_USEREVENT);
+      SDL_WaitThread(thread, NULL);
+
+      if (result == 1 && event.user.data1 == &_userdataValue1 && _wakePushedNS != 0) {
+         latency += woke - _wakePushedNS;
+         woken++;
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_WaitEventTimeout(5000) %d times", EVENTS_WAKE_ROUNDS);
+   SDLTest_AssertCheck(woken == EVENTS_WAKE_ROUNDS, "Check number of wakeups, expected: %d, got: %d", EVENTS_WAKE_ROUNDS, woken);
+   if (woken > 0) {
+      latency /= woken;
+      SDLTest_AssertCheck(latency < EVENTS_WAKE_MAX_NS,
+         "Check average wakeup latency, expected: < %d, got: %"SDL_PRIu64, EVENTS_WAKE_MAX_NS, latency);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Merges consecutive mouse motion events when coalescing is enabled
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_COALESCE_MOUSE_MOTION
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetCoalescedEventCount
+ */
+int
+events_coalesceMouseMotion(void *arg)
+{
+   SDL_Event event, queued[3];
+   int before, after, result, i;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION, "1");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION, \"1\")");
+   before = SDL_GetCoalescedEventCount();
+
+   /* Three motions of the same mouse become one event */
+   for (i = 1; i <= 3; i++) {
+      SDL_zero(event);
+      event.type = SDL_MOUSEMOTION;
+      event.motion.windowID = 1;
+      event.motion.x = 10 * i;
+      event.motion.y = 20 * i;
+      event.motion.xrel = i;
+      event.motion.yrel = -2 * i;
+      SDL_PushEvent(&event);
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_MOUSEMOTION) 3 times");
+
+   /* Motion in another window is kept apart */
+   event.motion.windowID = 2;
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent(SDL_MOUSEMOTION) for another window");
+
+   after = SDL_GetCoalescedEventCount();
+   SDLTest_AssertCheck(after - before == 2, "Check coalesced event count increase, expected: 2, got: %d", after - before);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 1, "Check result from SDL_PeepEvents, expected: 1, got: %d", result);
+   SDLTest_AssertCheck(event.motion.windowID == 1, "Check window of merged event, expected: 1, got: %d", event.motion.windowID);
+   SDLTest_AssertCheck(event.motion.x == 30 && event.motion.y == 60,
+      "Check position of merged event, expected: 30,60, got: %d,%d", event.motion.x, event.motion.y);
+   SDLTest_AssertCheck(event.motion.xrel == 6 && event.motion.yrel == -12,
+      "Check relative motion of merged event, expected: 6,-12, got: %d,%d", event.motion.xrel, event.motion.yrel);
+
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 1 && event.motion.windowID == 2, "Check that the event for the other window was kept");
+   result = SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 0, "Check that no motion events are left, expected: 0, got: %d", result);
+
+   /* Without the hint every motion is queued */
+   SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION, "0");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION, \"0\")");
+   event.motion.windowID = 1;
+   SDL_PushEvent(&event);
+   SDL_PushEvent(&event);
+   result = SDL_PeepEvents(queued, SDL_arraysize(queued), SDL_PEEKEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 2, "Check number of queued motion events, expected: 2, got: %d", result);
+   SDLTest_AssertCheck(SDL_GetCoalescedEventCount() == after, "Check that the coalesced event count is unchanged");
+   SDL_FlushEvent(SDL_MOUSEMOTION);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Peeks and gets events of a scattered set of types
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEventTypes
+ */
+int
+events_peepEventTypes(void *arg)
+{
+   /* Queued in this order, 'code' numbers the ones matching 'types' */
+   static const Uint32 sequence[] = {
+      SDL_USEREVENT, SDL_KEYDOWN, SDL_USEREVENT + 2, SDL_MOUSEMOTION,
+      SDL_USEREVENT + 1, SDL_USEREVENT, SDL_USEREVENT + 2, SDL_KEYUP
+   };
+   const Uint32 types[] = { SDL_USEREVENT + 2, SDL_KEYDOWN, SDL_USEREVENT };
+   const int expectedMatching = 5;
+   SDL_Event event, events[8];
+   int i, code, result, outOfOrder;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOUSE_MOTION, "0");
+
+   code = 0;
+   for (i = 0; i < SDL_arraysize(sequence); i++) {
+      SDL_zero(event);
+      event.type = sequence[i];
+      if (sequence[i] == SDL_KEYDOWN || sequence[i] == SDL_USEREVENT || sequence[i] == SDL_USEREVENT + 2) {
+         event.user.code = code++;
+      } else {
+         event.user.code = -1;
+      }
+      SDL_PushEvent(&event);
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent() %d times", (int)SDL_arraysize(sequence));
+
+   /* Peeking returns the matching events in queue order and leaves them */
+   result = SDL_PeepEventTypes(events, SDL_arraysize(events), SDL_PEEKEVENT, types, SDL_arraysize(types));
+   SDLTest_AssertPass("Call to SDL_PeepEventTypes(SDL_PEEKEVENT)");
+   SDLTest_AssertCheck(result == expectedMatching, "Check result from SDL_PeepEventTypes, expected: %d, got: %d", expectedMatching, result);
+   outOfOrder = 0;
+   for (i = 0; i < result; i++) {
+      if (events[i].user.code != i) {
+         outOfOrder++;
+      }
+   }
+   SDLTest_AssertCheck(outOfOrder == 0, "Check events peeked out of order, expected: 0, got: %d", outOfOrder);
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == SDL_arraysize(sequence), "Check number of queued events, expected: %d, got: %d", (int)SDL_arraysize(sequence), result);
+
+   /* Getting removes only as many as asked for, from the front */
+   result = SDL_PeepEventTypes(events, 2, SDL_GETEVENT, types, SDL_arraysize(types));
+   SDLTest_AssertPass("Call to SDL_PeepEventTypes(SDL_GETEVENT, 2)");
+   SDLTest_AssertCheck(result == 2, "Check result from SDL_PeepEventTypes, expected: 2, got: %d", result);
+   SDLTest_AssertCheck(result == 2 && events[0].type == SDL_USEREVENT && events[0].user.code == 0 &&
+      events[1].type == SDL_KEYDOWN && events[1].user.code == 1, "Check the first two matching events were returned");
+
+   result = SDL_PeepEventTypes(events, SDL_arraysize(events), SDL_GETEVENT, types, SDL_arraysize(types));
+   SDLTest_AssertPass("Call to SDL_PeepEventTypes(SDL_GETEVENT)");
+   SDLTest_AssertCheck(result == expectedMatching - 2, "Check result from SDL_PeepEventTypes, expected: %d, got: %d", expectedMatching - 2, result);
+   outOfOrder = 0;
+   for (i = 0; i < result; i++) {
+      if (events[i].user.code != i + 2) {
+         outOfOrder++;
+      }
+   }
+   SDLTest_AssertCheck(outOfOrder == 0, "Check events got out of order, expected: 0, got: %d", outOfOrder);
+   result = SDL_PeepEventTypes(events, SDL_arraysize(events), SDL_PEEKEVENT, types, SDL_arraysize(types));
+   SDLTest_AssertCheck(result == 0, "Check that no matching events are left, expected: 0, got: %d", result);
+
+   /* The other events are still queued, in order */
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 3, "Check number of events left, expected: 3, got: %d", result);
+   SDLTest_AssertCheck(result == 3 && events[0].type == SDL_MOUSEMOTION &&
+      events[1].type == SDL_USEREVENT + 1 && events[2].type == SDL_KEYUP, "Check the events left over and their order");
+
+   /* An empty list of types is an error */
+   result = SDL_PeepEventTypes(events, SDL_arraysize(events), SDL_PEEKEVENT, types, 0);
+   SDLTest_AssertPass("Call to SDL_PeepEventTypes(numtypes=0)");
+   SDLTest_AssertCheck(result == -1, "Check result from SDL_PeepEventTypes, expected: -1, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Counts the events pushed and popped in a known sequence
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventQueueStats
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetEventTypeStats
+ */
+int
+events_queueStats(void *arg)
+{
+   SDL_EventQueueStats stats;
+   SDL_Event event, events[2];
+   Uint64 pushed, popped, filtered;
+   int i, result;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDL_ResetEventQueueStats();
+   SDLTest_AssertPass("Call to SDL_ResetEventQueueStats()");
+
+   /* Three events of one type, then two of another past a watcher.  Other
+      watchers may already be installed, so only count the ones it adds. */
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   for (i = 0; i < 3; i++) {
+      SDL_PushEvent(&event);
+   }
+   SDL_GetEventQueueStats(&stats);
+   filtered = stats.filtered;
+   SDL_AddEventWatch(_events_typedEventWatcher, NULL);
+   event.type = SDL_USEREVENT + 1;
+   for (i = 0; i < 2; i++) {
+      SDL_PushEvent(&event);
+   }
+   SDL_DelEventWatch(_events_typedEventWatcher, NULL);
+   SDLTest_AssertPass("Call to SDL_PushEvent() 5 times");
+
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertPass("Call to SDL_GetEventQueueStats()");
+   SDLTest_AssertCheck(stats.pushed == 5, "Check pushed events, expected: 5, got: %"SDL_PRIu64, stats.pushed);
+   SDLTest_AssertCheck(stats.popped == 0, "Check popped events, expected: 0, got: %"SDL_PRIu64, stats.popped);
+   SDLTest_AssertCheck(stats.filtered - filtered == 2, "Check events filtered past the watcher, expected: 2, got: %"SDL_PRIu64, stats.filtered - filtered);
+   SDLTest_AssertCheck(stats.depth == 5, "Check queue depth, expected: 5, got: %d", stats.depth);
+
+   /* Take two out and flush the rest */
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+   SDLTest_AssertCheck(result == 2, "Check result from SDL_PeepEvents, expected: 2, got: %d", result);
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.popped == 2, "Check popped events, expected: 2, got: %"SDL_PRIu64, stats.popped);
+   SDL_FlushEvents(SDL_USEREVENT, SDL_USEREVENT + 1);
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.pushed == 5, "Check pushed events, expected: 5, got: %"SDL_PRIu64, stats.pushed);
+   SDLTest_AssertCheck(stats.popped == 5, "Check popped events, expected: 5, got: %"SDL_PRIu64, stats.popped);
+   SDLTest_AssertCheck(stats.depth == 0, "Check queue depth, expected: 0, got: %d", stats.depth);
+
+   /* The same counts by type */
+   result = SDL_GetEventTypeStats(SDL_USEREVENT, &pushed, &popped);
+   SDLTest_AssertPass("Call to SDL_GetEventTypeStats(SDL_USEREVENT)");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_GetEventTypeStats, expected: 0, got: %d", result);
+   SDLTest_AssertCheck(pushed == 3 && popped == 3,
+      "Check SDL_USEREVENT counts, expected: 3/3, got: %"SDL_PRIu64"/%"SDL_PRIu64, pushed, popped);
+   SDL_GetEventTypeStats(SDL_USEREVENT + 1, &pushed, &popped);
+   SDLTest_AssertCheck(pushed == 2 && popped == 2,
+      "Check SDL_USEREVENT+1 counts, expected: 2/2, got: %"SDL_PRIu64"/%"SDL_PRIu64, pushed, popped);
+   SDL_GetEventTypeStats(SDL_KEYDOWN, &pushed, &popped);
+   SDLTest_AssertCheck(pushed == 0 && popped == 0,
+      "Check SDL_KEYDOWN counts, expected: 0/0, got: %"SDL_PRIu64"/%"SDL_PRIu64, pushed, popped);
+   result = SDL_GetEventTypeStats(SDL_LASTEVENT + 1, &pushed, &popped);
+   SDLTest_AssertCheck(result == -1, "Check result from SDL_GetEventTypeStats(SDL_LASTEVENT+1), expected: -1, got: %d", result);
+
+   /* Resetting starts the counts over */
+   SDL_ResetEventQueueStats();
+   SDL_GetEventQueueStats(&stats);
+   SDLTest_AssertCheck(stats.pushed == 0 && stats.popped == 0 && stats.filtered == 0, "Check that the counts were reset");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Checks that input snapshots follow the keyboard and mouse state
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_GetInputSnapshot
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PumpEvents
+ */
+int
+events_inputSnapshot(void *arg)
+{
+   SDL_InputSnapshot snapshot;
+   SDL_Window *window;
+   SDL_Keymod modstate;
+   const Uint8 *keystate;
+   Uint32 sequence, result;
+
+   window = SDL_CreateWindow("events_inputSnapshot", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 320, 240, SDL_WINDOW_HIDDEN);
+   SDLTest_AssertPass("Call to SDL_CreateWindow()");
+   SDLTest_AssertCheck(window != NULL, "Check that the window was created");
+   if (window == NULL) {
+      return TEST_ABORTED;
+   }
+   modstate = SDL_GetModState();
+
+   SDL_PumpEvents();
+   sequence = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertPass("Call to SDL_GetInputSnapshot()");
+   SDLTest_AssertCheck(sequence != 0, "Check that the snapshot has a sequence number after pumping");
+   SDLTest_AssertCheck(snapshot.sequence == sequence, "Check the sequence number in the snapshot, expected: %d, got: %d", sequence, snapshot.sequence);
+
+   /* Nothing changed, so neither does the sequence number */
+   SDL_PumpEvents();
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertCheck(result == sequence, "Check the sequence number with no changes, expected: %d, got: %d", sequence, result);
+
+   /* New key state shows up once events are pumped */
+   SDL_SetModState(KMOD_LSHIFT | KMOD_NUM);
+   SDLTest_AssertPass("Call to SDL_SetModState(KMOD_LSHIFT | KMOD_NUM)");
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertCheck(result == sequence, "Check the sequence number before pumping, expected: %d, got: %d", sequence, result);
+   SDL_PumpEvents();
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertCheck(result != sequence, "Check that the sequence number changed with the key state");
+   SDLTest_AssertCheck(snapshot.modstate == (KMOD_LSHIFT | KMOD_NUM),
+      "Check the modifier state in the snapshot, expected: %d, got: %d", (int)(KMOD_LSHIFT | KMOD_NUM), (int)snapshot.modstate);
+   keystate = SDL_GetKeyboardState(NULL);
+   SDLTest_AssertCheck(SDL_memcmp(snapshot.keystate, keystate, sizeof(snapshot.keystate)) == 0,
+      "Check that the key state in the snapshot matches SDL_GetKeyboardState()");
+   sequence = result;
+
+   /* And so does new mouse state */
+   SDL_WarpMouseInWindow(window, 12, 34);
+   SDLTest_AssertPass("Call to SDL_WarpMouseInWindow(12, 34)");
+   SDL_PumpEvents();
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertCheck(result != sequence, "Check that the sequence number changed with the mouse state");
+   SDLTest_AssertCheck(snapshot.mouse_x == 12 && snapshot.mouse_y == 34,
+      "Check the mouse position in the snapshot, expected: 12,34, got: %d,%d", snapshot.mouse_x, snapshot.mouse_y);
+   SDLTest_AssertCheck(snapshot.mouse_focus == SDL_GetWindowID(window),
+      "Check the mouse focus in the snapshot, expected: %d, got: %d", SDL_GetWindowID(window), snapshot.mouse_focus);
+   sequence = result;
+
+   SDL_PumpEvents();
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertCheck(result == sequence, "Check the sequence number with no changes, expected: %d, got: %d", sequence, result);
+
+   SDL_SetModState(modstate);
+   SDL_DestroyWindow(window);
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Records events to memory and replays them
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_StartEventRecording
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_StartEventReplay
+ */
+int
+events_recordAndReplay(void *arg)
+{
+   static Uint8 buffer[4096];
+   const char *filename = "recorded/file.txt";
+   SDL_RWops *rw;
+   SDL_Event event;
+   Sint64 length;
+   Sint32 code;
+   int result, i;
+   int user = 0, key = 0, drop = 0;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   rw = SDL_RWFromMem(buffer, sizeof(buffer));
+   SDLTest_AssertPass("Call to SDL_RWFromMem()");
+   SDLTest_AssertCheck(rw != NULL, "Check that the stream was created");
+   if (rw == NULL) {
+      return TEST_ABORTED;
+   }
+   result = SDL_StartEventRecording(rw, 0);
+   SDLTest_AssertPass("Call to SDL_StartEventRecording()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_StartEventRecording, expected: 0, got: %i", result);
+
+   /* Push a user, keyboard and drop event */
+   code = SDLTest_RandomSint32();
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   event.user.code = code;
+   event.user.data1 = (void *)&_userdataValue1;
+   event.user.data2 = (void *)&_userdataValue2;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_KEYDOWN;
+   event.key.state = SDL_PRESSED;
+   event.key.keysym.scancode = SDL_SCANCODE_Q;
+   event.key.keysym.sym = SDLK_q;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_DROPFILE;
+   event.drop.file = SDL_strdup(filename);
+   SDL_PushEvent(&event);
+   SDLTest_AssertPass("Call to SDL_PushEvent() 3 times");
+   SDL_PumpEvents();
+   SDLTest_AssertPass("Call to SDL_PumpEvents()");
+
+   SDL_StopEventRecording();
+   SDLTest_AssertPass("Call to SDL_StopEventRecording()");
+   length = SDL_RWtell(rw);
+   SDLTest_AssertCheck(length > 0, "Check recording length, expected: >0, got: %"SDL_PRIs64, length);
+   SDL_RWclose(rw);
+
+   /* Take the originals off the queue */
+   while (SDL_PollEvent(&event)) {
+      if (event.type == SDL_DROPFILE) {
+         SDL_free(event.drop.file);
+      }
+   }
+
+   /* Play them back */
+   rw = SDL_RWFromConstMem(buffer, (int)length);
+   SDLTest_AssertPass("Call to SDL_RWFromConstMem()");
+   result = SDL_StartEventReplay(rw, 1, SDL_REPLAY_BENCHMARK);
+   SDLTest_AssertPass("Call to SDL_StartEventReplay()");
+   SDLTest_AssertCheck(result == 0, "Check result from SDL_StartEventReplay, expected: 0, got: %i", result);
+   for (i = 0; i < 10 && SDL_IsEventReplayActive(); i++) {
+      SDL_PumpEvents();
+   }
+   SDLTest_AssertCheck(SDL_IsEventReplayActive() == SDL_FALSE, "Check that the replay finished");
+
+   while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) == 1) {
+      switch (event.type) {
+      case SDL_USEREVENT:
+         user++;
+         SDLTest_AssertCheck(event.user.code == code, "Check user event code, expected: %d, got: %d", code, event.user.code);
+         SDLTest_AssertCheck(event.user.data1 == NULL && event.user.data2 == NULL, "Check that user event pointers were not kept");
+         SDLTest_AssertCheck(user == 1 && key == 0 && drop == 0, "Check that the user event came first");
+         break;
+      case SDL_KEYDOWN:
+         key++;
+         SDLTest_AssertCheck(event.key.keysym.scancode == SDL_SCANCODE_Q, "Check key scancode, expected: %d, got: %d", SDL_SCANCODE_Q, event.key.keysym.scancode);
+         SDLTest_AssertCheck(event.key.keysym.sym == SDLK_q, "Check key symbol, expected: %d, got: %d", SDLK_q, event.key.keysym.sym);
+         SDLTest_AssertCheck(event.key.state == SDL_PRESSED, "Check key state, expected: %d, got: %d", SDL_PRESSED, event.key.state);
+         SDLTest_AssertCheck(user == 1 && key == 1 && drop == 0, "Check that the keyboard event came second");
+         break;
+      case SDL_DROPFILE:
+         drop++;
+         SDLTest_AssertCheck(event.drop.file != NULL && SDL_strcmp(event.drop.file, filename) == 0,
+            "Check dropped file, expected: %s, got: %s", filename, event.drop.file ? event.drop.file : "NULL");
+         SDLTest_AssertCheck(user == 1 && key == 1 && drop == 1, "Check that the drop event came last");
+         SDL_free(event.drop.file);
+         break;
+      default:
+         break;
+      }
+   }
+   SDLTest_AssertCheck(user == 1, "Check number of user events, expected: 1, got: %d", user);
+   SDLTest_AssertCheck(key == 1, "Check number of keyboard events, expected: 1, got: %d", key);
+   SDLTest_AssertCheck(drop == 1, "Check number of drop events, expected: 1, got: %d", drop);
+
+   return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -187,9 +895,36 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_addDelEventWatchTypes, "events_addDelEventWatchTypes", "Adds and deletes an event watch function for a list of event types", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_pushStampsInputEvents, "events_pushStampsInputEvents", "Checks the nanosecond timestamps of pushed input events", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest6 =
+        { (SDLTest_TestCaseFp)events_pushFromMultipleThreads, "events_pushFromMultipleThreads", "Pushes events from several threads at once while polling them", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest7 =
+        { (SDLTest_TestCaseFp)events_recordAndReplay, "events_recordAndReplay", "Records events to memory and replays them", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest8 =
+        { (SDLTest_TestCaseFp)events_waitWakesOnPush, "events_waitWakesOnPush", "Waits for events pushed from another thread", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest9 =
+        { (SDLTest_TestCaseFp)events_coalesceMouseMotion, "events_coalesceMouseMotion", "Merges consecutive mouse motion events when coalescing is enabled", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest10 =
+        { (SDLTest_TestCaseFp)events_peepEventTypes, "events_peepEventTypes", "Peeks and gets events of a scattered set of types", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest11 =
+        { (SDLTest_TestCaseFp)events_queueStats, "events_queueStats", "Counts the events pushed and popped in a known sequence", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest12 =
+        { (SDLTest_TestCaseFp)events_inputSnapshot, "events_inputSnapshot", "Checks that input snapshots follow the keyboard and mouse state", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, &eventsTest8, &eventsTest9, &eventsTest10, &eventsTest11, &eventsTest12, NULL
 };
 
 /* Events test suite (global) */
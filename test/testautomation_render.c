@@ -1058,6 +1058,696 @@ _clearScreen(void)
    return 0;
 }
 
+/* Software renderers drawing to surfaces, which need no window */
+
+/**
+ * @brief Creates a software renderer drawing to a new surface of the test size.
+ */
+static SDL_Renderer *
+_createSoftwareRenderer(SDL_Surface **target)
+{
+   SDL_Renderer *swrenderer;
+
+   *target = SDL_CreateRGBSurface(SDL_SWSURFACE, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   SDLTest_AssertCheck(*target != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+   if (*target == NULL) {
+      return NULL;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(*target);
+   SDLTest_AssertPass("Call to SDL_CreateSoftwareRenderer()");
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(*target);
+      *target = NULL;
+      return NULL;
+   }
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   return swrenderer;
+}
+
+/**
+ * @brief Destroys a renderer made by _createSoftwareRenderer() and its surface.
+ */
+static void
+_destroySoftwareRenderer(SDL_Renderer *swrenderer, SDL_Surface *target)
+{
+   if (swrenderer != NULL) {
+      SDL_DestroyRenderer(swrenderer);
+   }
+   if (target != NULL) {
+      SDL_FreeSurface(target);
+   }
+}
+
+/**
+ * @brief Creates a surface with a translucent pattern that differs for every seed.
+ */
+static SDL_Surface *
+_createPatternSurface(int w, int h, int seed)
+{
+   SDL_Surface *surface;
+   Uint32 *pixels;
+   int x, y;
+
+   surface = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   if (surface == NULL) {
+      return NULL;
+   }
+   for (y = 0; y < h; y++) {
+      pixels = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+      for (x = 0; x < w; x++) {
+         pixels[x] = SDL_MapRGBA(surface->format,
+                                 (Uint8)(x * 17 + seed * 40),
+                                 (Uint8)(y * 23 + seed * 70),
+                                 (Uint8)((x ^ y) * 31 + seed * 90),
+                                 (Uint8)(((x + y + seed) % 4 == 0) ? 128 : 255));
+      }
+   }
+   return surface;
+}
+
+/**
+ * @brief Tests that copies from an atlas match copies from separate textures.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTextureAtlas
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateAtlasTextureFromSurface
+ */
+int
+render_testAtlasCopy(void *arg)
+{
+#define ATLAS_TEST_SPRITES 12
+   SDL_Surface *atlasTarget = NULL, *referenceTarget = NULL;
+   SDL_Renderer *atlasRenderer, *referenceRenderer;
+   SDL_TextureAtlas *atlas;
+   SDL_Surface *sprites[ATLAS_TEST_SPRITES];
+   SDL_Texture *atlasTextures[ATLAS_TEST_SPRITES];
+   SDL_Texture *referenceTextures[ATLAS_TEST_SPRITES];
+   SDL_Rect dst;
+   int i, pass, ret;
+
+   atlasRenderer = _createSoftwareRenderer(&atlasTarget);
+   referenceRenderer = _createSoftwareRenderer(&referenceTarget);
+   if (atlasRenderer == NULL || referenceRenderer == NULL) {
+      _destroySoftwareRenderer(atlasRenderer, atlasTarget);
+      _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+      return TEST_ABORTED;
+   }
+
+   /* Small pages, so the sprites go on more than one */
+   atlas = SDL_CreateTextureAtlas(atlasRenderer, SDL_PIXELFORMAT_ARGB8888, 32, 32);
+   SDLTest_AssertPass("Call to SDL_CreateTextureAtlas()");
+   SDLTest_AssertCheck(atlas != NULL, "Verify result from SDL_CreateTextureAtlas is not NULL");
+
+   for (i = 0; i < ATLAS_TEST_SPRITES; i++) {
+      sprites[i] = _createPatternSurface(3 + (i * 5) % 14, 2 + (i * 7) % 13, i);
+      SDLTest_AssertCheck(sprites[i] != NULL, "Verify sprite surface %d was created", i);
+      atlasTextures[i] = atlas ? SDL_CreateAtlasTextureFromSurface(atlas, sprites[i]) : NULL;
+      SDLTest_AssertCheck(atlasTextures[i] != NULL, "Verify atlas texture %d was created", i);
+      referenceTextures[i] = SDL_CreateTextureFromSurface(referenceRenderer, sprites[i]);
+      SDLTest_AssertCheck(referenceTextures[i] != NULL, "Verify reference texture %d was created", i);
+      SDL_SetTextureBlendMode(atlasTextures[i], SDL_BLENDMODE_BLEND);
+      SDL_SetTextureBlendMode(referenceTextures[i], SDL_BLENDMODE_BLEND);
+   }
+   SDLTest_AssertPass("Call to SDL_CreateAtlasTextureFromSurface() %d times", ATLAS_TEST_SPRITES);
+
+   for (pass = 0; pass < 2; pass++) {
+      SDL_SetRenderDrawColor(atlasRenderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(atlasRenderer);
+      SDL_SetRenderDrawColor(referenceRenderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(referenceRenderer);
+
+      /* Overlapping copies, some of them modulated */
+      for (i = 0; i < ATLAS_TEST_SPRITES * 2; i++) {
+         const int sprite = (i * 7 + pass) % ATLAS_TEST_SPRITES;
+         dst.x = (i * 13) % (TESTRENDER_SCREEN_W - 8);
+         dst.y = (i * 11) % (TESTRENDER_SCREEN_H - 8);
+         dst.w = sprites[sprite]->w;
+         dst.h = sprites[sprite]->h;
+         SDL_SetTextureColorMod(atlasTextures[sprite], 255, (Uint8)(255 - i * 8), 255);
+         SDL_SetTextureColorMod(referenceTextures[sprite], 255, (Uint8)(255 - i * 8), 255);
+         SDL_RenderCopy(atlasRenderer, atlasTextures[sprite], NULL, &dst);
+         SDL_RenderCopy(referenceRenderer, referenceTextures[sprite], NULL, &dst);
+      }
+      SDL_RenderFlush(atlasRenderer);
+      SDL_RenderFlush(referenceRenderer);
+
+      ret = SDLTest_CompareSurfaces(atlasTarget, referenceTarget, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate atlas copies match texture copies in pass %d, expected: 0, got: %i", pass, ret);
+
+      /* Give back every other sprite's space and add them again */
+      for (i = 0; i < ATLAS_TEST_SPRITES; i += 2) {
+         SDL_DestroyTexture(atlasTextures[i]);
+      }
+      for (i = 0; i < ATLAS_TEST_SPRITES; i += 2) {
+         atlasTextures[i] = atlas ? SDL_CreateAtlasTextureFromSurface(atlas, sprites[i]) : NULL;
+         SDLTest_AssertCheck(atlasTextures[i] != NULL, "Verify atlas texture %d was created again", i);
+         SDL_SetTextureBlendMode(atlasTextures[i], SDL_BLENDMODE_BLEND);
+      }
+   }
+
+   for (i = 0; i < ATLAS_TEST_SPRITES; i++) {
+      SDL_DestroyTexture(referenceTextures[i]);
+      SDL_FreeSurface(sprites[i]);
+   }
+   SDL_DestroyTextureAtlas(atlas);
+   SDLTest_AssertPass("Call to SDL_DestroyTextureAtlas()");
+   _destroySoftwareRenderer(atlasRenderer, atlasTarget);
+   _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+
+   return TEST_COMPLETED;
+#undef ATLAS_TEST_SPRITES
+}
+
+/**
+ * @brief Checks that an atlas texture draws as its solid color.
+ */
+static int
+_checkSolidAtlasTexture(SDL_Renderer *swrenderer, SDL_Texture *texture, Uint32 color)
+{
+   Uint32 pixels[24 * 24];
+   SDL_Rect rect;
+   int i, wrong = 0;
+
+   SDL_QueryTexture(texture, NULL, NULL, &rect.w, &rect.h);
+   rect.x = 0;
+   rect.y = 0;
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   if (SDL_RenderReadPixels(swrenderer, &rect, RENDER_COMPARE_FORMAT, pixels, rect.w * sizeof(Uint32)) < 0) {
+      return -1;
+   }
+   for (i = 0; i < rect.w * rect.h; i++) {
+      if (pixels[i] != color) {
+         wrong++;
+      }
+   }
+   return wrong;
+}
+
+/**
+ * @brief Adds and destroys atlas textures at random and checks they never overlap.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateAtlasTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_DestroyTexture
+ */
+int
+render_testAtlasStress(void *arg)
+{
+#define ATLAS_STRESS_TEXTURES 48
+   SDL_Surface *target = NULL;
+   SDL_Renderer *swrenderer;
+   SDL_TextureAtlas *atlas;
+   SDL_Texture *textures[ATLAS_STRESS_TEXTURES];
+   Uint32 colors[ATLAS_STRESS_TEXTURES];
+   Uint32 pixels[24 * 24];
+   int i, j, w, h, iteration;
+   int created = 0, failed = 0, wrong = 0;
+
+   swrenderer = _createSoftwareRenderer(&target);
+   if (swrenderer == NULL) {
+      return TEST_ABORTED;
+   }
+   atlas = SDL_CreateTextureAtlas(swrenderer, SDL_PIXELFORMAT_ARGB8888, 128, 128);
+   SDLTest_AssertPass("Call to SDL_CreateTextureAtlas()");
+   SDLTest_AssertCheck(atlas != NULL, "Verify result from SDL_CreateTextureAtlas is not NULL");
+   if (atlas == NULL) {
+      _destroySoftwareRenderer(swrenderer, target);
+      return TEST_ABORTED;
+   }
+   SDL_zero(textures);
+
+   for (iteration = 0; iteration < 4000; iteration++) {
+      i = SDLTest_RandomIntegerInRange(0, ATLAS_STRESS_TEXTURES - 1);
+      if (textures[i]) {
+         SDL_DestroyTexture(textures[i]);
+         textures[i] = NULL;
+         continue;
+      }
+
+      /* Fill each texture with its own opaque color */
+      w = SDLTest_RandomIntegerInRange(1, 24);
+      h = SDLTest_RandomIntegerInRange(1, 24);
+      colors[i] = 0xff000000 | (Uint32)((iteration * 2654435761u) >> 8);
+      for (j = 0; j < w * h; j++) {
+         pixels[j] = colors[i];
+      }
+      textures[i] = SDL_CreateAtlasTexture(atlas, w, h);
+      if (textures[i] == NULL) {
+         failed++;
+         continue;
+      }
+      SDL_UpdateTexture(textures[i], NULL, pixels, w * sizeof(Uint32));
+      created++;
+
+      /* A texture placed over another one would have changed its colors */
+      if ((iteration % 500) == 499) {
+         for (j = 0; j < ATLAS_STRESS_TEXTURES; j++) {
+            if (textures[j] && _checkSolidAtlasTexture(swrenderer, textures[j], colors[j]) != 0) {
+               wrong++;
+            }
+         }
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_CreateAtlasTexture() %d times", created);
+   SDLTest_AssertCheck(failed == 0, "Check failed atlas texture creations, expected: 0, got: %d", failed);
+   SDLTest_AssertCheck(wrong == 0, "Check atlas textures that were drawn over, expected: 0, got: %d", wrong);
+
+   SDL_DestroyTextureAtlas(atlas);
+   SDLTest_AssertPass("Call to SDL_DestroyTextureAtlas()");
+   _destroySoftwareRenderer(swrenderer, target);
+
+   return TEST_COMPLETED;
+#undef ATLAS_STRESS_TEXTURES
+}
+
+/**
+ * @brief Tests that drawing with the software tile threads matches drawing on one thread.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_HINT_RENDER_SW_THREADS
+ */
+int
+render_testTiledCopy(void *arg)
+{
+   SDL_Surface *tiledTarget = NULL, *referenceTarget = NULL;
+   SDL_Renderer *tiledRenderer, *referenceRenderer;
+   SDL_Renderer *renderers[2];
+   SDL_Surface *sprite;
+   SDL_Texture *textures[2];
+   SDL_Rect rect, clip;
+   int i, r, pass, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_SW_THREADS, "4");
+   tiledRenderer = _createSoftwareRenderer(&tiledTarget);
+   SDL_SetHint(SDL_HINT_RENDER_SW_THREADS, "0");
+   referenceRenderer = _createSoftwareRenderer(&referenceTarget);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_RENDER_SW_THREADS)");
+   sprite = _createPatternSurface(24, 20, 3);
+   if (tiledRenderer == NULL || referenceRenderer == NULL || sprite == NULL) {
+      _destroySoftwareRenderer(tiledRenderer, tiledTarget);
+      _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+      SDL_FreeSurface(sprite);
+      return TEST_ABORTED;
+   }
+   renderers[0] = tiledRenderer;
+   renderers[1] = referenceRenderer;
+
+   for (r = 0; r < 2; r++) {
+      textures[r] = SDL_CreateTextureFromSurface(renderers[r], sprite);
+      SDLTest_AssertCheck(textures[r] != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      SDL_SetTextureBlendMode(textures[r], SDL_BLENDMODE_BLEND);
+   }
+
+   /* Runs of overlapping fills and copies, large enough to be split into bands */
+   for (pass = 0; pass < 2; pass++) {
+      for (r = 0; r < 2; r++) {
+         SDL_Renderer *swrenderer = renderers[r];
+
+         if (pass == 1) {
+            clip.x = 5;
+            clip.y = 7;
+            clip.w = TESTRENDER_SCREEN_W - 12;
+            clip.h = TESTRENDER_SCREEN_H - 15;
+            SDL_RenderSetClipRect(swrenderer, &clip);
+         }
+         SDL_SetRenderDrawColor(swrenderer, 20, 30, 40, SDL_ALPHA_OPAQUE);
+         SDL_RenderClear(swrenderer);
+         for (i = 0; i < 48; i++) {
+            rect.x = (i * 17) % TESTRENDER_SCREEN_W - 10;
+            rect.y = (i * 13) % TESTRENDER_SCREEN_H - 8;
+            if (i % 3 == 0) {
+               rect.w = 30 + i % 7;
+               rect.h = 20 + i % 11;
+               SDL_SetRenderDrawBlendMode(swrenderer, (i % 2) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+               SDL_SetRenderDrawColor(swrenderer, (Uint8)(i * 5), (Uint8)(255 - i * 5), (Uint8)(i * 3), 160);
+               SDL_RenderFillRect(swrenderer, &rect);
+            } else {
+               rect.w = sprite->w;
+               rect.h = sprite->h;
+               SDL_RenderCopy(swrenderer, textures[r], NULL, &rect);
+            }
+         }
+         SDL_RenderFlush(swrenderer);
+         SDL_RenderSetClipRect(swrenderer, NULL);
+      }
+
+      ret = SDLTest_CompareSurfaces(tiledTarget, referenceTarget, 0);
+      SDLTest_AssertCheck(ret == 0, "Validate tiled drawing matches serial drawing in pass %d, expected: 0, got: %i", pass, ret);
+   }
+
+   SDL_DestroyTexture(textures[0]);
+   SDL_DestroyTexture(textures[1]);
+   SDL_FreeSurface(sprite);
+   _destroySoftwareRenderer(tiledRenderer, tiledTarget);
+   _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that batched drawing matches drawing each call right away.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_HINT_RENDER_BATCHING
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderFlush
+ */
+int
+render_testBatchedDrawing(void *arg)
+{
+   SDL_Surface *batchedTarget = NULL, *referenceTarget = NULL;
+   SDL_Renderer *renderers[2];
+   SDL_Texture *textures[2];
+   SDL_Surface *sprite;
+   SDL_Rect rect, viewport;
+   int i, r, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+   renderers[0] = _createSoftwareRenderer(&batchedTarget);
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, "0");
+   renderers[1] = _createSoftwareRenderer(&referenceTarget);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_RENDER_BATCHING)");
+   sprite = _createPatternSurface(12, 10, 5);
+   if (renderers[0] == NULL || renderers[1] == NULL || sprite == NULL) {
+      _destroySoftwareRenderer(renderers[0], batchedTarget);
+      _destroySoftwareRenderer(renderers[1], referenceTarget);
+      SDL_FreeSurface(sprite);
+      return TEST_ABORTED;
+   }
+
+   for (r = 0; r < 2; r++) {
+      SDL_Renderer *swrenderer = renderers[r];
+
+      textures[r] = SDL_CreateTextureFromSurface(swrenderer, sprite);
+      SDLTest_AssertCheck(textures[r] != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+      SDL_SetTextureBlendMode(textures[r], SDL_BLENDMODE_BLEND);
+
+      SDL_SetRenderDrawColor(swrenderer, 60, 60, 90, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+      for (i = 0; i < 40; i++) {
+         rect.x = (i * 19) % TESTRENDER_SCREEN_W - 4;
+         rect.y = (i * 7) % TESTRENDER_SCREEN_H - 3;
+         rect.w = sprite->w;
+         rect.h = sprite->h;
+         if (i % 4 == 0) {
+            /* Fills in between copies end a run */
+            SDL_SetRenderDrawBlendMode(swrenderer, (i % 8) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_ADD);
+            SDL_SetRenderDrawColor(swrenderer, (Uint8)(i * 6), 100, (Uint8)(255 - i * 6), 128);
+            SDL_RenderFillRect(swrenderer, &rect);
+         } else {
+            /* Queued copies have to keep the modulation they were drawn with */
+            SDL_SetTextureColorMod(textures[r], 255, (Uint8)(i * 6), 200);
+            SDL_SetTextureAlphaMod(textures[r], (Uint8)(255 - i * 3));
+            SDL_RenderCopy(swrenderer, textures[r], NULL, &rect);
+         }
+         if (i == 20) {
+            /* Unbatched drawing and a viewport change in the middle */
+            SDL_SetRenderDrawColor(swrenderer, 255, 255, 0, SDL_ALPHA_OPAQUE);
+            SDL_RenderDrawLine(swrenderer, 0, 0, TESTRENDER_SCREEN_W - 1, TESTRENDER_SCREEN_H - 1);
+            viewport.x = 10;
+            viewport.y = 5;
+            viewport.w = TESTRENDER_SCREEN_W - 20;
+            viewport.h = TESTRENDER_SCREEN_H - 10;
+            SDL_RenderSetViewport(swrenderer, &viewport);
+         }
+      }
+      SDL_RenderSetViewport(swrenderer, NULL);
+      SDL_RenderFlush(swrenderer);
+      SDLTest_AssertPass("Call to SDL_RenderFlush()");
+   }
+
+   ret = SDLTest_CompareSurfaces(batchedTarget, referenceTarget, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate batched drawing matches immediate drawing, expected: 0, got: %i", ret);
+
+   SDL_DestroyTexture(textures[0]);
+   SDL_DestroyTexture(textures[1]);
+   SDL_FreeSurface(sprite);
+   _destroySoftwareRenderer(renderers[0], batchedTarget);
+   _destroySoftwareRenderer(renderers[1], referenceTarget);
+
+   return TEST_COMPLETED;
+}
+
+/* Fills in the four corners of rect, clockwise from the top left */
+static void
+_setQuadVertices(SDL_Vertex *vertices, const SDL_Rect *rect, const SDL_Color *color)
+{
+   int i;
+
+   for (i = 0; i < 4; i++) {
+      vertices[i].position.x = (float)(rect->x + ((i == 1 || i == 2) ? rect->w : 0));
+      vertices[i].position.y = (float)(rect->y + ((i >= 2) ? rect->h : 0));
+      vertices[i].color = *color;
+      vertices[i].tex_coord.x = (i == 1 || i == 2) ? 1.0f : 0.0f;
+      vertices[i].tex_coord.y = (i >= 2) ? 1.0f : 0.0f;
+   }
+}
+
+/**
+ * @brief Tests that triangles drawn with SDL_RenderGeometry cover the same
+ *        pixels as the equivalent rectangle calls.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderGeometry
+ */
+int
+render_testGeometry(void *arg)
+{
+   static const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+   SDL_Surface *geometryTarget = NULL, *referenceTarget = NULL;
+   SDL_Renderer *geometryRenderer, *referenceRenderer;
+   SDL_Texture *geometryTexture = NULL, *referenceTexture = NULL;
+   SDL_Surface *sprite;
+   SDL_Vertex quad[4], triangles[6];
+   SDL_Color color;
+   SDL_Rect rect;
+   int i, ret;
+
+   geometryRenderer = _createSoftwareRenderer(&geometryTarget);
+   referenceRenderer = _createSoftwareRenderer(&referenceTarget);
+   sprite = _createPatternSurface(16, 12, 9);
+   if (geometryRenderer == NULL || referenceRenderer == NULL || sprite == NULL) {
+      _destroySoftwareRenderer(geometryRenderer, geometryTarget);
+      _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+      SDL_FreeSurface(sprite);
+      return TEST_ABORTED;
+   }
+
+   /* Two solid triangles against SDL_RenderFillRect() */
+   color.r = 200;
+   color.g = 80;
+   color.b = 30;
+   color.a = SDL_ALPHA_OPAQUE;
+   rect.x = 5;
+   rect.y = 7;
+   rect.w = 23;
+   rect.h = 17;
+   _setQuadVertices(quad, &rect, &color);
+   for (i = 0; i < 6; i++) {
+      triangles[i] = quad[indices[i]];
+   }
+   ret = SDL_RenderGeometry(geometryRenderer, NULL, triangles, 6, NULL, 0);
+   SDLTest_AssertPass("Call to SDL_RenderGeometry(NULL texture)");
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawColor(referenceRenderer, color.r, color.g, color.b, color.a);
+   SDL_RenderFillRect(referenceRenderer, &rect);
+
+   /* The same rectangle as indexed vertices, blended on top */
+   color.r = 20;
+   color.g = 120;
+   color.b = 240;
+   color.a = 100;
+   rect.x = 15;
+   rect.y = 12;
+   _setQuadVertices(quad, &rect, &color);
+   SDL_SetRenderDrawBlendMode(geometryRenderer, SDL_BLENDMODE_BLEND);
+   ret = SDL_RenderGeometry(geometryRenderer, NULL, quad, 4, indices, 6);
+   SDLTest_AssertPass("Call to SDL_RenderGeometry(indices)");
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawBlendMode(referenceRenderer, SDL_BLENDMODE_BLEND);
+   SDL_SetRenderDrawColor(referenceRenderer, color.r, color.g, color.b, color.a);
+   SDL_RenderFillRect(referenceRenderer, &rect);
+
+   /* A textured quad against SDL_RenderCopy() */
+   geometryTexture = SDL_CreateTextureFromSurface(geometryRenderer, sprite);
+   referenceTexture = SDL_CreateTextureFromSurface(referenceRenderer, sprite);
+   SDLTest_AssertCheck(geometryTexture != NULL && referenceTexture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+   if (geometryTexture != NULL && referenceTexture != NULL) {
+      color.r = color.g = color.b = color.a = 255;
+      rect.x = 40;
+      rect.y = 30;
+      rect.w = sprite->w;
+      rect.h = sprite->h;
+      _setQuadVertices(quad, &rect, &color);
+      ret = SDL_RenderGeometry(geometryRenderer, geometryTexture, quad, 4, indices, 6);
+      SDLTest_AssertPass("Call to SDL_RenderGeometry(texture)");
+      SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+      SDL_RenderCopy(referenceRenderer, referenceTexture, NULL, &rect);
+   }
+
+   SDL_RenderFlush(geometryRenderer);
+   SDL_RenderFlush(referenceRenderer);
+   SDLTest_AssertPass("Call to SDL_RenderFlush()");
+
+   ret = SDLTest_CompareSurfaces(geometryTarget, referenceTarget, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate geometry matches the rectangle calls, expected: 0, got: %i", ret);
+
+   if (geometryTexture != NULL) {
+      SDL_DestroyTexture(geometryTexture);
+   }
+   if (referenceTexture != NULL) {
+      SDL_DestroyTexture(referenceTexture);
+   }
+   SDL_FreeSurface(sprite);
+   _destroySoftwareRenderer(geometryRenderer, geometryTarget);
+   _destroySoftwareRenderer(referenceRenderer, referenceTarget);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that the floating point drawing calls match the integer ones
+ *        when given whole pixel coordinates.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderFillRectF
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyF
+ */
+int
+render_testFloatDrawing(void *arg)
+{
+   SDL_Surface *intTarget = NULL, *floatTarget = NULL;
+   SDL_Renderer *intRenderer, *floatRenderer;
+   SDL_Texture *intTexture = NULL, *floatTexture = NULL;
+   SDL_Surface *sprite;
+   SDL_Point points[8], center;
+   SDL_FPoint fpoints[8], fcenter;
+   SDL_Rect rects[3];
+   SDL_FRect frects[3];
+   int i, ret;
+
+   intRenderer = _createSoftwareRenderer(&intTarget);
+   floatRenderer = _createSoftwareRenderer(&floatTarget);
+   sprite = _createPatternSurface(14, 9, 13);
+   if (intRenderer == NULL || floatRenderer == NULL || sprite == NULL) {
+      _destroySoftwareRenderer(intRenderer, intTarget);
+      _destroySoftwareRenderer(floatRenderer, floatTarget);
+      SDL_FreeSurface(sprite);
+      return TEST_ABORTED;
+   }
+   intTexture = SDL_CreateTextureFromSurface(intRenderer, sprite);
+   floatTexture = SDL_CreateTextureFromSurface(floatRenderer, sprite);
+   SDLTest_AssertCheck(intTexture != NULL && floatTexture != NULL, "Verify result from SDL_CreateTextureFromSurface is not NULL");
+   if (intTexture == NULL || floatTexture == NULL) {
+      if (intTexture != NULL) {
+         SDL_DestroyTexture(intTexture);
+      }
+      if (floatTexture != NULL) {
+         SDL_DestroyTexture(floatTexture);
+      }
+      SDL_FreeSurface(sprite);
+      _destroySoftwareRenderer(intRenderer, intTarget);
+      _destroySoftwareRenderer(floatRenderer, floatTarget);
+      return TEST_ABORTED;
+   }
+
+   for (i = 0; i < SDL_arraysize(points); i++) {
+      points[i].x = (i * 23) % TESTRENDER_SCREEN_W;
+      points[i].y = (i * 17) % TESTRENDER_SCREEN_H;
+      fpoints[i].x = (float)points[i].x;
+      fpoints[i].y = (float)points[i].y;
+   }
+   for (i = 0; i < SDL_arraysize(rects); i++) {
+      rects[i].x = 3 + i * 25;
+      rects[i].y = 4 + i * 15;
+      rects[i].w = 11 + i * 3;
+      rects[i].h = 7 + i * 2;
+      frects[i].x = (float)rects[i].x;
+      frects[i].y = (float)rects[i].y;
+      frects[i].w = (float)rects[i].w;
+      frects[i].h = (float)rects[i].h;
+   }
+   center.x = 2;
+   center.y = 3;
+   fcenter.x = (float)center.x;
+   fcenter.y = (float)center.y;
+
+   SDL_SetRenderDrawBlendMode(intRenderer, SDL_BLENDMODE_BLEND);
+   SDL_SetRenderDrawBlendMode(floatRenderer, SDL_BLENDMODE_BLEND);
+   SDL_SetRenderDrawColor(intRenderer, 40, 200, 90, 160);
+   SDL_SetRenderDrawColor(floatRenderer, 40, 200, 90, 160);
+
+   SDL_RenderFillRect(intRenderer, &rects[0]);
+   ret = SDL_RenderFillRectF(floatRenderer, &frects[0]);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderFillRectF, expected: 0, got: %i", ret);
+   SDL_RenderFillRects(intRenderer, &rects[1], 2);
+   ret = SDL_RenderFillRectsF(floatRenderer, &frects[1], 2);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderFillRectsF, expected: 0, got: %i", ret);
+
+   SDL_SetRenderDrawColor(intRenderer, 250, 30, 220, SDL_ALPHA_OPAQUE);
+   SDL_SetRenderDrawColor(floatRenderer, 250, 30, 220, SDL_ALPHA_OPAQUE);
+   SDL_RenderDrawRect(intRenderer, &rects[0]);
+   ret = SDL_RenderDrawRectF(floatRenderer, &frects[0]);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawRectF, expected: 0, got: %i", ret);
+   SDL_RenderDrawRects(intRenderer, &rects[1], 2);
+   ret = SDL_RenderDrawRectsF(floatRenderer, &frects[1], 2);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawRectsF, expected: 0, got: %i", ret);
+
+   SDL_RenderDrawLine(intRenderer, points[0].x, points[0].y, points[5].x, points[5].y);
+   ret = SDL_RenderDrawLineF(floatRenderer, fpoints[0].x, fpoints[0].y, fpoints[5].x, fpoints[5].y);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawLineF, expected: 0, got: %i", ret);
+   SDL_RenderDrawLines(intRenderer, points, 5);
+   ret = SDL_RenderDrawLinesF(floatRenderer, fpoints, 5);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawLinesF, expected: 0, got: %i", ret);
+
+   SDL_SetRenderDrawColor(intRenderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+   SDL_SetRenderDrawColor(floatRenderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+   SDL_RenderDrawPoint(intRenderer, points[6].x, points[6].y);
+   ret = SDL_RenderDrawPointF(floatRenderer, fpoints[6].x, fpoints[6].y);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawPointF, expected: 0, got: %i", ret);
+   SDL_RenderDrawPoints(intRenderer, points, SDL_arraysize(points));
+   ret = SDL_RenderDrawPointsF(floatRenderer, fpoints, SDL_arraysize(fpoints));
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderDrawPointsF, expected: 0, got: %i", ret);
+
+   rects[0].x = 50;
+   rects[0].y = 8;
+   rects[0].w = sprite->w;
+   rects[0].h = sprite->h;
+   frects[0].x = (float)rects[0].x;
+   frects[0].y = (float)rects[0].y;
+   frects[0].w = (float)rects[0].w;
+   frects[0].h = (float)rects[0].h;
+   SDL_RenderCopy(intRenderer, intTexture, NULL, &rects[0]);
+   ret = SDL_RenderCopyF(floatRenderer, floatTexture, NULL, &frects[0]);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderCopyF, expected: 0, got: %i", ret);
+
+   rects[0].y += 25;
+   frects[0].y += 25.0f;
+   SDL_RenderCopyEx(intRenderer, intTexture, NULL, &rects[0], 30.0, &center, SDL_FLIP_HORIZONTAL);
+   ret = SDL_RenderCopyExF(floatRenderer, floatTexture, NULL, &frects[0], 30.0, &fcenter, SDL_FLIP_HORIZONTAL);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_RenderCopyExF, expected: 0, got: %i", ret);
+
+   SDL_RenderFlush(intRenderer);
+   SDL_RenderFlush(floatRenderer);
+   SDLTest_AssertPass("Call to SDL_RenderFlush()");
+
+   ret = SDLTest_CompareSurfaces(floatTarget, intTarget, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate float drawing matches integer drawing, expected: 0, got: %i", ret);
+
+   SDL_DestroyTexture(intTexture);
+   SDL_DestroyTexture(floatTexture);
+   SDL_FreeSurface(sprite);
+   _destroySoftwareRenderer(intRenderer, intTarget);
+   _destroySoftwareRenderer(floatRenderer, floatTarget);
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1097,3 +1787,35 @@ SDLTest_TestSuiteReference renderTestSuite = {
     renderTests,
     CleanupDestroyRenderer
 };
+
+/* Software render test cases, which draw to surfaces */
+static const SDLTest_TestCaseReference renderSoftwareTest1 =
+        { (SDLTest_TestCaseFp)render_testAtlasCopy, "render_testAtlasCopy", "Tests copies from a texture atlas against separate textures", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderSoftwareTest2 =
+        { (SDLTest_TestCaseFp)render_testAtlasStress, "render_testAtlasStress", "Tests adding and destroying atlas textures at random", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderSoftwareTest3 =
+        { (SDLTest_TestCaseFp)render_testTiledCopy, "render_testTiledCopy", "Tests drawing with software tile threads against one thread", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderSoftwareTest4 =
+        { (SDLTest_TestCaseFp)render_testBatchedDrawing, "render_testBatchedDrawing", "Tests batched drawing against immediate drawing", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderSoftwareTest5 =
+        { (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests SDL_RenderGeometry against rectangle fills and copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderSoftwareTest6 =
+        { (SDLTest_TestCaseFp)render_testFloatDrawing, "render_testFloatDrawing", "Tests the floating point drawing calls against the integer ones", TEST_ENABLED };
+
+/* Sequence of Software render test cases */
+static const SDLTest_TestCaseReference *renderSoftwareTests[] =  {
+    &renderSoftwareTest1, &renderSoftwareTest2, &renderSoftwareTest3, &renderSoftwareTest4, &renderSoftwareTest5, &renderSoftwareTest6, NULL
+};
+
+/* Software render test suite (global) */
+SDLTest_TestSuiteReference renderSoftwareTestSuite = {
+    "RenderSoftware",
+    NULL,
+    renderSoftwareTests,
+    NULL
+};
@@ -299,6 +299,126 @@ surface_testSurfaceConversion(void *arg)
     return TEST_COMPLETED;
 }
 
+/* !
+ *  Tests creation, filling and blitting of SIMD aligned surfaces.
+ */
+int
+surface_testSIMDAligned(void *arg)
+{
+    SDL_Surface *face, *aligned, *copy;
+    size_t alignment;
+    Uint32 color;
+    int ret;
+
+    alignment = SDL_SIMDGetAlignment();
+    SDLTest_AssertPass("Call to SDL_SIMDGetAlignment()");
+    SDLTest_AssertCheck(alignment >= 16 && (alignment & (alignment - 1)) == 0,
+        "Verify alignment is a power of two of at least 16, got: %i", (int) alignment);
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL)
+        return TEST_ABORTED;
+
+    /* Create aligned surfaces with an odd width so the pitch needs padding */
+    aligned = SDL_CreateRGBSurface(SDL_SIMD_ALIGNED, face->w + 1, face->h,
+                                   face->format->BitsPerPixel,
+                                   face->format->Rmask, face->format->Gmask,
+                                   face->format->Bmask, face->format->Amask);
+    SDLTest_AssertPass("Call to SDL_CreateRGBSurface(SDL_SIMD_ALIGNED)");
+    SDLTest_AssertCheck(aligned != NULL, "Verify aligned surface is not NULL");
+    copy = SDL_CreateRGBSurface(SDL_SIMD_ALIGNED, face->w + 1, face->h,
+                                face->format->BitsPerPixel,
+                                face->format->Rmask, face->format->Gmask,
+                                face->format->Bmask, face->format->Amask);
+    SDLTest_AssertCheck(copy != NULL, "Verify second aligned surface is not NULL");
+    if (aligned == NULL || copy == NULL) {
+        SDL_FreeSurface(face);
+        SDL_FreeSurface(aligned);
+        SDL_FreeSurface(copy);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck((aligned->flags & SDL_SIMD_ALIGNED) != 0, "Verify SDL_SIMD_ALIGNED flag is set");
+    SDLTest_AssertCheck(((size_t) aligned->pixels & (alignment - 1)) == 0, "Verify pixels are aligned");
+    SDLTest_AssertCheck((aligned->pitch & (alignment - 1)) == 0, "Verify pitch is aligned, got: %i", aligned->pitch);
+    SDLTest_AssertCheck(aligned->pitch >= aligned->w * aligned->format->BytesPerPixel, "Verify pitch covers a row");
+
+    /* Full surface fill takes the single span path */
+    color = SDL_MapRGBA(aligned->format, 0x12, 0x34, 0x56, 0x78);
+    ret = SDL_FillRect(aligned, NULL, color);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_FillRect, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(*(Uint32 *) aligned->pixels == color, "Verify first pixel was filled");
+    SDLTest_AssertCheck(((Uint32 *) ((Uint8 *) aligned->pixels + (aligned->h - 1) * aligned->pitch))[aligned->w - 1] == color,
+        "Verify last pixel was filled");
+
+    /* Blit the face in, then copy full width between aligned surfaces */
+    SDL_SetSurfaceBlendMode(face, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceBlendMode(aligned, SDL_BLENDMODE_NONE);
+    ret = SDL_BlitSurface(face, NULL, aligned, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    ret = SDL_BlitSurface(aligned, NULL, copy, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    ret = SDLTest_CompareSurfaces(copy, aligned, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+    SDL_FreeSurface(copy);
+    SDL_FreeSurface(aligned);
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/* !
+ *  Tests recycling of surfaces through the surface pool.
+ */
+int
+surface_testSurfacePool(void *arg)
+{
+    SDL_Surface *surface;
+    SDL_PixelFormat *format;
+    SDL_BlendMode blendMode;
+    void *pixels;
+    Uint8 alpha;
+
+    surface = SDL_CreateRGBSurface(SDL_POOLED, 64, 32, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    SDLTest_AssertPass("Call to SDL_CreateRGBSurface(SDL_POOLED)");
+    SDLTest_AssertCheck(surface != NULL, "Verify pooled surface is not NULL");
+    if (surface == NULL)
+        return TEST_ABORTED;
+    SDLTest_AssertCheck((surface->flags & SDL_POOLED) != 0, "Verify SDL_POOLED flag is set");
+
+    /* Dirty the state that must be reset on reuse */
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_ADD);
+    SDL_SetSurfaceAlphaMod(surface, 0x40);
+    surface->userdata = surface;
+    pixels = surface->pixels;
+    format = surface->format;
+    SDL_FreeSurface(surface);
+    SDLTest_AssertPass("Call to SDL_FreeSurface() on pooled surface");
+
+    surface = SDL_CreateRGBSurface(SDL_POOLED, 64, 32, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    SDLTest_AssertCheck(surface != NULL, "Verify recycled surface is not NULL");
+    if (surface == NULL)
+        return TEST_ABORTED;
+    SDLTest_AssertCheck(surface->pixels == pixels, "Verify pixels were recycled");
+    SDLTest_AssertCheck(surface->format == format, "Verify format was recycled");
+    SDLTest_AssertCheck(surface->userdata == NULL, "Verify userdata was reset");
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_BLEND, "Verify blend mode was reset, got: %i", blendMode);
+    SDL_GetSurfaceAlphaMod(surface, &alpha);
+    SDLTest_AssertCheck(alpha == 0xFF, "Verify alpha mod was reset, got: %i", alpha);
+    SDL_FreeSurface(surface);
+
+    /* A different size must not match */
+    surface = SDL_CreateRGBSurface(SDL_POOLED, 32, 32, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    SDLTest_AssertCheck(surface != NULL && surface->w == 32 && surface->pitch == 32 * 4, "Verify surface of another size has its own geometry");
+    SDL_FreeSurface(surface);
+
+    SDL_FlushSurfacePool();
+    SDLTest_AssertPass("Call to SDL_FlushSurfacePool()");
+
+    return TEST_COMPLETED;
+}
 
 /* !
  *  Tests surface conversion across all pixel formats.
@@ -630,11 +750,17 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testSIMDAligned, "surface_testSIMDAligned", "Tests SIMD aligned surface creation, fill and blit.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testSurfacePool, "surface_testSurfacePool", "Tests recycling surfaces through the surface pool.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, NULL
 };
 
 /* Surface test suite (global) */
@@ -172,6 +172,54 @@ timer_addRemoveTimer(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_GetTicksNS
+ */
+int
+timer_getTicksNS(void *arg)
+{
+  const Uint32 testDelay = 100;
+  const Uint32 marginOfError = 25;
+  Uint64 result;
+  Uint64 result2;
+  Uint32 ticks;
+  Uint32 ticks2;
+  Uint64 difference;
+  int i, backwards = 0;
+
+  /* Never goes backwards */
+  result = SDL_GetTicksNS();
+  SDLTest_AssertPass("Call to SDL_GetTicksNS()");
+  for (i = 0; i < 100000; i++) {
+    result2 = SDL_GetTicksNS();
+    if (result2 < result) {
+      backwards++;
+    }
+    result = result2;
+  }
+  SDLTest_AssertPass("Call to SDL_GetTicksNS() 100000 times");
+  SDLTest_AssertCheck(backwards == 0, "Check that the time never went backwards, expected: 0, got: %i", backwards);
+
+  /* Follows SDL_GetTicks() */
+  ticks = SDL_GetTicks();
+  result = SDL_GetTicksNS();
+  ticks2 = SDL_GetTicks();
+  SDLTest_AssertPass("Call to SDL_GetTicksNS() between SDL_GetTicks()");
+  SDLTest_AssertCheck(result / 1000000 + marginOfError >= ticks && result / 1000000 <= ticks2 + marginOfError,
+    "Check result value, expected: %d..%d ms, got: %"SDL_PRIu64" ms", ticks, ticks2, result / 1000000);
+
+  /* Advances over a delay */
+  result = SDL_GetTicksNS();
+  SDL_Delay(testDelay);
+  result2 = SDL_GetTicksNS();
+  SDLTest_AssertPass("Call to SDL_GetTicksNS() around SDL_Delay(%d)", testDelay);
+  difference = result2 - result;
+  SDLTest_AssertCheck(difference >= (Uint64)(testDelay - marginOfError) * 1000000,
+    "Check difference, expected: >=%d ms, got: %"SDL_PRIu64" ns", testDelay - marginOfError, difference);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +235,12 @@ static const SDLTest_TestCaseReference timerTest3 =
 static const SDLTest_TestCaseReference timerTest4 =
         { (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference timerTest5 =
+        { (SDLTest_TestCaseFp)timer_getTicksNS, "timer_getTicksNS", "Call to SDL_GetTicksNS", TEST_ENABLED };
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] =  {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, NULL
 };
 
 /* Timer test suite (global) */
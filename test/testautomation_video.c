@@ -55,6 +55,68 @@ void _destroyVideoSuiteTestWindow(SDL_Window *window)
   }
 }
 
+/*
+ * Reads a pixel from a frame saved by the dummy driver in raw format and
+ * removes the file.  Returns SDL_FALSE if the frame wasn't saved.
+ */
+SDL_bool _readSavedFramePixel(Uint32 id, int w, int h, int frame, int x, int y, Uint32 *pixel)
+{
+  char file[128];
+  SDL_RWops *rw;
+  Sint64 size;
+
+  SDL_snprintf(file, sizeof(file), "SDL_window%d-%dx%d-%8.8d.raw", id, w, h, frame);
+  rw = SDL_RWFromFile(file, "rb");
+  if (rw == NULL) {
+     return SDL_FALSE;
+  }
+  size = SDL_RWsize(rw);
+  SDLTest_AssertCheck(size == (Sint64)w * h * 4, "Validate size of %s; expected: %d, got: %d", file, w * h * 4, (int)size);
+  *pixel = 0;
+  if (SDL_RWseek(rw, ((Sint64)y * w + x) * 4, RW_SEEK_SET) >= 0) {
+     *pixel = SDL_ReadLE32(rw);
+  }
+  SDL_RWclose(rw);
+  remove(file);
+  return SDL_TRUE;
+}
+
+/*
+ * Reads the top left pixel from a frame saved by the dummy driver as a BMP
+ * and removes the file.  Returns SDL_FALSE if the frame wasn't saved.
+ */
+SDL_bool _readSavedFrameBMP(Uint32 id, int w, int h, int frame, Uint32 *pixel)
+{
+  char file[128];
+  SDL_Surface *bmp, *converted;
+
+  SDL_snprintf(file, sizeof(file), "SDL_window%d-%8.8d.bmp", id, frame);
+  bmp = SDL_LoadBMP(file);
+  if (bmp == NULL) {
+     return SDL_FALSE;
+  }
+  SDLTest_AssertCheck(bmp->w == w && bmp->h == h, "Validate size of %s; expected: %dx%d, got: %dx%d", file, w, h, bmp->w, bmp->h);
+  *pixel = 0;
+  converted = SDL_ConvertSurfaceFormat(bmp, SDL_PIXELFORMAT_RGB888, 0);
+  if (converted != NULL) {
+     *pixel = *(Uint32 *)converted->pixels;
+     SDL_FreeSurface(converted);
+  }
+  SDL_FreeSurface(bmp);
+  remove(file);
+  return SDL_TRUE;
+}
+
+/* Keeps the last update statistics logged by the dummy driver */
+static char _dummyStatsMessage[256];
+
+void SDLCALL _captureDummyStats(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+  if (SDL_strstr(message, " updates, ") != NULL) {
+     SDL_strlcpy(_dummyStatsMessage, message, sizeof(_dummyStatsMessage));
+  }
+}
+
 /* Test case functions */
 
 /**
@@ -1721,6 +1783,341 @@ video_getSetWindowData(void *arg)
 }
 
 
+/**
+ * @brief Tests window surface updates with dirty rectangle tracking
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurface
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurfaceRects
+ */
+int
+video_updateWindowSurfaceDirty(void *arg)
+{
+  const char* title = "video_updateWindowSurfaceDirty Test Window";
+  SDL_Window* window;
+  SDL_Surface* surface;
+  SDL_Rect rects[3];
+  int result;
+
+  SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "1");
+  SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, \"1\")");
+
+  /* Call against new test window */
+  window = _createVideoSuiteTestWindow(title);
+  if (window == NULL) {
+    SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "0");
+    return TEST_ABORTED;
+  }
+
+  surface = SDL_GetWindowSurface(window);
+  SDLTest_AssertPass("Call to SDL_GetWindowSurface()");
+  if (surface != NULL) {
+    SDLTest_AssertCheck((surface->flags & SDL_DIRTYTRACKED) != 0, "Validate that the window surface is tracked");
+
+    /* The first update presents the whole surface */
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertPass("Call to SDL_UpdateWindowSurface()");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+
+    /* Nothing changed since */
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Validate result value with nothing dirty; expected: 0, got: %d", result);
+
+    /* Fill some overlapping areas, partly outside the surface */
+    rects[0].x = 10; rects[0].y = 10; rects[0].w = 50; rects[0].h = 50;
+    rects[1].x = 40; rects[1].y = 40; rects[1].w = 50; rects[1].h = 50;
+    rects[2].x = -20; rects[2].y = surface->h - 10; rects[2].w = 50; rects[2].h = 50;
+    result = SDL_FillRects(surface, rects, 3, SDL_MapRGB(surface->format, 0xFF, 0x80, 0x00));
+    SDLTest_AssertCheck(result == 0, "Validate SDL_FillRects result value; expected: 0, got: %d", result);
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Validate result value with dirty areas; expected: 0, got: %d", result);
+
+    /* Explicit rectangles are clipped and merged too */
+    result = SDL_UpdateWindowSurfaceRects(window, rects, 3);
+    SDLTest_AssertPass("Call to SDL_UpdateWindowSurfaceRects()");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  }
+
+  /* Clean up */
+  _destroyVideoSuiteTestWindow(window);
+  SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "0");
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that dirty tracking keeps the changes a window surface update didn't present
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurface
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurfaceRects
+ */
+int
+video_updateWindowSurfaceDirtyPresented(void *arg)
+{
+  const char* title = "video_updateWindowSurfaceDirtyPresented Test Window";
+  const Uint32 color = 0x00FF8000;
+  SDL_Window* window;
+  SDL_Surface* surface;
+  SDL_Renderer* renderer;
+  SDL_Rect clip, rects[2];
+  Uint32 pixel;
+  SDL_bool saved;
+  int frame = 0;
+  int result;
+
+  if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") != 0) {
+    SDLTest_Log("Skipping test, the frames presented can only be checked with the dummy driver");
+    return TEST_SKIPPED;
+  }
+
+  SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "1");
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, "raw");
+  SDLTest_AssertPass("Call to SDL_SetHint() to track changes and save presented frames");
+
+  window = _createVideoSuiteTestWindow(title);
+  surface = window ? SDL_GetWindowSurface(window) : NULL;
+  if (surface == NULL) {
+    _destroyVideoSuiteTestWindow(window);
+    SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "0");
+    SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, "0");
+    return TEST_ABORTED;
+  }
+
+  /* The first update presents the whole surface */
+  result = SDL_UpdateWindowSurface(window);
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, 0, 0, &pixel);
+  SDLTest_AssertCheck(saved, "Validate that frame %d was presented", frame);
+
+  /* A line crossing the clip rectangle with both ends outside of it */
+  renderer = SDL_CreateSoftwareRenderer(surface);
+  SDLTest_AssertCheck(renderer != NULL, "Validate that SDL_CreateSoftwareRenderer() succeeded");
+  if (renderer != NULL) {
+    clip.x = surface->w / 4;
+    clip.y = surface->h / 4;
+    clip.w = surface->w / 2;
+    clip.h = surface->h / 2;
+    SDL_RenderSetClipRect(renderer, &clip);
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0x80, 0x00, 0xFF);
+    result = SDL_RenderDrawLine(renderer, 0, surface->h / 2, surface->w - 1, surface->h / 2);
+    SDLTest_AssertCheck(result == 0, "Validate SDL_RenderDrawLine result value; expected: 0, got: %d", result);
+    SDL_DestroyRenderer(renderer);
+    SDL_SetClipRect(surface, NULL);
+
+    result = SDL_UpdateWindowSurface(window);
+    SDLTest_AssertCheck(result == 0, "Validate result value after drawing a line; expected: 0, got: %d", result);
+    saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, surface->w / 2, surface->h / 2, &pixel);
+    SDLTest_AssertCheck(saved, "Validate that frame %d was presented", frame);
+    SDLTest_AssertCheck(!saved || (pixel & 0x00FFFFFF) == color, "Validate the line in the presented frame; expected: 0x%.6x, got: 0x%.6x", color, pixel & 0x00FFFFFF);
+  }
+
+  /* Present only one of two changed areas, the other one stays dirty */
+  rects[0].x = 0; rects[0].y = 0; rects[0].w = 10; rects[0].h = 10;
+  rects[1].x = surface->w - 10; rects[1].y = surface->h - 10; rects[1].w = 10; rects[1].h = 10;
+  result = SDL_FillRects(surface, rects, 2, SDL_MapRGB(surface->format, 0xFF, 0x80, 0x00));
+  SDLTest_AssertCheck(result == 0, "Validate SDL_FillRects result value; expected: 0, got: %d", result);
+  result = SDL_UpdateWindowSurfaceRects(window, &rects[0], 1);
+  SDLTest_AssertCheck(result == 0, "Validate SDL_UpdateWindowSurfaceRects result value; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, 0, 0, &pixel);
+  SDLTest_AssertCheck(saved, "Validate that frame %d was presented", frame);
+  result = SDL_UpdateWindowSurface(window);
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, 0, 0, &pixel);
+  SDLTest_AssertCheck(saved, "Validate that frame %d presented the remaining area", frame);
+
+  /* Present part of a changed area, the rest of it stays dirty */
+  rects[0].w = surface->w; rects[0].h = 20;
+  result = SDL_FillRect(surface, &rects[0], SDL_MapRGB(surface->format, 0x00, 0x80, 0xFF));
+  SDLTest_AssertCheck(result == 0, "Validate SDL_FillRect result value; expected: 0, got: %d", result);
+  rects[0].h = 10;
+  result = SDL_UpdateWindowSurfaceRects(window, &rects[0], 1);
+  SDLTest_AssertCheck(result == 0, "Validate SDL_UpdateWindowSurfaceRects result value; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, 0, 0, &pixel);
+  SDLTest_AssertCheck(saved, "Validate that frame %d was presented", frame);
+  result = SDL_UpdateWindowSurface(window);
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, ++frame, 0, 0, &pixel);
+  SDLTest_AssertCheck(saved, "Validate that frame %d presented the remaining area", frame);
+
+  /* Everything is up to date now */
+  result = SDL_UpdateWindowSurface(window);
+  SDLTest_AssertCheck(result == 0, "Validate result value with nothing dirty; expected: 0, got: %d", result);
+  saved = _readSavedFramePixel(SDL_GetWindowID(window), surface->w, surface->h, frame + 1, 0, 0, &pixel);
+  SDLTest_AssertCheck(!saved, "Validate that frame %d was not presented", frame + 1);
+
+  /* Clean up */
+  _destroyVideoSuiteTestWindow(window);
+  SDL_SetHint(SDL_HINT_FRAMEBUFFER_DIRTY_TRACKING, "0");
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, "0");
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests asynchronous window surface updates with several MIT-SHM buffers on X11
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurface
+ */
+int
+video_updateWindowSurfaceShmBuffers(void *arg)
+{
+  const char* title = "video_updateWindowSurfaceShmBuffers Test Window";
+  const char* buffers[] = { "2", "3" };
+  SDL_Window* window;
+  SDL_Surface* surface;
+  SDL_Surface* current;
+  Uint32 start, elapsed;
+  int i, j;
+  int result;
+
+  if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "x11") != 0) {
+    SDLTest_Log("Skipping test, MIT-SHM buffers are only used by the x11 driver");
+    return TEST_SKIPPED;
+  }
+
+  for (i = 0; i < SDL_arraysize(buffers); i++) {
+    SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, buffers[i]);
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, \"%s\")", buffers[i]);
+
+    window = _createVideoSuiteTestWindow(title);
+    if (window == NULL) {
+      SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, "1");
+      return TEST_ABORTED;
+    }
+
+    surface = SDL_GetWindowSurface(window);
+    SDLTest_AssertPass("Call to SDL_GetWindowSurface()");
+    SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+    if (surface != NULL) {
+      /* Present more frames in a row than there are buffers, so some of
+         the updates have to wait for the X server to release an image */
+      start = SDL_GetTicks();
+      for (j = 0; j < 16; j++) {
+        result = SDL_FillRect(surface, NULL, SDL_MapRGB(surface->format, j * 16, 0x80, 0xFF - j * 16));
+        SDLTest_AssertCheck(result == 0, "Validate SDL_FillRect result value; expected: 0, got: %d", result);
+        result = SDL_UpdateWindowSurface(window);
+        SDLTest_AssertCheck(result == 0, "Validate SDL_UpdateWindowSurface result value; expected: 0, got: %d", result);
+
+        /* Handle whatever completions have arrived, the surface stays usable */
+        if (j % 4 == 3) {
+          SDL_PumpEvents();
+        }
+        current = SDL_GetWindowSurface(window);
+        SDLTest_AssertCheck(current == surface && current->pixels != NULL, "Validate that the window surface is unchanged after update %d", j + 1);
+        if (current != surface) {
+          break;
+        }
+      }
+      elapsed = SDL_GetTicks() - start;
+      SDLTest_AssertCheck(elapsed < 5000, "Validate that the updates didn't stall; expected: <5000 ms, got: %d ms", elapsed);
+    }
+
+    _destroyVideoSuiteTestWindow(window);
+  }
+
+  /* Clean up */
+  SDL_SetHint(SDL_HINT_VIDEO_X11_SHM_BUFFERS, "1");
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the dummy driver display modes, saved frames and update statistics
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_UpdateWindowSurface
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_VideoQuit
+ */
+int
+video_dummySaveFrames(void *arg)
+{
+  const char* title = "video_dummySaveFrames Test Window";
+  const char* formats[] = { "bmp", "raw" };
+  const Uint32 colors[] = { 0x00FF0000, 0x000000FF };
+  SDL_LogOutputFunction log_function;
+  void *log_userdata;
+  SDL_DisplayMode mode;
+  SDL_Window* window;
+  SDL_Surface* surface;
+  Uint32 id, pixel;
+  SDL_bool saved;
+  int i, frame;
+  int result;
+
+  if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") != 0) {
+    SDLTest_Log("Skipping test, the hints only apply to the dummy driver");
+    return TEST_SKIPPED;
+  }
+
+  SDL_LogGetOutputFunction(&log_function, &log_userdata);
+  SDL_LogSetOutputFunction(_captureDummyStats, NULL);
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    /* The hints are read when the driver starts up */
+    SDL_VideoQuit();
+    SDLTest_AssertPass("Call to SDL_VideoQuit()");
+    SDL_SetHint(SDL_HINT_VIDEO_DUMMY_DISPLAY_MODES, "640x480@60,320x200");
+    SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, formats[i]);
+    SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_THREAD, "1");
+    SDL_SetHint(SDL_HINT_VIDEO_DUMMY_STATS, "1");
+    result = SDL_VideoInit("dummy");
+    SDLTest_AssertCheck(result == 0, "Validate SDL_VideoInit(\"dummy\") result value; expected: 0, got: %d", result);
+    if (result != 0) {
+      break;
+    }
+
+    result = SDL_GetDesktopDisplayMode(0, &mode);
+    SDLTest_AssertCheck(result == 0, "Validate SDL_GetDesktopDisplayMode result value; expected: 0, got: %d", result);
+    SDLTest_AssertCheck(mode.w == 640 && mode.h == 480 && mode.refresh_rate == 60, "Validate desktop mode; expected: 640x480@60, got: %dx%d@%d", mode.w, mode.h, mode.refresh_rate);
+    result = SDL_GetNumDisplayModes(0);
+    SDLTest_AssertCheck(result == 2, "Validate number of display modes; expected: 2, got: %d", result);
+
+    window = SDL_CreateWindow(title, 0, 0, 64, 48, SDL_WINDOW_SHOWN);
+    SDLTest_AssertCheck(window != NULL, "Validate that SDL_CreateWindow() succeeded");
+    surface = window ? SDL_GetWindowSurface(window) : NULL;
+    SDLTest_AssertCheck(surface != NULL, "Validate that SDL_GetWindowSurface() succeeded");
+    if (surface == NULL) {
+      break;
+    }
+    id = SDL_GetWindowID(window);
+
+    /* Present two frames, then shut down while they may still be queued */
+    _dummyStatsMessage[0] = '\0';
+    for (frame = 0; frame < 2; frame++) {
+      SDL_FillRect(surface, NULL, SDL_MapRGB(surface->format, (colors[frame] >> 16) & 0xFF, (colors[frame] >> 8) & 0xFF, colors[frame] & 0xFF));
+      result = SDL_UpdateWindowSurface(window);
+      SDLTest_AssertCheck(result == 0, "Validate SDL_UpdateWindowSurface result value; expected: 0, got: %d", result);
+    }
+    SDL_VideoQuit();
+    SDLTest_AssertPass("Call to SDL_VideoQuit()");
+
+    /* Every queued frame has been written by now */
+    for (frame = 0; frame < 2; frame++) {
+      if (SDL_strcmp(formats[i], "raw") == 0) {
+        saved = _readSavedFramePixel(id, 64, 48, frame + 1, 0, 0, &pixel);
+      } else {
+        saved = _readSavedFrameBMP(id, 64, 48, frame + 1, &pixel);
+      }
+      SDLTest_AssertCheck(saved, "Validate that %s frame %d was saved", formats[i], frame + 1);
+      SDLTest_AssertCheck(!saved || (pixel & 0x00FFFFFF) == colors[frame], "Validate %s frame %d contents; expected: 0x%.6x, got: 0x%.6x", formats[i], frame + 1, colors[frame], pixel & 0x00FFFFFF);
+    }
+    saved = _readSavedFramePixel(id, 64, 48, 3, 0, 0, &pixel) || _readSavedFrameBMP(id, 64, 48, 3, &pixel);
+    SDLTest_AssertCheck(!saved, "Validate that no %s frame 3 was saved", formats[i]);
+
+    SDLTest_AssertCheck(SDL_strstr(_dummyStatsMessage, ": 2 updates, ") != NULL, "Validate the logged statistics; got: '%s'", _dummyStatsMessage);
+  }
+
+  /* Clean up */
+  SDL_LogSetOutputFunction(log_function, log_userdata);
+  SDL_VideoQuit();
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_DISPLAY_MODES, "");
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, "0");
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_THREAD, "0");
+  SDL_SetHint(SDL_HINT_VIDEO_DUMMY_STATS, "0");
+  result = SDL_VideoInit("dummy");
+  SDLTest_AssertCheck(result == 0, "Validate SDL_VideoInit(\"dummy\") result value; expected: 0, got: %d", result);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -1793,13 +2190,25 @@ static const SDLTest_TestCaseReference videoTest22 =
 static const SDLTest_TestCaseReference videoTest23 =
         { (SDLTest_TestCaseFp)video_getSetWindowData, "video_getSetWindowData",  "Checks SDL_SetWindowData and SDL_GetWindowData positive and negative cases", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference videoTest24 =
+        { (SDLTest_TestCaseFp)video_updateWindowSurfaceDirty, "video_updateWindowSurfaceDirty",  "Checks SDL_UpdateWindowSurface and SDL_UpdateWindowSurfaceRects with dirty rectangle tracking", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference videoTest25 =
+        { (SDLTest_TestCaseFp)video_updateWindowSurfaceDirtyPresented, "video_updateWindowSurfaceDirtyPresented",  "Checks that dirty tracking keeps the changes a window surface update didn't present", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference videoTest26 =
+        { (SDLTest_TestCaseFp)video_updateWindowSurfaceShmBuffers, "video_updateWindowSurfaceShmBuffers",  "Checks repeated SDL_UpdateWindowSurface calls with double and triple MIT-SHM buffers on X11", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference videoTest27 =
+        { (SDLTest_TestCaseFp)video_dummySaveFrames, "video_dummySaveFrames",  "Checks the dummy driver display modes, saved frames and statistics hints", TEST_ENABLED };
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] =  {
     &videoTest1, &videoTest2, &videoTest3, &videoTest4, &videoTest5, &videoTest6,
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
     &videoTest18, &videoTest19, &videoTest20, &videoTest21, &videoTest22,
-    &videoTest23, NULL
+    &videoTest23, &videoTest24, &videoTest25, &videoTest26, &videoTest27, NULL
 };
 
 /* Video test suite (global) */
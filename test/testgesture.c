@@ -13,6 +13,9 @@
  *  Spacebar to begin recording a gesture on all touches.
  *  s to save all touches into "./gestureSave"
  *  l to load all touches from "./gestureSave"
+ *
+ *  Run with --benchmark to time recognizing gestures against
+ *  BENCHMARK_TEMPLATES templates on the first touch device.
  */
 
 #include "SDL.h"
@@ -33,6 +36,9 @@
 
 #define VERBOSE 0
 
+#define BENCHMARK_TEMPLATES 1000
+#define BENCHMARK_POINTS 60
+
 static SDL_Event events[EVENT_BUF_SIZE];
 static int eventWrite;
 
@@ -274,6 +280,89 @@ void loop()
 #endif
 }
 
+/* Draw one finger stroke through the points, turned by 'ang' around the middle */
+static void BenchmarkStroke(SDL_TouchID touchId, const Point *points, float ang)
+{
+  SDL_Event event;
+  float c = SDL_cosf(ang), s = SDL_sinf(ang);
+  float lastx = 0, lasty = 0;
+  int i;
+
+  SDL_zero(event);
+  event.tfinger.touchId = touchId;
+  for (i = 0; i < BENCHMARK_POINTS; i++) {
+    float x = .5f + (points[i].x - .5f)*c - (points[i].y - .5f)*s;
+    float y = .5f + (points[i].x - .5f)*s + (points[i].y - .5f)*c;
+    event.type = (i == 0) ? SDL_FINGERDOWN : SDL_FINGERMOTION;
+    event.tfinger.x = x;
+    event.tfinger.y = y;
+    event.tfinger.dx = (i == 0) ? 0 : x - lastx;
+    event.tfinger.dy = (i == 0) ? 0 : y - lasty;
+    SDL_PushEvent(&event);
+    lastx = x;
+    lasty = y;
+  }
+  event.type = SDL_FINGERUP;
+  event.tfinger.dx = 0;
+  event.tfinger.dy = 0;
+  SDL_PushEvent(&event);
+}
+
+static int Benchmark(void)
+{
+  static Point strokes[BENCHMARK_TEMPLATES][BENCHMARK_POINTS];
+  static SDL_GestureID gestureIds[BENCHMARK_TEMPLATES];
+  SDL_TouchID touchId;
+  SDL_Event event;
+  Uint64 start, elapsed = 0;
+  int i, j, recognized = 0, correct = 0;
+
+  if (SDL_GetNumTouchDevices() < 1) {
+    SDL_Log("No touch devices to run the benchmark on");
+    return 1;
+  }
+  touchId = SDL_GetTouchDevice(0);
+
+  /* Record a template for each of a set of curves */
+  srand(0);
+  for (i = 0; i < BENCHMARK_TEMPLATES; i++) {
+    float a = 6.0f*rand()/RAND_MAX, b = 6.0f*rand()/RAND_MAX;
+    float fx = 3.0f + 9.0f*rand()/RAND_MAX, fy = 3.0f + 9.0f*rand()/RAND_MAX;
+    for (j = 0; j < BENCHMARK_POINTS; j++) {
+      float t = (float)j/(BENCHMARK_POINTS - 1);
+      strokes[i][j].x = .5f + .3f*(.5f + t)*SDL_sinf(fx*t + a);
+      strokes[i][j].y = .5f + .3f*SDL_cosf(fy*t + b);
+    }
+    SDL_RecordGesture(touchId);
+    BenchmarkStroke(touchId, strokes[i], 0);
+    while (SDL_PollEvent(&event)) {
+      if (event.type == SDL_DOLLARRECORD) {
+        gestureIds[i] = event.dgesture.gestureId;
+      }
+    }
+  }
+
+  /* Draw them again a little turned, the finger up runs the recognizer */
+  for (i = 0; i < BENCHMARK_TEMPLATES; i++) {
+    start = SDL_GetPerformanceCounter();
+    BenchmarkStroke(touchId, strokes[i], (i % 2) ? .2f : -.2f);
+    elapsed += SDL_GetPerformanceCounter() - start;
+    while (SDL_PollEvent(&event)) {
+      if (event.type == SDL_DOLLARGESTURE) {
+        ++recognized;
+        if (event.dgesture.gestureId == gestureIds[i]) {
+          ++correct;
+        }
+      }
+    }
+  }
+
+  SDL_Log("Recognized %d strokes against %d templates, %d correctly, in %.3f ms per stroke",
+          recognized, BENCHMARK_TEMPLATES, correct,
+          (double)elapsed*1000.0/SDL_GetPerformanceFrequency()/BENCHMARK_TEMPLATES);
+  return 0;
+}
+
 int main(int argc, char* argv[])
 {
   window = NULL;
@@ -289,6 +378,12 @@ int main(int argc, char* argv[])
 
   if (SDL_Init(SDL_INIT_VIDEO) < 0 ) return 1;
 
+  if (argc > 1 && SDL_strcmp(argv[1], "--benchmark") == 0) {
+      int result = Benchmark();
+      SDL_Quit();
+      return result;
+  }
+
   if (!(window = initWindow(window, WIDTH, HEIGHT)) ||
       !(screen = SDL_GetWindowSurface(window)))
   {